@@ -56,14 +56,19 @@
 #endif
 
 #include "localstreamer/PixelStreamerLauncher.h"
-#include "StateSerializationHelper.h"
+#include "LocalStreamServer.h"
 #include "PixelStreamWindowManager.h"
+#include "SessionPreloader.h"
+#include "StateLoader.h"
 
 #include "SessionCommandHandler.h"
 #include "FileCommandHandler.h"
 #include "WebbrowserCommandHandler.h"
 
 #include "ws/WebServiceServer.h"
+#include "ws/DisplayGroupChangesHandler.h"
+#include "ws/DisplayGroupSnapshotHandler.h"
+#include "ws/DisplayGroupStateTracker.h"
 #include "ws/TextInputDispatcher.h"
 #include "ws/TextInputHandler.h"
 #include "ws/DisplayGroupAdapter.h"
@@ -74,6 +79,8 @@
 
 #include <stdexcept>
 
+#define WEBSERVICE_MAX_LONG_POLLS 2
+
 MasterApplication::MasterApplication(int& argc_, char** argv_, MPIChannelPtr worldChannel)
     : QApplication(argc_, argv_)
     , masterToWallChannel_(new MasterToWallChannel(worldChannel))
@@ -92,11 +99,12 @@ MasterApplication::MasterApplication(int& argc_, char** argv_, MPIChannelPtr wor
     init();
 
     if(!options.getSessionFilename().isEmpty())
-        StateSerializationHelper(displayGroup_).load(options.getSessionFilename());
+        StateLoader::start(displayGroup_, options.getSessionFilename());
 }
 
 MasterApplication::~MasterApplication()
 {
+    localStreamServer_.reset();
     networkListener_.reset();
 
     masterToWallChannel_->sendQuit();
@@ -107,6 +115,8 @@ MasterApplication::~MasterApplication()
     mpiReceiveThread_.quit();
     mpiReceiveThread_.wait();
 
+    if (displayGroupStateTracker_)
+        displayGroupStateTracker_->releaseWaiters();
     webServiceServer_->stop();
     webServiceServer_->wait();
 }
@@ -117,6 +127,9 @@ void MasterApplication::init()
 
     masterWindow_.reset(new MasterWindow(displayGroup_, *config_));
     pixelStreamWindowManager_.reset(new PixelStreamWindowManager(*displayGroup_));
+    sessionPreloader_.reset(new SessionPreloader(displayGroup_));
+    sessionPreloader_->setActivationTimeout(
+                config_->getSessionActivationTimeout());
 
     initPixelStreamLauncher();
     startNetworkListener();
@@ -167,14 +180,28 @@ void MasterApplication::startNetworkListener()
             &dispatcher, SLOT(deleteStream(QString)));
 
     deflect::CommandHandler& handler = networkListener_->getCommandHandler();
-    handler.registerCommandHandler(new FileCommandHandler(displayGroup_, *pixelStreamWindowManager_));
-    handler.registerCommandHandler(new SessionCommandHandler(*displayGroup_));
+    handler.registerCommandHandler(new FileCommandHandler(displayGroup_,
+                                                          *pixelStreamWindowManager_,
+                                                          *sessionPreloader_));
+    handler.registerCommandHandler(new SessionCommandHandler(*displayGroup_,
+                                                             *sessionPreloader_));
 
     const QString& url = config_->getWebBrowserDefaultURL();
     handler.registerCommandHandler(new WebbrowserCommandHandler(
                                        *pixelStreamWindowManager_,
                                        *pixelStreamerLauncher_,
                                        url));
+
+    // Local streamers fall back to the NetworkListener if this fails
+    try
+    {
+        localStreamServer_.reset(new LocalStreamServer(dispatcher, handler));
+        pixelStreamerLauncher_->setLocalServerName(localStreamServer_->getName());
+    }
+    catch (const std::runtime_error& e)
+    {
+        put_flog(LOG_WARN, "Could not start LocalStreamServer. '%s'", e.what());
+    }
 }
 
 void MasterApplication::startWebservice(const int webServicePort)
@@ -190,8 +217,17 @@ void MasterApplication::startWebservice(const int webServicePort)
 
     textInputHandler->moveToThread(webServiceServer_.get());
     textInputDispatcher_.reset(new TextInputDispatcher(displayGroup_));
-    textInputDispatcher_->connect(textInputHandler, SIGNAL(receivedKeyInput(char)),
-                         SLOT(sendKeyEventToActiveWindow(char)));
+    textInputDispatcher_->connect(textInputHandler, SIGNAL(receivedTextInput(QString)),
+                         SLOT(sendTextToActiveWindow(QString)));
+
+    // Leave some of the server threads available for the other requests
+    displayGroupStateTracker_.reset(new DisplayGroupStateTracker(displayGroup_, WEBSERVICE_MAX_LONG_POLLS));
+    connect(displayGroup_.get(), SIGNAL(modified(DisplayGroupPtr)),
+            displayGroupStateTracker_.get(), SLOT(update(DisplayGroupPtr)));
+    webServiceServer_->addHandler("/dcapi/displaygroup",
+                                  dcWebservice::HandlerPtr(new DisplayGroupSnapshotHandler(displayGroupStateTracker_)));
+    webServiceServer_->addHandler("/dcapi/displaygroup/changes",
+                                  dcWebservice::HandlerPtr(new DisplayGroupChangesHandler(displayGroupStateTracker_)));
 
     webServiceServer_->start();
 }
@@ -229,6 +265,10 @@ void MasterApplication::initMPIConnection()
              masterToWallChannel_.get(), SLOT( sendAsync( DisplayGroupPtr )),
              Qt::DirectConnection );
 
+    connect( sessionPreloader_.get(), SIGNAL( preload( SessionPreloadPtr )),
+             masterToWallChannel_.get(), SLOT( sendAsync( SessionPreloadPtr )),
+             Qt::DirectConnection );
+
     connect( masterWindow_->getOptions().get(), SIGNAL( updated( OptionsPtr )),
              masterToWallChannel_.get(), SLOT( sendAsync( OptionsPtr )),
              Qt::DirectConnection );
@@ -259,11 +299,31 @@ void MasterApplication::initMPIConnection()
              networkListener_.get(),
              SLOT( onEventRegistrationReply( QString, bool )));
 
+    if( localStreamServer_ )
+    {
+        connect( localStreamServer_.get(),
+                 SIGNAL( registerToEvents( QString, bool, deflect::EventReceiver*)),
+                 pixelStreamWindowManager_.get(),
+                 SLOT( registerEventReceiver( QString, bool,
+                                              deflect::EventReceiver* )));
+        connect( pixelStreamWindowManager_.get(),
+                 SIGNAL( pixelStreamWindowClosed( QString )),
+                 localStreamServer_.get(), SLOT( onPixelStreamerClosed( QString )));
+        connect( pixelStreamWindowManager_.get(),
+                 SIGNAL( eventRegistrationReply( QString, bool )),
+                 localStreamServer_.get(),
+                 SLOT( onEventRegistrationReply( QString, bool )));
+    }
+
     connect( masterFromWallChannel_.get(),
              SIGNAL( receivedRequestFrame( const QString )),
              &networkListener_->getPixelStreamDispatcher(),
              SLOT( requestFrame( const QString )));
 
+    connect( masterFromWallChannel_.get(),
+             SIGNAL( receivedPreloadFinished( unsigned int )),
+             sessionPreloader_.get(), SLOT( preloadFinished( unsigned int )));
+
     connect( &mpiReceiveThread_, SIGNAL( started( )),
              masterFromWallChannel_.get(), SLOT( processMessages( )));
 
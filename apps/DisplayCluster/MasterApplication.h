@@ -47,11 +47,13 @@
 #include <QThread>
 #include <boost/scoped_ptr.hpp>
 
+class LocalStreamServer;
 class MasterToWallChannel;
 class MasterFromWallChannel;
 class MasterWindow;
 class PixelStreamerLauncher;
 class PixelStreamWindowManager;
+class SessionPreloader;
 class WebServiceServer;
 class TextInputDispatcher;
 class MasterConfiguration;
@@ -83,10 +85,13 @@ private:
     boost::scoped_ptr<MasterWindow> masterWindow_;
     boost::scoped_ptr<MasterConfiguration> config_;
     boost::scoped_ptr<deflect::NetworkListener> networkListener_;
+    boost::scoped_ptr<LocalStreamServer> localStreamServer_;
     boost::scoped_ptr<PixelStreamerLauncher> pixelStreamerLauncher_;
     boost::scoped_ptr<PixelStreamWindowManager> pixelStreamWindowManager_;
+    boost::scoped_ptr<SessionPreloader> sessionPreloader_;
     boost::scoped_ptr<WebServiceServer> webServiceServer_;
     boost::scoped_ptr<TextInputDispatcher> textInputDispatcher_;
+    DisplayGroupStateTrackerPtr displayGroupStateTracker_;
 #if ENABLE_TUIO_TOUCH_LISTENER
     boost::scoped_ptr<MultiTouchListener> touchListener_;
 #endif
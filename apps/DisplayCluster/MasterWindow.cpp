@@ -47,6 +47,7 @@
 
 #include "ContentLoader.h"
 #include "ContentFactory.h"
+#include "StateLoader.h"
 #include "StateSerializationHelper.h"
 
 #include "DynamicTexture.h"
@@ -62,7 +63,7 @@
 
 namespace
 {
-const QString STATE_FILES_FILTER( "State files (*.dcx)" );
+const QString STATE_FILES_FILTER( "State files (*.dcx *.dcxb)" );
 const QSize DEFAULT_WINDOW_SIZE( 800, 600 );
 }
 
@@ -386,8 +387,8 @@ void MasterWindow::saveState()
 
     sessionFolder_ = QFileInfo( filename ).absoluteDir().path();
 
-    // make sure filename has .dcx extension
-    if( !filename.endsWith( ".dcx" ))
+    // make sure filename has .dcx or .dcxb extension
+    if( !filename.endsWith( ".dcx" ) && !filename.endsWith( ".dcxb" ))
     {
         put_flog( LOG_DEBUG, "appended .dcx filename extension" );
         filename.append( ".dcx" );
@@ -415,11 +416,14 @@ void MasterWindow::loadState()
 
 void MasterWindow::loadState( const QString& filename )
 {
-    if( !StateSerializationHelper( displayGroup_ ).load( filename ))
-    {
-        QMessageBox::warning( this, "Error", "Could not load state file.",
-                              QMessageBox::Ok, QMessageBox::Ok );
-    }
+    StateLoader* loader = StateLoader::start( displayGroup_, filename );
+    connect( loader, SIGNAL( failed( QString )), this, SLOT( stateLoadFailed( )));
+}
+
+void MasterWindow::stateLoadFailed()
+{
+    QMessageBox::warning( this, "Error", "Could not load state file.",
+                          QMessageBox::Ok, QMessageBox::Ok );
 }
 
 void MasterWindow::computeImagePyramid()
@@ -503,7 +507,7 @@ QString MasterWindow::extractStateFile(const QMimeData* mimeData)
     {
         QUrl url = urlList[0];
         QString extension = QFileInfo(url.toLocalFile().toLower()).suffix();
-        if (extension == "dcx")
+        if (extension == "dcx" || extension == "dcxb")
             return url.toLocalFile();
     }
     return QString();
@@ -100,6 +100,8 @@ private slots:
 
     void openAboutWidget();
 
+    void stateLoadFailed();
+
 private:
     void setupMasterWindowUI();
 
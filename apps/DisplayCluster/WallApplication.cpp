@@ -149,6 +149,16 @@ void WallApplication::initMPIConnection(MPIChannelPtr worldChannel)
     connect(fromMasterChannel_.get(), SIGNAL(received(MarkersPtr)),
             renderController_.get(), SLOT(updateMarkers(MarkersPtr)));
 
+    connect(fromMasterChannel_.get(), SIGNAL(received(SessionPreloadPtr)),
+            renderController_.get(), SLOT(updatePreload(SessionPreloadPtr)));
+
+    // only one process needs to report that the walls are ready
+    if(wallChannel_->getRank() == 0)
+    {
+        connect(factories_.get(), SIGNAL(preloadFinished(unsigned int)),
+                toMasterChannel_.get(), SLOT(sendPreloadFinished(unsigned int)));
+    }
+
     connect(fromMasterChannel_.get(), SIGNAL(received(deflect::PixelStreamFramePtr)),
             factories_.get(), SLOT(updatePixelStream(deflect::PixelStreamFramePtr)));
 
@@ -39,99 +39,118 @@
 
 #include "Application.h"
 
-#include "localstreamer/PixelStreamer.h"
-#include "localstreamer/PixelStreamerFactory.h"
+#include "StreamSession.h"
 
 #include "localstreamer/CommandLineOptions.h"
-#include <deflect/Socket.h>
+#include "localstreamer/LocalStreamChannel.h"
 
-#include <QTimer>
+#include <QDataStream>
+#include <QLocalSocket>
+#include <QStringList>
+#include <QWebFrame>
+#include <QWebPage>
 #include <iostream>
 
-#define DC_STREAM_HOST_ADDRESS "localhost"
-//#define COMPRESS_IMAGES
+#define HOST_CONNECTION_TIMEOUT_MS 1000
 
 Application::Application(int &argc_, char **argv_)
     : QApplication(argc_, argv_)
-    , pixelStreamer_(0)
-    , dcStream_(0)
+    , hostChannel_(0)
+    , warmupPage_(0)
 {
 }
 
 Application::~Application()
 {
-    delete dcStream_;
-    delete pixelStreamer_;
 }
 
 bool Application::initialize(const CommandLineOptions& options)
 {
-    // Create the streamer
-    pixelStreamer_ = PixelStreamerFactory::create(options);
-    if (!pixelStreamer_)
-        return false;
-    connect(pixelStreamer_, SIGNAL(imageUpdated(QImage)), this, SLOT(sendImage(QImage)));
-    connect(pixelStreamer_, SIGNAL(sendCommand(QString)), this, SLOT(sendCommand(QString)));
+    if (!options.getHostServer().isEmpty())
+        return startHost(options.getHostServer());
 
-    // Connect to DisplayCluster
-    dcStream_ = new deflect::Stream( options.getName().toStdString(),
-                                     DC_STREAM_HOST_ADDRESS );
-    if( !dcStream_->isConnected( ))
+    if (!startSession(options))
     {
         std::cerr << "Could not connect to host!" << std::endl;
-        delete dcStream_;
-        dcStream_ = 0;
         return false;
     }
-
-    // Make sure to quit the application if the connection is closed.
-    dcStream_->disconnected.connect( QApplication::quit );
-
-    // Use a timer to process Event received from the deflect::Stream
-    QTimer* timer = new QTimer(this);
-    connect(timer, SIGNAL(timeout()), SLOT(processPendingEvents()));
-    timer->start(1);
-
     return true;
 }
 
-void Application::sendImage(QImage image)
+bool Application::startSession(const CommandLineOptions& options)
 {
-#ifdef COMPRESS_IMAGES
-    // QImage Format_RGB32 (0xffRRGGBB) corresponds in fact to GL_BGRA == deflect::BGRA
-    deflect::ImageWrapper deflectImage((const void*)image.bits(), image.width(), image.height(), deflect::BGRA);
-    deflectImage.compressionPolicy = deflect::COMPRESSION_ON;
-#else
-    // This conversion is suboptimal, but the only solution until we send the PixelFormat with the PixelStreamSegment
-    image = image.rgbSwapped();
-    deflect::ImageWrapper deflectImage((const void*)image.bits(), image.width(), image.height(), deflect::RGBA);
-    deflectImage.compressionPolicy = deflect::COMPRESSION_OFF;
-#endif
-    bool success = dcStream_->send(deflectImage) && dcStream_->finishFrame();
-
-    if(!success)
+    StreamSession* session = new StreamSession(this);
+    if (!session->initialize(options))
     {
-        QApplication::quit();
-        return;
+        delete session;
+        return false;
     }
+    connect(session, SIGNAL(closed()), this, SLOT(onSessionClosed()));
+    return true;
 }
 
-void Application::processPendingEvents()
+bool Application::startHost(const QString& serverName)
 {
-    if (!dcStream_->isRegisteredForEvents())
+    QLocalSocket* socket = new QLocalSocket;
+    socket->connectToServer(serverName);
+    if (!socket->waitForConnected(HOST_CONNECTION_TIMEOUT_MS))
     {
-        dcStream_->registerForEvents();
-    }
-    else
-    {
-        while(dcStream_->hasEvent())
-        {
-            pixelStreamer_->processEvent(dcStream_->getEvent());
-        }
+        std::cerr << "Could not connect to launcher!" << std::endl;
+        delete socket;
+        return false;
     }
+
+    hostChannel_ = new LocalStreamChannel(socket, this);
+    connect(hostChannel_, SIGNAL(messageReceived(int, QByteArray)),
+            this, SLOT(processHostMessage(int, QByteArray)));
+    // The launcher closes the connection when the master application exits
+    connect(hostChannel_, SIGNAL(disconnected()), this, SLOT(quit()));
+
+    // Initialize WebKit now instead of when the first browser is requested
+    warmupPage_ = new QWebPage(this);
+    warmupPage_->mainFrame()->setHtml(QString());
+
+    return true;
 }
 
-void Application::sendCommand(QString command)
+void Application::processHostMessage(int type, QByteArray payload)
 {
-    dcStream_->sendCommand(command.toStdString());
+    if (type != MESSAGE_START_STREAMER)
+        return;
+
+    QStringList arguments;
+    QDataStream stream(payload);
+    stream >> arguments;
+
+    const CommandLineOptions options(arguments);
+    if (startSession(options))
+        return;
+
+    std::cerr << "Could not start streamer: "
+              << arguments.join(" ").toStdString() << std::endl;
+
+    // Let the launcher start it in a process of its own
+    QByteArray reply;
+    QDataStream replyStream(&reply, QIODevice::WriteOnly);
+    replyStream << options.getName();
+    hostChannel_->send(MESSAGE_STREAMER_FAILED, reply);
+}
+
+void Application::onSessionClosed()
+{
+    StreamSession* session = qobject_cast<StreamSession*>(sender());
+
+    if (!hostChannel_)
+    {
+        quit();
+        return;
+    }
+
+    // Let the launcher know that it can assign a new browser to this host
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream << session->getName();
+    hostChannel_->send(MESSAGE_STREAMER_CLOSED, payload);
+
+    session->deleteLater();
 }
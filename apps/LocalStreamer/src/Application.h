@@ -41,15 +41,20 @@
 #define APPLICATION_H
 
 #include <QApplication>
-#include <QImage>
+#include <QByteArray>
 
-#include <deflect/Stream.h>
-
-class PixelStreamer;
 class CommandLineOptions;
+class LocalStreamChannel;
+class QWebPage;
 
 /**
- * Generic application for using PixelStreamers with the deflect::Stream library.
+ * Generic application for using PixelStreamers with DisplayCluster.
+ *
+ * The application either runs a single StreamSession, or acts as a host for
+ * the web browsers opened by a PixelStreamerLauncher. In that case, a new
+ * StreamSession is started in this process for each request of the launcher,
+ * which avoids the startup time and the memory overhead of a new process for
+ * each web browser.
  */
 class Application : public QApplication
 {
@@ -76,13 +81,15 @@ public:
     bool initialize(const CommandLineOptions &options);
 
 private slots:
-    void sendImage(QImage image);
-    void processPendingEvents();
-    void sendCommand(QString command);
+    void processHostMessage(int type, QByteArray payload);
+    void onSessionClosed();
 
 private:
-    PixelStreamer* pixelStreamer_;
-    deflect::Stream* dcStream_;
+    LocalStreamChannel* hostChannel_;
+    QWebPage* warmupPage_;
+
+    bool startSession(const CommandLineOptions& options);
+    bool startHost(const QString& serverName);
 };
 
 #endif // APPLICATION_H
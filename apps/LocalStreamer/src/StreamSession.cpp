@@ -0,0 +1,260 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "StreamSession.h"
+
+#include "localstreamer/PixelStreamer.h"
+#include "localstreamer/PixelStreamerFactory.h"
+
+#include "localstreamer/CommandLineOptions.h"
+#include "localstreamer/LocalStream.h"
+#include <deflect/Socket.h>
+
+#include <QTimer>
+#include <QDateTime>
+
+#include <boost/bind.hpp>
+
+#define DC_STREAM_HOST_ADDRESS "localhost"
+#define SEGMENT_SIZE 512
+#define EVENT_REGISTRATION_RETRY_MS 100
+
+StreamSession::StreamSession(QObject* parent_)
+    : QObject(parent_)
+    , pixelStreamer_(0)
+    , dcStream_(0)
+    , localStream_(0)
+    , eventNotifier_(0)
+{
+}
+
+StreamSession::~StreamSession()
+{
+    delete eventNotifier_;
+    delete localStream_;
+    delete dcStream_;
+    delete pixelStreamer_;
+}
+
+bool StreamSession::initialize(const CommandLineOptions& options)
+{
+    // Create the streamer
+    pixelStreamer_ = PixelStreamerFactory::create(options);
+    if (!pixelStreamer_)
+        return false;
+    name_ = options.getName();
+    compressionPolicy_ = SegmentCompressionPolicy(options.getCompressionMode(),
+                                                  options.getCompressionQuality());
+    connect(pixelStreamer_, SIGNAL(imageUpdated(QImage)), this, SLOT(sendImage(QImage)));
+    connect(pixelStreamer_, SIGNAL(imageRegionUpdated(QImage, QRegion)),
+            this, SLOT(sendImageRegion(QImage, QRegion)));
+    connect(pixelStreamer_, SIGNAL(sendCommand(QString)), this, SLOT(sendCommand(QString)));
+
+    if (!connectToHost(name_, options.getLocalServer()))
+        return false;
+
+    registerForEvents();
+
+    return true;
+}
+
+const QString& StreamSession::getName() const
+{
+    return name_;
+}
+
+bool StreamSession::connectToHost(const QString& name,
+                                  const QString& localServer)
+{
+    // Prefer the shared memory transport of the master application
+    if (!localServer.isEmpty())
+        localStream_ = new LocalStream(name, localServer);
+    if (localStream_ && localStream_->isConnected())
+    {
+        // Make sure to close the session if the connection is closed.
+        connect(localStream_, SIGNAL(disconnected()), this, SIGNAL(closed()),
+                Qt::QueuedConnection);
+        // Events may arrive while blocked in sendFrame(), process them later
+        connect(localStream_, SIGNAL(eventReceived()), SLOT(processPendingEvents()),
+                Qt::QueuedConnection);
+        return true;
+    }
+    delete localStream_;
+    localStream_ = 0;
+
+    dcStream_ = new deflect::Stream( name.toStdString(),
+                                     DC_STREAM_HOST_ADDRESS );
+    if( !dcStream_->isConnected( ))
+    {
+        delete dcStream_;
+        dcStream_ = 0;
+        return false;
+    }
+
+    // Make sure to close the session if the connection is closed.
+    dcStream_->disconnected.connect( boost::bind( &StreamSession::notifyDisconnected, this ));
+    return true;
+}
+
+void StreamSession::notifyDisconnected()
+{
+    // The deflect::Stream may notify from another thread
+    QMetaObject::invokeMethod(this, "closed", Qt::QueuedConnection);
+}
+
+void StreamSession::sendImage(QImage image)
+{
+    sendImageRegion(image, QRegion(image.rect()));
+}
+
+void StreamSession::sendImageRegion(QImage image, QRegion region)
+{
+    const QVector<QRect> segments = getSegments(image.rect(), region);
+
+    bool success = true;
+    if (localStream_)
+        success = localStream_->sendFrame(image, segments, compressionPolicy_);
+    else
+    {
+        for (int i = 0; i < segments.size() && success; ++i)
+            success = sendSegment(image, segments[i]);
+        success = success && dcStream_->finishFrame();
+    }
+
+    if(!success)
+    {
+        QMetaObject::invokeMethod(this, "closed", Qt::QueuedConnection);
+        return;
+    }
+
+    drainEventsLater();
+}
+
+QVector<QRect> StreamSession::getSegments(const QRect& frame, const QRegion& region) const
+{
+    // The image is always cut along the same grid so that the segments of a
+    // partial frame replace those of the previous frame on the wall. The
+    // bottom-right segment is always sent to preserve the frame dimensions.
+    QVector<QRect> segments;
+    for (int y = 0; y < frame.height(); y += SEGMENT_SIZE)
+    {
+        for (int x = 0; x < frame.width(); x += SEGMENT_SIZE)
+        {
+            const QRect segment = QRect(x, y, SEGMENT_SIZE, SEGMENT_SIZE) & frame;
+            if (region.intersects(segment) || segment.bottomRight() == frame.bottomRight())
+                segments.append(segment);
+        }
+    }
+    return segments;
+}
+
+bool StreamSession::sendSegment(const QImage& image, const QRect& rect)
+{
+    const QImage segment = image.copy(rect);
+    const qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    if (compressionPolicy_.shouldCompress(segment, rect.topLeft(), timestamp))
+    {
+        // QImage Format_RGB32 (0xffRRGGBB) corresponds in fact to GL_BGRA == deflect::BGRA
+        deflect::ImageWrapper deflectImage((const void*)segment.bits(), segment.width(), segment.height(),
+                                           deflect::BGRA, rect.x(), rect.y());
+        deflectImage.compressionPolicy = deflect::COMPRESSION_ON;
+        deflectImage.compressionQuality = compressionPolicy_.getQuality();
+        return dcStream_->send(deflectImage);
+    }
+
+    // This conversion is suboptimal, but the only solution until we send the PixelFormat with the PixelStreamSegment
+    const QImage rgbaSegment = segment.rgbSwapped();
+    deflect::ImageWrapper deflectImage((const void*)rgbaSegment.bits(), rgbaSegment.width(), rgbaSegment.height(),
+                                       deflect::RGBA, rect.x(), rect.y());
+    deflectImage.compressionPolicy = deflect::COMPRESSION_OFF;
+    return dcStream_->send(deflectImage);
+}
+
+void StreamSession::registerForEvents()
+{
+    const bool success = localStream_ ? localStream_->registerForEvents()
+                                      : dcStream_->registerForEvents();
+    if (!success)
+    {
+        // The window of the stream may not be open yet
+        QTimer::singleShot(EVENT_REGISTRATION_RETRY_MS, this, SLOT(registerForEvents()));
+        return;
+    }
+
+    // The LocalStream signals incoming events by itself
+    if (localStream_)
+        return;
+
+    // Wait for events on the stream socket instead of polling it
+    eventNotifier_ = new QSocketNotifier(dcStream_->getDescriptor(), QSocketNotifier::Read);
+    connect(eventNotifier_, SIGNAL(activated(int)), SLOT(processPendingEvents()));
+}
+
+void StreamSession::processPendingEvents()
+{
+    if (localStream_)
+    {
+        while(localStream_->hasEvent())
+            pixelStreamer_->processEvent(localStream_->getEvent());
+        return;
+    }
+
+    while(dcStream_->hasEvent())
+    {
+        pixelStreamer_->processEvent(dcStream_->getEvent());
+    }
+}
+
+void StreamSession::sendCommand(QString command)
+{
+    if (localStream_)
+        localStream_->sendCommand(command);
+    else
+        dcStream_->sendCommand(command.toStdString());
+
+    drainEventsLater();
+}
+
+void StreamSession::drainEventsLater()
+{
+    // Events may have been buffered by the stream while sending, without
+    // waking up the notifier. Frames and commands are often sent while
+    // processing an event, so drain them from the event loop.
+    QMetaObject::invokeMethod(this, "processPendingEvents", Qt::QueuedConnection);
+}
@@ -0,0 +1,116 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef STREAMSESSION_H
+#define STREAMSESSION_H
+
+#include <QObject>
+#include <QImage>
+#include <QSocketNotifier>
+#include <QRegion>
+#include <QVector>
+
+#include <deflect/Stream.h>
+
+#include "localstreamer/SegmentCompressionPolicy.h"
+
+class PixelStreamer;
+class CommandLineOptions;
+class LocalStream;
+
+/**
+ * Stream the images of a PixelStreamer to DisplayCluster and forward it the
+ * events of its window.
+ *
+ * The frames are sent through a LocalStream in shared memory when the master
+ * application runs on the same host, otherwise with the deflect::Stream library.
+ * The same SegmentCompressionPolicy chooses the JPEG segments with both.
+ */
+class StreamSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Create a StreamSession.
+     *
+     * @param parent The parent QObject
+     */
+    StreamSession(QObject* parent = 0);
+
+    /** Destruct a StreamSession. */
+    ~StreamSession();
+
+    /**
+     * Create the PixelStreamer and connect to DisplayCluster.
+     *
+     * @param options The options of the PixelStreamer.
+     * @return true on success, false on failure.
+     */
+    bool initialize(const CommandLineOptions& options);
+
+    /** Get the name (uri) of the stream. */
+    const QString& getName() const;
+
+signals:
+    /** Emitted when the connection to DisplayCluster is closed. */
+    void closed();
+
+private slots:
+    void sendImage(QImage image);
+    void sendImageRegion(QImage image, QRegion region);
+    void registerForEvents();
+    void processPendingEvents();
+    void sendCommand(QString command);
+
+private:
+    QString name_;
+    PixelStreamer* pixelStreamer_;
+    deflect::Stream* dcStream_;
+    LocalStream* localStream_;
+    QSocketNotifier* eventNotifier_;
+    SegmentCompressionPolicy compressionPolicy_;
+
+    bool connectToHost(const QString& name, const QString& localServer);
+    void notifyDisconnected();
+    QVector<QRect> getSegments(const QRect& frame, const QRegion& region) const;
+    bool sendSegment(const QImage& image, const QRect& rect);
+    void drainEventsLater();
+};
+
+#endif // STREAMSESSION_H
@@ -0,0 +1,96 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "StateSerializationHelper.h"
+#include "DisplayGroup.h"
+#include "configuration/MasterConfiguration.h"
+
+#include <QCoreApplication>
+#include <QStringList>
+
+#include <boost/make_shared.hpp>
+#include <iostream>
+#include <stdexcept>
+
+#define INVALID_ARGUMENTS_ERROR_CODE     1
+#define INVALID_CONFIGURATION_ERROR_CODE 2
+#define CONVERSION_FAILED_ERROR_CODE     3
+
+void showSyntax()
+{
+    std::cout << "Convert DisplayCluster state files between the xml (.dcx) "
+                 "and binary (.dcxb) formats." << std::endl;
+    std::cout << "Usage: dcstateconverter <configuration.xml> <input> <output>"
+              << std::endl;
+    std::cout << "The output format is chosen from its extension. The wall "
+                 "configuration is used to convert legacy state files."
+              << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    // QCoreApplication is required by QtXml for loading legacy files
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    if (args.size() != 4)
+    {
+        showSyntax();
+        return INVALID_ARGUMENTS_ERROR_CODE;
+    }
+
+    QSize wallSize;
+    try
+    {
+        wallSize = MasterConfiguration(args[1]).getTotalSize();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return INVALID_CONFIGURATION_ERROR_CODE;
+    }
+
+    DisplayGroupPtr displayGroup = boost::make_shared<DisplayGroup>(wallSize);
+    if (!StateSerializationHelper(displayGroup).convert(args[2], args[3]))
+    {
+        std::cerr << "Could not convert " << args[2].toStdString() << " to "
+                  << args[3].toStdString() << std::endl;
+        return CONVERSION_FAILED_ERROR_CODE;
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "BinaryStateFile.h"
+
+#include "ContentWindow.h"
+#include "Content.h"
+#include "ContentFactory.h"
+#include "log.h"
+
+#include <QFile>
+#include <QDataStream>
+
+#include <boost/foreach.hpp>
+
+namespace
+{
+const quint32 BINARY_STATE_MAGIC = 0x44435842; // "DCXB"
+const quint32 BINARY_STATE_VERSION = 2;
+
+QByteArray writeContentState( const Content& content )
+{
+    QByteArray state;
+    QDataStream out( &state, QIODevice::WriteOnly );
+    out.setVersion( QDataStream::Qt_4_6 );
+    content.writeState( out );
+    return state;
+}
+
+QByteArray writeRecord( const ContentWindow& window )
+{
+    QByteArray record;
+    QDataStream out( &record, QIODevice::WriteOnly );
+    out.setVersion( QDataStream::Qt_4_6 );
+
+    ContentPtr content = window.getContent();
+    out << getContentTypeString( content->getType( ));
+    out << content->getURI();
+    out << content->getDimensions();
+    out << writeContentState( *content );
+    out << window.getCoordinates();
+    out << window.getBackupCoordinates();
+    out << window.getZoomRect();
+    out << (qint32)window.getState();
+    return record;
+}
+
+ContentWindowPtr readRecord( const QByteArray& record )
+{
+    QDataStream in( record );
+    in.setVersion( QDataStream::Qt_4_6 );
+
+    QString type, uri;
+    QSize dimensions;
+    QByteArray contentState;
+    QRectF coordinates, coordinatesBackup, zoomRect;
+    qint32 state = 0;
+    in >> type >> uri >> dimensions >> contentState
+       >> coordinates >> coordinatesBackup >> zoomRect >> state;
+    if( in.status() != QDataStream::Ok )
+        return ContentWindowPtr();
+
+    ContentPtr content = ContentFactory::createContent( getContentType( type ),
+                                                        uri );
+    if( !content )
+        return ContentWindowPtr();
+
+    content->setDimensions( dimensions );
+    QDataStream stateStream( contentState );
+    stateStream.setVersion( QDataStream::Qt_4_6 );
+    content->readState( stateStream );
+
+    ContentWindowPtr window( new ContentWindow( content ));
+    if( coordinatesBackup.isValid( ))
+    {
+        window->setCoordinates( coordinatesBackup );
+        window->backupCoordinates();
+    }
+    window->setCoordinates( coordinates );
+    window->setZoomRect( zoomRect );
+    window->setState( (ContentWindow::WindowState)state );
+    return window;
+}
+}
+
+QString BinaryStateFile::getFileExtension()
+{
+    return QString( "dcxb" );
+}
+
+bool BinaryStateFile::canRead( const QString& filename )
+{
+    QFile file( filename );
+    if( !file.open( QIODevice::ReadOnly ))
+        return false;
+
+    QDataStream in( &file );
+    quint32 magic = 0;
+    in >> magic;
+    return in.status() == QDataStream::Ok && magic == BINARY_STATE_MAGIC;
+}
+
+bool BinaryStateFile::save( const QString& filename,
+                            const ContentWindowPtrs& contentWindows )
+{
+    QFile file( filename );
+    if( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ))
+        return false;
+
+    QDataStream out( &file );
+    out.setVersion( QDataStream::Qt_4_6 );
+    out << BINARY_STATE_MAGIC << BINARY_STATE_VERSION;
+    out << (quint32)contentWindows.size();
+
+    BOOST_FOREACH( ContentWindowPtr window, contentWindows )
+        out << writeRecord( *window );
+
+    return out.status() == QDataStream::Ok;
+}
+
+bool BinaryStateFile::load( const QString& filename,
+                            const WindowHandler& handler )
+{
+    QFile file( filename );
+    if( !file.open( QIODevice::ReadOnly ))
+        return false;
+
+    QDataStream in( &file );
+    in.setVersion( QDataStream::Qt_4_6 );
+
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version >> count;
+    if( in.status() != QDataStream::Ok || magic != BINARY_STATE_MAGIC )
+    {
+        put_flog( LOG_ERROR, "Not a binary state file: %s",
+                  filename.toLocal8Bit().constData( ));
+        return false;
+    }
+    // Version 1 stored the Contents as non-portable boost binary archives
+    if( version != BINARY_STATE_VERSION )
+    {
+        put_flog( LOG_ERROR, "Unsupported binary state version %u: %s",
+                  version, filename.toLocal8Bit().constData( ));
+        return false;
+    }
+
+    for( quint32 i = 0; i < count; ++i )
+    {
+        QByteArray record;
+        in >> record;
+        if( in.status() != QDataStream::Ok )
+        {
+            put_flog( LOG_ERROR, "Truncated binary state file: %s",
+                      filename.toLocal8Bit().constData( ));
+            return false;
+        }
+
+        ContentWindowPtr window = readRecord( record );
+        if( window )
+            handler( window );
+        else
+            put_flog( LOG_WARN, "Skipping invalid window %u of %s", i,
+                      filename.toLocal8Bit().constData( ));
+    }
+    return true;
+}
@@ -0,0 +1,92 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef BINARYSTATEFILE_H
+#define BINARYSTATEFILE_H
+
+#include "types.h"
+
+#include <QString>
+#include <boost/function.hpp>
+
+/**
+ * Read and write state files in the compact binary format (.dcxb).
+ *
+ * The file starts with a magic number, a format version and the number of
+ * windows. Each window follows as an independent, length-prefixed record, so
+ * that a reader can process windows one at a time while the rest of the file
+ * is still being parsed, and skip the fields of newer format versions it
+ * does not know about.
+ *
+ * All fields are written explicitly with a QDataStream in big-endian order,
+ * which makes the files portable between architectures: the content type
+ * name, uri and dimensions, the type-specific state of the Content (see
+ * Content::writeState()) and the window coordinates and state.
+ */
+class BinaryStateFile
+{
+public:
+    /** Called for each window as soon as it has been read. */
+    typedef boost::function< void( ContentWindowPtr ) > WindowHandler;
+
+    /** @return The file extension of binary state files, "dcxb". */
+    static QString getFileExtension();
+
+    /** @return true if the file exists and starts with the binary magic. */
+    static bool canRead( const QString& filename );
+
+    /**
+     * Write the windows to a binary state file.
+     * @return false if the file could not be written.
+     */
+    static bool save( const QString& filename,
+                      const ContentWindowPtrs& contentWindows );
+
+    /**
+     * Read the windows of a binary state file one record at a time.
+     *
+     * Records whose Content type is unknown are skipped with a warning.
+     * @param filename The file to read.
+     * @param handler Called for each window in the order of the file.
+     * @return false if the file could not be opened, has an unsupported
+     *         version or is truncated.
+     */
+    static bool load( const QString& filename, const WindowHandler& handler );
+};
+
+#endif // BINARYSTATEFILE_H
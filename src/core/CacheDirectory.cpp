@@ -0,0 +1,93 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "CacheDirectory.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+
+#include <algorithm>
+
+namespace
+{
+QDateTime getLastUse( const QFileInfo& file )
+{
+    return std::max( file.lastRead(), file.lastModified( ));
+}
+
+bool isMoreRecentlyUsed( const QFileInfo& a, const QFileInfo& b )
+{
+    return getLastUse( a ) > getLastUse( b );
+}
+}
+
+QString CacheDirectory::getUserCacheHome()
+{
+    const QByteArray xdgCacheHome = qgetenv( "XDG_CACHE_HOME" );
+    if( xdgCacheHome.isEmpty( ))
+        return QDir::homePath() + "/.cache";
+    return QString::fromLocal8Bit( xdgCacheHome );
+}
+
+int CacheDirectory::prune( const QString& directory, const QString& nameFilter,
+                           const qint64 maxBytes, const int maxAgeDays )
+{
+    QFileInfoList files = QDir( directory ).entryInfoList(
+                              QStringList( nameFilter ), QDir::Files );
+    std::sort( files.begin(), files.end(), isMoreRecentlyUsed );
+
+    const QDateTime oldestAllowed =
+            QDateTime::currentDateTime().addDays( -maxAgeDays );
+
+    int removed = 0;
+    qint64 totalBytes = 0;
+    foreach( const QFileInfo& file, files )
+    {
+        if( totalBytes + file.size() <= maxBytes &&
+            getLastUse( file ) >= oldestAllowed )
+        {
+            totalBytes += file.size();
+            continue;
+        }
+
+        if( QFile::remove( file.absoluteFilePath( )))
+            ++removed;
+    }
+    return removed;
+}
@@ -0,0 +1,71 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef CACHEDIRECTORY_H
+#define CACHEDIRECTORY_H
+
+#include <QString>
+
+/**
+ * Keep an on-disk cache folder within bounds.
+ *
+ * Entries are ranked by their last access (or modification, whichever is the
+ * most recent); those older than the maximum age are removed, then the oldest
+ * ones until the folder fits in the maximum size. Removing a file which
+ * another process is about to read is harmless: caches only ever treat a
+ * missing entry as a miss.
+ */
+class CacheDirectory
+{
+public:
+    /** @return $XDG_CACHE_HOME, or ~/.cache if it is not set. */
+    static QString getUserCacheHome();
+
+    /**
+     * Prune a cache folder.
+     * @param directory The folder to prune, not recursive.
+     * @param nameFilter Only the files matching this wildcard are considered.
+     * @param maxBytes The maximum total size of the matching files.
+     * @param maxAgeDays The maximum age of a file since its last access.
+     * @return The number of files removed.
+     */
+    static int prune( const QString& directory, const QString& nameFilter,
+                      qint64 maxBytes, int maxAgeDays );
+};
+
+#endif // CACHEDIRECTORY_H
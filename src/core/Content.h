@@ -51,6 +51,8 @@
 #include <boost/serialization/nvp.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+class QDataStream;
+
 #include <QObject>
 #include <QSize>
 
@@ -105,6 +107,15 @@ public:
     /** Get the actions from QML. */
     ContentActionsModel* getActions();
 
+    /**
+     * Write the state specific to the content type to a binary state file.
+     * Re-implement this method along with readState() in types with a state.
+     */
+    virtual void writeState( QDataStream& ) const { }
+
+    /** Read the state specific to the content type from a binary state file. */
+    virtual void readState( QDataStream& ) { }
+
 signals:
     /** Emitted by any Content subclass when its state has been modified */
     void modified();
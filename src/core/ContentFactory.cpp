@@ -52,6 +52,7 @@
 #  include "DisplayGroup.h"
 #endif
 #include "PixelStreamContent.h"
+#include "TiledMovieContent.h"
 
 #include <QFile>
 #include <QFileInfo>
@@ -78,6 +79,9 @@ CONTENT_TYPE getContentTypeForFile(const QString& uri)
     if(MovieContent::getSupportedExtensions().contains(extension))
         return CONTENT_TYPE_MOVIE;
 
+    if(TiledMovieContent::getSupportedExtensions().contains(extension))
+        return CONTENT_TYPE_TILED_MOVIE;
+
 #if ENABLE_PDF_SUPPORT
     if(PDFContent::getSupportedExtensions().contains(extension))
         return CONTENT_TYPE_PDF;
@@ -103,16 +107,35 @@ CONTENT_TYPE getContentTypeForFile(const QString& uri)
 }
 
 ContentPtr ContentFactory::getContent(const QString& uri)
+{
+    ContentPtr content = createContent(uri);
+
+    if (content && content->readMetadata())
+        return content;
+
+    return getErrorContent();
+}
+
+ContentPtr ContentFactory::createContent(const QString& uri)
 {
     if( !QFile::exists( uri ))
     {
         put_flog(LOG_ERROR, "could not find file '%s'", uri.toLocal8Bit().constData());
-        return getErrorContent();
+        return ContentPtr();
     }
 
+    ContentPtr content = createContent(getContentTypeForFile(uri), uri);
+    if (!content)
+        put_flog(LOG_ERROR, "Unsupported or invalid file %s",
+                 uri.toLocal8Bit().constData());
+    return content;
+}
+
+ContentPtr ContentFactory::createContent(const CONTENT_TYPE type, const QString& uri)
+{
     ContentPtr content;
 
-    switch(getContentTypeForFile(uri))
+    switch(type)
     {
     case CONTENT_TYPE_SVG:
         content = boost::make_shared<SVGContent>(uri);
@@ -120,6 +143,9 @@ ContentPtr ContentFactory::getContent(const QString& uri)
     case CONTENT_TYPE_MOVIE:
         content = boost::make_shared<MovieContent>(uri);
         break;
+    case CONTENT_TYPE_TILED_MOVIE:
+        content = boost::make_shared<TiledMovieContent>(uri);
+        break;
 #if ENABLE_PDF_SUPPORT
     case CONTENT_TYPE_PDF:
         content = boost::make_shared<PDFContent>(uri);
@@ -132,15 +158,10 @@ ContentPtr ContentFactory::getContent(const QString& uri)
         content = boost::make_shared<TextureContent>(uri);
         break;
     default:
-        put_flog(LOG_ERROR, "Unsupported or invalid file %s",
-                 uri.toLocal8Bit().constData());
         break;
     }
 
-    if (content && content->readMetadata())
-        return content;
-
-    return getErrorContent();
+    return content;
 }
 
 ContentPtr ContentFactory::getPixelStreamContent(const QString& uri)
@@ -166,6 +187,7 @@ const QStringList& ContentFactory::getSupportedExtensions()
         extensions.append(TextureContent::getSupportedExtensions());
         extensions.append(DynamicTextureContent::getSupportedExtensions());
         extensions.append(MovieContent::getSupportedExtensions());
+        extensions.append(TiledMovieContent::getSupportedExtensions());
         extensions.removeDuplicates();
     }
 
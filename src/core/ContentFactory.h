@@ -41,6 +41,7 @@
 #define CONTENTFACTORY_H
 
 #include "types.h"
+#include "ContentType.h"
 
 #include <QStringList>
 #include <boost/shared_ptr.hpp>
@@ -53,6 +54,21 @@ public:
     /** Get a Content object of the appropriate derived type based on the URI given. */
     static ContentPtr getContent(const QString& uri);
 
+    /**
+     * Create a Content object of the appropriate type without reading its
+     * metadata, which is left to the caller (i.e. in a worker thread).
+     * @return the content, or a null pointer if the file does not exist or
+     *         is not supported.
+     */
+    static ContentPtr createContent(const QString& uri);
+
+    /**
+     * Create a Content object of a given type without accessing the file.
+     * @return the content, or a null pointer if the type can not be created
+     *         from a uri.
+     */
+    static ContentPtr createContent(CONTENT_TYPE type, const QString& uri);
+
     /** Special case: PixelStreamContent type cannot be derived from its uri. */
     static ContentPtr getPixelStreamContent(const QString& uri);
 
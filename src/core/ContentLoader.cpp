@@ -42,8 +42,15 @@
 #include "DisplayGroup.h"
 #include "ContentWindow.h"
 #include "ContentFactory.h"
+#include "ContentProbe.h"
 #include "ContentWindowController.h"
 
+namespace
+{
+// Size of the window, relative to the wall, until the content is probed
+const qreal PLACEHOLDER_RELATIVE_SIZE = 0.25;
+}
+
 ContentLoader::ContentLoader( DisplayGroupPtr displayGroup )
     : displayGroup_( displayGroup )
 {
@@ -53,26 +60,19 @@ bool ContentLoader::load( const QString& filename,
                           const QPointF& windowCenterPosition,
                           const QSizeF& windowSize )
 {
-    ContentPtr content = ContentFactory::getContent( filename );
-    if( !content )
-        return false;
+    ContentPtr content = ContentFactory::createContent( filename );
+    const bool probe = content.get() != 0;
+    if( !probe )
+        content = ContentFactory::getErrorContent();
 
     ContentWindowPtr contentWindow( new ContentWindow( content ));
     ContentWindowController controller( *contentWindow, *displayGroup_ );
 
+    const QSizeF wallSize = displayGroup_->getCoordinates().size();
     if( windowSize.isValid( ))
         controller.resize( windowSize );
     else
-    {
-        QSizeF size = content->getDimensions();
-        const QSizeF wallSize = displayGroup_->getCoordinates().size();
-        if( size.width() >  wallSize.width() ||
-            size.height() > wallSize.height( ))
-        {
-            size.scale( wallSize, Qt::KeepAspectRatio );
-        }
-        controller.resize( size );
-    }
+        controller.resize( wallSize * PLACEHOLDER_RELATIVE_SIZE );
 
     if( windowCenterPosition.isNull( ))
         controller.moveCenterTo( displayGroup_->getCoordinates().center( ));
@@ -81,5 +81,20 @@ bool ContentLoader::load( const QString& filename,
 
     displayGroup_->addContentWindow( contentWindow );
 
+    if( probe )
+        ContentProbe::start( contentWindow, displayGroup_,
+                             !windowSize.isValid( ));
     return true;
 }
+
+QSizeF ContentLoader::getDefaultWindowSize( const Content& content,
+                                            const QSizeF& wallSize )
+{
+    QSizeF size = content.getDimensions();
+    if( size.width() >  wallSize.width() ||
+        size.height() > wallSize.height( ))
+    {
+        size.scale( wallSize, Qt::KeepAspectRatio );
+    }
+    return size;
+}
@@ -62,6 +62,11 @@ public:
     /**
      * Load a Content from a file and create a window for it.
      *
+     * The window is added immediately with a placeholder size, while the
+     * metadata of the content is read asynchronously by a ContentProbe. Once
+     * done, the window is resized to the content dimensions, or shows an error
+     * content if the metadata could not be read.
+     *
      * @param filename The content file to open.
      * @param windowCenterPosition The point around which to center the window.
      *        If empty (default), the  window is automatically centered on the
@@ -74,6 +79,16 @@ public:
                const QPointF& windowCenterPosition = QPointF(),
                const QSizeF& windowSize = QSizeF( ));
 
+    /**
+     * Get the default size of a window for a content.
+     *
+     * @param content The content, with its metadata already read.
+     * @param wallSize The size of the wall, which bounds the window size.
+     * @return the content dimensions, downscaled to fit on the wall.
+     */
+    static QSizeF getDefaultWindowSize( const Content& content,
+                                        const QSizeF& wallSize );
+
 private:
     DisplayGroupPtr displayGroup_;
 };
@@ -0,0 +1,112 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "ContentProbe.h"
+
+#include "Content.h"
+#include "ContentFactory.h"
+#include "ContentLoader.h"
+#include "ContentWindow.h"
+#include "ContentWindowController.h"
+#include "DisplayGroup.h"
+
+#include "log.h"
+
+#include <QtConcurrentRun>
+
+namespace
+{
+// Called from a worker thread, the content is not shared until it returns
+bool readMetadata( ContentPtr content )
+{
+    return content->readMetadata();
+}
+}
+
+void ContentProbe::start( ContentWindowPtr window, DisplayGroupPtr displayGroup,
+                          const bool adjustSize )
+{
+    ContentProbe* probe = new ContentProbe( window, displayGroup, adjustSize );
+    if( !probe->content_ )
+    {
+        probe->deleteLater();
+        return;
+    }
+
+    connect( &probe->watcher_, SIGNAL( finished( )), probe, SLOT( finished( )));
+    probe->watcher_.setFuture( QtConcurrent::run( readMetadata,
+                                                  probe->content_ ));
+}
+
+ContentProbe::ContentProbe( ContentWindowPtr window,
+                            DisplayGroupPtr displayGroup,
+                            const bool adjustSize )
+    : window_( window )
+    , displayGroup_( displayGroup )
+    , content_( ContentFactory::createContent( window->getContent()->getURI( )))
+    , adjustSize_( adjustSize )
+{
+}
+
+void ContentProbe::finished()
+{
+    deleteLater();
+
+    // The window may have been closed in the meantime
+    ContentWindowPtr window = window_.lock();
+    if( !window || !displayGroup_->getContentWindow( window->getID( )))
+        return;
+
+    if( watcher_.result( ))
+        window->setContent( content_ );
+    else
+    {
+        put_flog( LOG_WARN, "Could not read metadata of '%s'",
+                  content_->getURI().toLocal8Bit().constData( ));
+        window->setContent( ContentFactory::getErrorContent( ));
+    }
+
+    if( !adjustSize_ )
+        return;
+
+    const QSizeF size = ContentLoader::getDefaultWindowSize(
+                            *window->getContent(),
+                            displayGroup_->getCoordinates().size( ));
+    if( size.isValid( ))
+        ContentWindowController( *window, *displayGroup_ ).resize( size, CENTER );
+}
@@ -0,0 +1,85 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef CONTENTPROBE_H
+#define CONTENTPROBE_H
+
+#include "types.h"
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <boost/weak_ptr.hpp>
+
+/**
+ * Read the metadata of a new Content in a worker thread, then update the
+ * placeholder window which displays it.
+ *
+ * The metadata is read into a separate Content object, which replaces the
+ * placeholder content once complete, so that the window can be displayed and
+ * synchronized with the wall in the meantime. A ContentProbe deletes itself
+ * when done.
+ */
+class ContentProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Start probing the content of a window.
+     * @param window The placeholder window, already in the DisplayGroup
+     * @param displayGroup The DisplayGroup of the window
+     * @param adjustSize Resize the window to the content dimensions when done
+     */
+    static void start( ContentWindowPtr window, DisplayGroupPtr displayGroup,
+                       bool adjustSize );
+
+private slots:
+    void finished();
+
+private:
+    ContentProbe( ContentWindowPtr window, DisplayGroupPtr displayGroup,
+                  bool adjustSize );
+
+    boost::weak_ptr< ContentWindow > window_;
+    DisplayGroupPtr displayGroup_;
+    ContentPtr content_;
+    bool adjustSize_;
+    QFutureWatcher< bool > watcher_;
+};
+
+#endif // CONTENTPROBE_H
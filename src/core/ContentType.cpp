@@ -50,7 +50,8 @@ static TypeMap typemap = boost::assign::list_of< TypeMap::relation >
         (CONTENT_TYPE_PIXEL_STREAM, QString("CONTENT_TYPE_PIXEL_STREAM"))
         (CONTENT_TYPE_SVG, QString("CONTENT_TYPE_SVG"))
         (CONTENT_TYPE_TEXTURE, QString("CONTENT_TYPE_TEXTURE"))
-        (CONTENT_TYPE_PDF, QString("CONTENT_TYPE_PDF"));
+        (CONTENT_TYPE_PDF, QString("CONTENT_TYPE_PDF"))
+        (CONTENT_TYPE_TILED_MOVIE, QString("CONTENT_TYPE_TILED_MOVIE"));
 
 QString getContentTypeString( const CONTENT_TYPE type )
 {
@@ -59,5 +60,6 @@ QString getContentTypeString( const CONTENT_TYPE type )
 
 CONTENT_TYPE getContentType( const QString& typeString )
 {
-    return typemap.right.find( typeString )->second;
+    const TypeMap::right_const_iterator it = typemap.right.find( typeString );
+    return it != typemap.right.end() ? it->second : CONTENT_TYPE_ANY;
 }
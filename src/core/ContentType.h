@@ -50,7 +50,8 @@ enum CONTENT_TYPE
     CONTENT_TYPE_PIXEL_STREAM,
     CONTENT_TYPE_SVG,
     CONTENT_TYPE_TEXTURE,
-    CONTENT_TYPE_PDF
+    CONTENT_TYPE_PDF,
+    CONTENT_TYPE_TILED_MOVIE
 };
 
 QString getContentTypeString( const CONTENT_TYPE type );
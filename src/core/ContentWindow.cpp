@@ -106,6 +106,10 @@ void ContentWindow::setContent( ContentPtr content )
     connect( content_.get(), SIGNAL( modified( )), SIGNAL( contentModified( )));
 
     createInteractionDelegate();
+
+    emit contentChanged();
+    emit labelChanged();
+    emit contentModified();
 }
 
 void ContentWindow::setCoordinates( const QRectF& coordinates )
@@ -223,6 +227,11 @@ bool ContentWindow::hasBackupCoordinates() const
     return coordinatesBackup_.isValid();
 }
 
+const QRectF& ContentWindow::getBackupCoordinates() const
+{
+    return coordinatesBackup_;
+}
+
 void ContentWindow::restoreCoordinates()
 {
     if( !hasBackupCoordinates( ))
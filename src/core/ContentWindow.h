@@ -71,7 +71,7 @@ class ContentWindow : public Coordinates
     Q_PROPERTY( WindowBorder border READ getBorder WRITE setBorder NOTIFY borderChanged )
     Q_PROPERTY( QString label READ getLabel NOTIFY labelChanged )
     Q_PROPERTY( qreal controlsOpacity READ getControlsOpacity WRITE setControlsOpacity NOTIFY controlsOpacityChanged )
-    Q_PROPERTY( Content* content READ getContentPtr CONSTANT )
+    Q_PROPERTY( Content* content READ getContentPtr NOTIFY contentChanged )
 
 public:
     /** The current active window border used for resizing */
@@ -182,6 +182,9 @@ public:
     /** Check if there are coordinates which can be restored. */
     bool hasBackupCoordinates() const;
 
+    /** Get the backed-up coordinates, invalid if there are none. */
+    const QRectF& getBackupCoordinates() const;
+
     /** Restore and clear the backed-up coordinates. */
     void restoreCoordinates();
 
@@ -213,6 +216,7 @@ signals:
     void stateChanged();
     void labelChanged();
     void controlsOpacityChanged();
+    void contentChanged();
     //@}
 
 private:
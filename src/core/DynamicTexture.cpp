@@ -315,6 +315,19 @@ void DynamicTexture::render(const QRectF& texCoords)
     render_(texCoords);
 }
 
+bool DynamicTexture::preload()
+{
+    if (isRoot() && !loadImageThreadStarted_)
+        loadImageAsync();
+
+    if (!loadImageThreadStarted_ || !loadImageThread_.isFinished())
+        return false;
+
+    if (!texture_.isValid())
+        generateTexture();
+    return true;
+}
+
 void DynamicTexture::preRenderUpdate()
 {
     // Root needs to always have a texture for renderInParent()
@@ -91,6 +91,11 @@ public:
      */
     void render(const QRectF& texCoords) override;
 
+    /**
+     * Load the root image of the pyramid and upload it as a texture.
+     */
+    bool preload() override;
+
     /**
      * Pre render step.
      */
@@ -0,0 +1,299 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "FFMPEGKeyframeIndex.h"
+
+#include "CacheDirectory.h"
+#include "MovieMetadataCache.h"
+#include "log.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cstdio>
+
+#pragma clang diagnostic ignored "-Wdeprecated"
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+namespace
+{
+const QString CACHE_SUBDIRECTORY( "/displaycluster/keyframes" );
+const QString CACHE_FILE_SUFFIX( ".keyframes" );
+const quint32 CACHE_MAGIC = 0x44434b46; // "DCKF"
+const quint32 CACHE_VERSION = 2;
+
+// Entries are 8 bytes per keyframe, a few kB for most movies
+const qint64 MAX_CACHE_SIZE_BYTES = 50 * 1024 * 1024;
+const int MAX_CACHE_AGE_DAYS = 60;
+
+QMutex pruneMutex;
+bool cachePruned = false;
+
+QString getCacheFilename( const QFileInfo& movie )
+{
+    const QByteArray hash = QCryptographicHash::hash(
+                movie.absoluteFilePath().toUtf8(), QCryptographicHash::Md5 );
+    return FFMPEGKeyframeIndex::getCacheDirectory() + "/" +
+           QString( hash.toHex( )) + CACHE_FILE_SUFFIX;
+}
+}
+
+FFMPEGKeyframeIndex::FFMPEGKeyframeIndex()
+{
+}
+
+bool FFMPEGKeyframeIndex::build(AVFormatContext& avFormatContext,
+                                const AVStream& videoStream, const QString& uri,
+                                const bool allowScan)
+{
+    timestamps_.clear();
+
+    if( readFromContainer( videoStream ) || load( uri ) ||
+        loadMetadataCache( uri ))
+    {
+        return true;
+    }
+
+    if( !allowScan )
+        return false;
+
+    if( !scanPackets( avFormatContext, videoStream ))
+    {
+        put_flog( LOG_WARN, "no keyframes found in: %s",
+                  uri.toLocal8Bit().constData( ));
+        return false;
+    }
+
+    save( uri );
+    return true;
+}
+
+void FFMPEGKeyframeIndex::build(const std::vector<int64_t>& timestamps)
+{
+    timestamps_ = timestamps;
+    std::sort( timestamps_.begin(), timestamps_.end( ));
+    timestamps_.erase( std::unique( timestamps_.begin(), timestamps_.end( )),
+                       timestamps_.end( ));
+}
+
+bool FFMPEGKeyframeIndex::save(const QString& uri) const
+{
+    const QFileInfo movie( uri );
+    if( !movie.exists() || !QDir().mkpath( getCacheDirectory( )))
+        return false;
+
+    // Several processes may index the same file concurrently; write to a
+    // private file first and atomically move it in place.
+    const QString cacheFilename = getCacheFilename( movie );
+    QFile file( cacheFilename + "." +
+                QString::number( QCoreApplication::applicationPid( )));
+    if( !file.open( QIODevice::WriteOnly ))
+    {
+        put_flog( LOG_DEBUG, "could not write keyframe index: %s",
+                  file.fileName().toLocal8Bit().constData( ));
+        return false;
+    }
+
+    QDataStream out( &file );
+    out << CACHE_MAGIC << CACHE_VERSION << (qint64)movie.size()
+        << (qint64)movie.lastModified().toMSecsSinceEpoch()
+        << (quint32)timestamps_.size();
+
+    for( std::vector<int64_t>::const_iterator it = timestamps_.begin();
+         it != timestamps_.end(); ++it )
+    {
+        out << (qint64)*it;
+    }
+    file.close();
+
+    if( out.status() != QDataStream::Ok ||
+        std::rename( file.fileName().toLocal8Bit().constData(),
+                     cacheFilename.toLocal8Bit().constData( )) != 0 )
+    {
+        file.remove();
+        return false;
+    }
+
+    // Once per process, on the first write, which is when the cache grows
+    bool pruneCache = false;
+    {
+        QMutexLocker locker( &pruneMutex );
+        pruneCache = !cachePruned;
+        cachePruned = true;
+    }
+    if( pruneCache )
+        CacheDirectory::prune( getCacheDirectory(), "*" + CACHE_FILE_SUFFIX + "*",
+                               MAX_CACHE_SIZE_BYTES, MAX_CACHE_AGE_DAYS );
+    return true;
+}
+
+bool FFMPEGKeyframeIndex::load(const QString& uri)
+{
+    const QFileInfo movie( uri );
+    if( !movie.exists( ))
+        return false;
+
+    QFile file( getCacheFilename( movie ));
+    if( !file.open( QIODevice::ReadOnly ))
+        return false;
+
+    QDataStream in( &file );
+    quint32 magic = 0, version = 0;
+    qint64 movieSize = 0, movieModified = 0;
+    quint32 count = 0;
+    in >> magic >> version >> movieSize >> movieModified >> count;
+
+    if( in.status() != QDataStream::Ok ||
+        magic != CACHE_MAGIC || version != CACHE_VERSION ||
+        movieSize != movie.size() ||
+        movieModified != movie.lastModified().toMSecsSinceEpoch( ))
+    {
+        return false;
+    }
+
+    std::vector<int64_t> timestamps( count );
+    for( quint32 i = 0; i < count; ++i )
+    {
+        qint64 timestamp;
+        in >> timestamp;
+        timestamps[i] = timestamp;
+    }
+
+    if( in.status() != QDataStream::Ok || timestamps.empty( ))
+        return false;
+
+    timestamps_.swap( timestamps );
+    return true;
+}
+
+QString FFMPEGKeyframeIndex::getCacheDirectory()
+{
+    return CacheDirectory::getUserCacheHome() + CACHE_SUBDIRECTORY;
+}
+
+bool FFMPEGKeyframeIndex::isEmpty() const
+{
+    return timestamps_.empty();
+}
+
+size_t FFMPEGKeyframeIndex::getKeyframeCount() const
+{
+    return timestamps_.size();
+}
+
+const std::vector<int64_t>& FFMPEGKeyframeIndex::getTimestamps() const
+{
+    return timestamps_;
+}
+
+int64_t FFMPEGKeyframeIndex::findKeyframe(const int64_t timestamp) const
+{
+    std::vector<int64_t>::const_iterator it =
+            std::upper_bound( timestamps_.begin(), timestamps_.end(), timestamp );
+
+    if( it == timestamps_.begin( ))
+        return AV_NOPTS_VALUE;
+
+    return *(--it);
+}
+
+bool FFMPEGKeyframeIndex::readFromContainer(const AVStream& videoStream)
+{
+    for( int i = 0; i < videoStream.nb_index_entries; ++i )
+    {
+        const AVIndexEntry& entry = videoStream.index_entries[i];
+        if( entry.flags & AVINDEX_KEYFRAME )
+            timestamps_.push_back( entry.timestamp );
+    }
+    std::sort( timestamps_.begin(), timestamps_.end( ));
+
+    // Some demuxers only index the first keyframe until the file has been read
+    return timestamps_.size() > 1;
+}
+
+bool FFMPEGKeyframeIndex::scanPackets(AVFormatContext& avFormatContext,
+                                      const AVStream& videoStream)
+{
+    timestamps_.clear();
+
+    AVPacket packet;
+    av_init_packet( &packet );
+
+    // Only demux the file, decoding is not needed to locate keyframes
+    while( av_read_frame( &avFormatContext, &packet ) >= 0 )
+    {
+        if( packet.stream_index == videoStream.index &&
+            ( packet.flags & AV_PKT_FLAG_KEY ))
+        {
+            const int64_t timestamp = packet.dts != (int64_t)AV_NOPTS_VALUE ?
+                                          packet.dts : packet.pts;
+            if( timestamp != (int64_t)AV_NOPTS_VALUE )
+                timestamps_.push_back( timestamp );
+        }
+        av_free_packet( &packet );
+    }
+    std::sort( timestamps_.begin(), timestamps_.end( ));
+
+    av_seek_frame( &avFormatContext, videoStream.index, 0, AVSEEK_FLAG_BACKWARD );
+
+    return !timestamps_.empty();
+}
+
+bool FFMPEGKeyframeIndex::loadMetadataCache(const QString& uri)
+{
+    // Never probes: on a miss the caller is either the probe itself, or a
+    // wall process which then seeks without an index.
+    MovieMetadata metadata;
+    if( !MovieMetadataCache::lookup( uri, metadata ) ||
+        metadata.keyframes.isEmpty( ))
+    {
+        return false;
+    }
+
+    build( std::vector<int64_t>( metadata.keyframes.begin(),
+                                 metadata.keyframes.end( )));
+    return true;
+}
@@ -0,0 +1,146 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef FFMPEGKEYFRAMEINDEX_H
+#define FFMPEGKEYFRAMEINDEX_H
+
+// required for FFMPEG includes below, specifically for the Linux build
+#ifdef __cplusplus
+    #ifndef __STDC_CONSTANT_MACROS
+        #define __STDC_CONSTANT_MACROS
+    #endif
+
+    #ifdef _STDINT_H
+        #undef _STDINT_H
+    #endif
+
+    #include <stdint.h>
+#endif
+
+extern "C"
+{
+    #include <libavformat/avformat.h>
+}
+
+#include <QString>
+#include <vector>
+
+/**
+ * Sorted list of the keyframe timestamps of a video stream.
+ *
+ * The index lets FFMPEGMovie seek directly to the keyframe preceding a target
+ * frame and decode the minimum number of frames to reach it. It is taken from
+ * the container when available (mov, mp4, mkv...). Otherwise the packets of
+ * the stream have to be scanned once, which reads the whole file: this is
+ * only done by the master application when it probes the movie, off the GUI
+ * thread. The result is cached on disk in the user's cache folder and in the
+ * MovieMetadataCache, where the wall processes find it. A wall never scans a
+ * file; without an index, it lets FFMPEG find the keyframe when seeking.
+ */
+class FFMPEGKeyframeIndex
+{
+public:
+    /** Create an empty index. */
+    FFMPEGKeyframeIndex();
+
+    /**
+     * Build the index for a video stream.
+     * If the packets have to be scanned, the read position of the
+     * avFormatContext is moved back to the start of the stream afterwards.
+     * @param avFormatContext The context of the opened movie file
+     * @param videoStream The video stream to index
+     * @param uri The movie file, used to locate the cached indices
+     * @param allowScan Scan the packets if the index is neither in the
+     *        container nor in a cache, which reads the whole file.
+     * @return true if at least one keyframe was found
+     */
+    bool build(AVFormatContext& avFormatContext, const AVStream& videoStream,
+               const QString& uri, bool allowScan);
+
+    /**
+     * Build the index from a list of keyframe timestamps.
+     * @param timestamps The timestamps, in any order
+     */
+    void build(const std::vector<int64_t>& timestamps);
+
+    /**
+     * Save the index to the on-disk cache.
+     * @param uri The movie file which was indexed
+     * @return true on success
+     */
+    bool save(const QString& uri) const;
+
+    /**
+     * Load the index of a movie from the on-disk cache.
+     * @param uri The movie file
+     * @return false if there is no valid index for the current version of
+     *         the file
+     */
+    bool load(const QString& uri);
+
+    /**
+     * @return The directory where the indices are saved,
+     * $XDG_CACHE_HOME/displaycluster/keyframes or ~/.cache/...
+     */
+    static QString getCacheDirectory();
+
+    /** @return true if the index contains no keyframes. */
+    bool isEmpty() const;
+
+    /** @return The number of keyframes in the index. */
+    size_t getKeyframeCount() const;
+
+    /** @return The sorted keyframe timestamps. */
+    const std::vector<int64_t>& getTimestamps() const;
+
+    /**
+     * Find the last keyframe at or before a timestamp.
+     * @param timestamp A decoding timestamp in the stream time base
+     * @return the keyframe timestamp, or AV_NOPTS_VALUE if there is none
+     */
+    int64_t findKeyframe(const int64_t timestamp) const;
+
+private:
+    std::vector<int64_t> timestamps_;
+
+    bool readFromContainer(const AVStream& videoStream);
+    bool scanPackets(AVFormatContext& avFormatContext, const AVStream& videoStream);
+    bool loadMetadataCache(const QString& uri);
+};
+
+#endif // FFMPEGKEYFRAMEINDEX_H
@@ -42,14 +42,42 @@
 #include "FFMPEGVideoFrameConverter.h"
 #include "log.h"
 
-#define INVALID_STREAM_INDEX -1
+#include <QMutex>
 
-#define MICROSEC 1000000.0
+#define INVALID_STREAM_INDEX -1
 
 #pragma clang diagnostic ignored "-Wdeprecated"
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
-FFMPEGMovie::FFMPEGMovie(const QString& uri)
+namespace
+{
+QMutex globalStateMutex;
+
+// Movies are opened concurrently by the content probes and the thumbnail
+// generators; FFMPEG needs a lock manager to serialize avcodec_open2/close.
+int lockManager(void** mutex, enum AVLockOp operation)
+{
+    switch (operation)
+    {
+    case AV_LOCK_CREATE:
+        *mutex = new QMutex;
+        return 0;
+    case AV_LOCK_OBTAIN:
+        static_cast<QMutex*>(*mutex)->lock();
+        return 0;
+    case AV_LOCK_RELEASE:
+        static_cast<QMutex*>(*mutex)->unlock();
+        return 0;
+    case AV_LOCK_DESTROY:
+        delete static_cast<QMutex*>(*mutex);
+        *mutex = 0;
+        return 0;
+    }
+    return 1;
+}
+}
+
+FFMPEGMovie::FFMPEGMovie(const QString& uri, const bool scanKeyframes)
     : avFormatContext_(0)
     , videoCodecContext_(0)
     , avFrame_(0)
@@ -60,7 +88,6 @@ FFMPEGMovie::FFMPEGMovie(const QString& uri)
     , frameDuration_(0)
     , frameDurationInSeconds_(0)
     // Internal
-    , loop_(false)
     , frameDecodingComplete_(0)
     , isValid_(false)
     , skippedFrames_(false)
@@ -70,7 +97,7 @@ FFMPEGMovie::FFMPEGMovie(const QString& uri)
 {
     FFMPEGMovie::initGlobalState();
 
-    isValid_ = open(uri);
+    isValid_ = open(uri, scanKeyframes);
 }
 
 FFMPEGMovie::~FFMPEGMovie()
@@ -81,7 +108,7 @@ FFMPEGMovie::~FFMPEGMovie()
     av_free(avFrame_);
 }
 
-bool FFMPEGMovie::open(const QString& uri)
+bool FFMPEGMovie::open(const QString& uri, const bool scanKeyframes)
 {
     if (!createAvFormatContext(uri))
         return false;
@@ -104,6 +131,8 @@ bool FFMPEGMovie::open(const QString& uri)
     if( !generateSeekingParameters( ))
         return false;
 
+    keyframeIndex_.build(*avFormatContext_, *videoStream_, uri, scanKeyframes);
+
     return true;
 }
 
@@ -123,7 +152,9 @@ bool FFMPEGMovie::createAvFormatContext(const QString& uri)
         return false;
     }
 
+#if LOG_THRESHHOLD <= LOG_DEBUG
     av_dump_format(avFormatContext_, 0, uri.toAscii(), 0); // dump format information to stderr
+#endif
     return true;
 }
 
@@ -184,8 +215,11 @@ void FFMPEGMovie::initGlobalState()
 {
     static bool initialized = false;
 
+    QMutexLocker lock(&globalStateMutex);
     if (!initialized)
     {
+        if (av_lockmgr_register(&lockManager) != 0)
+            put_flog(LOG_ERROR, "could not register the FFMPEG lock manager");
         av_register_all();
         initialized = true;
     }
@@ -211,11 +245,6 @@ const void* FFMPEGMovie::getData() const
     return videoFrameConverter_->getData();
 }
 
-void FFMPEGMovie::setLoop(const bool loop)
-{
-    loop_ = loop;
-}
-
 double FFMPEGMovie::getDuration() const
 {
     const double duration = (double)videoStream_->duration *
@@ -223,6 +252,21 @@ double FFMPEGMovie::getDuration() const
     return std::max(duration, 0.0);
 }
 
+double FFMPEGMovie::getFrameRate() const
+{
+    return frameDurationInSeconds_ > 0.0 ? 1.0 / frameDurationInSeconds_ : 0.0;
+}
+
+size_t FFMPEGMovie::getKeyframeCount() const
+{
+    return keyframeIndex_.getKeyframeCount();
+}
+
+const std::vector<int64_t>& FFMPEGMovie::getKeyframes() const
+{
+    return keyframeIndex_.getTimestamps();
+}
+
 boost::posix_time::time_duration FFMPEGMovie::getTimestamp() const
 {
     return timePosition_;
@@ -238,16 +282,13 @@ bool FFMPEGMovie::jumpTo(const double timePosInSeconds)
     newFrameAvailable_ = false;
 
     const int64_t frameIndex = timePosInSeconds / frameDurationInSeconds_;
-    if (!seekToNearestFullframe(frameIndex))
+    if (!seekToFrame(frameIndex))
         return false;
 
-    do {
-        if(!readVideoFrame())
-            return false;
-    }
-    while( !frameDecodingComplete_ );
+    if (!decodeUntil(getTimestampForFrameIndex(frameIndex)))
+        return false;
 
-    timePosition_ = boost::posix_time::microseconds(timePosInSeconds * MICROSEC);
+    timePosition_ = boost::posix_time::microseconds(timePosInSeconds * AV_TIME_BASE);
 
     convertVideoFrame();
     return true;
@@ -255,22 +296,8 @@ bool FFMPEGMovie::jumpTo(const double timePosInSeconds)
 
 void FFMPEGMovie::update(const boost::posix_time::time_duration timestamp, const bool skipDecoding)
 {
-    if( isAtEOF( ))
-        return;
-
     newFrameAvailable_ = false;
-
-    // If decoding is slower than frame rate, slow down decoding speed
-    const boost::posix_time::time_duration timeSinceLastFrame = timestamp - timePosition_;
-    const double timeIncrementInSec = timeSinceLastFrame.total_microseconds() / MICROSEC;
-    if (timeIncrementInSec < frameDurationInSeconds_)
-        timePosition_ = timestamp;
-    else
-    {
-        const double factor = frameDurationInSeconds_ / timeIncrementInSec;
-        const double increment = factor * frameDurationInSeconds_;
-        timePosition_ += boost::posix_time::microseconds(increment * MICROSEC);
-    }
+    timePosition_ = timestamp;
 
     if (skipDecoding)
     {
@@ -278,33 +305,31 @@ void FFMPEGMovie::update(const boost::posix_time::time_duration timestamp, const
         return;
     }
 
-    if (skippedFrames_)
-        clampTimePosition();
-
-    const double timePositionInSec = timePosition_.total_microseconds() / MICROSEC;
-    const int64_t index = timePositionInSec / frameDurationInSeconds_;
+    const double timePositionInSec = timePosition_.total_microseconds() / (double)AV_TIME_BASE;
+    int64_t index = timePositionInSec / frameDurationInSeconds_;
+    if (numFrames_ && index >= numFrames_)
+        index = numFrames_ - 1;
+    const int64_t frameTimestamp = getTimestampForFrameIndex(index);
 
     bool readNewVideoFrame = false;
 
-    // Catch up on missed frames
-    if( skippedFrames_ )
+    // Seek after frames were skipped, when the position moved backwards (loop)
+    // or when the target is more than one frame ahead. In the latter case
+    // seekToFrame() only seeks if a keyframe is closer than the current frame.
+    const int64_t currentTimestamp = avFrame_->pkt_dts;
+    if( skippedFrames_ || currentTimestamp > frameTimestamp + frameDuration_ ||
+        currentTimestamp < frameTimestamp - frameDuration_ )
     {
-        readNewVideoFrame = seekToNearestFullframe( index );
+        readNewVideoFrame = seekToFrame( index );
         skippedFrames_ = false;
     }
 
     // Read frames until we reach the correct timestamp
-    while( avFrame_->pkt_dts < getTimestampForFrameIndex( index ))
+    while( avFrame_->pkt_dts < frameTimestamp )
     {
-        // Read one frame and return to start if EOF reached
-        if( readVideoFrame( ))
-            readNewVideoFrame = true;
-        else
-        {
-            if( loop_ )
-                rewind();
+        if( !readVideoFrame( ))
             break;
-        }
+        readNewVideoFrame = true;
     }
 
     if( readNewVideoFrame )
@@ -316,17 +341,6 @@ bool FFMPEGMovie::isNewFrameAvailable() const
     return newFrameAvailable_;
 }
 
-void FFMPEGMovie::clampTimePosition()
-{
-    const double duration = getDuration();
-
-    if(duration <= 0.0)
-        return;
-
-    while (timePosition_.total_microseconds() / MICROSEC > duration)
-        timePosition_ -= boost::posix_time::microseconds(duration * MICROSEC);
-}
-
 int64_t FFMPEGMovie::getTimestampForFrameIndex(const int64_t frameIndex) const
 {
     if (frameIndex < 0 || (numFrames_ && frameIndex >= numFrames_))
@@ -343,7 +357,7 @@ int64_t FFMPEGMovie::getTimestampForFrameIndex(const int64_t frameIndex) const
     return timestamp;
 }
 
-bool FFMPEGMovie::seekToNearestFullframe(const int64_t frameIndex)
+bool FFMPEGMovie::seekToFrame(const int64_t frameIndex)
 {
     if (frameIndex < 0 || (numFrames_ && frameIndex >= numFrames_))
     {
@@ -352,10 +366,24 @@ bool FFMPEGMovie::seekToNearestFullframe(const int64_t frameIndex)
     }
 
     const int64_t desiredTimestamp = getTimestampForFrameIndex(frameIndex);
+    const int64_t keyframe = keyframeIndex_.findKeyframe(desiredTimestamp);
+
+    // If no keyframe lies between the current frame and the target, decoding
+    // forward from the current position is cheaper than seeking.
+    const int64_t currentTimestamp = avFrame_->pkt_dts;
+    if (keyframe != (int64_t)AV_NOPTS_VALUE &&
+        currentTimestamp != (int64_t)AV_NOPTS_VALUE &&
+        currentTimestamp >= keyframe && currentTimestamp < desiredTimestamp)
+    {
+        return true;
+    }
 
-    // Seek to the nearest keyframe before desiredTimestamp.
-    if(avformat_seek_file(avFormatContext_, videoStream_->index, 0, desiredTimestamp,
-                          desiredTimestamp, AVSEEK_FLAG_FRAME) != 0)
+    // Seek to the keyframe before desiredTimestamp. Without an index, let
+    // FFMPEG find the nearest one.
+    const int64_t seekTimestamp = keyframe != (int64_t)AV_NOPTS_VALUE ?
+                                      keyframe : desiredTimestamp;
+    if(av_seek_frame(avFormatContext_, videoStream_->index, seekTimestamp,
+                     AVSEEK_FLAG_BACKWARD) < 0)
     {
         put_flog(LOG_ERROR, "seeking error, seeking aborted.");
         return false;
@@ -368,6 +396,16 @@ bool FFMPEGMovie::seekToNearestFullframe(const int64_t frameIndex)
     return readVideoFrame();
 }
 
+bool FFMPEGMovie::decodeUntil(const int64_t timestamp)
+{
+    while(avFrame_->pkt_dts < timestamp)
+    {
+        if(!readVideoFrame())
+            return false;
+    }
+    return true;
+}
+
 bool FFMPEGMovie::readVideoFrame()
 {
     int avReadStatus = 0;
@@ -398,21 +436,6 @@ bool FFMPEGMovie::isVideoStream(const AVPacket& packet) const
     return packet.stream_index == videoStream_->index;
 }
 
-void FFMPEGMovie::rewind()
-{
-    if (av_seek_frame(avFormatContext_, videoStream_->index, 0, AVSEEK_FLAG_BACKWARD) >= 0)
-    {
-        put_flog(LOG_DEBUG, "Time: %lf", timePosition_.total_microseconds() / MICROSEC );
-
-        timePosition_ = boost::posix_time::time_duration();
-
-        // Always flush buffers after seeking
-        avcodec_flush_buffers(videoCodecContext_);
-
-        readVideoFrame();
-    }
-}
-
 bool FFMPEGMovie::decodeVideoFrame(AVPacket& packet)
 {
     // decode video frame
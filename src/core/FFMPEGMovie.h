@@ -61,6 +61,8 @@ extern "C"
     #include <libavutil/mathematics.h>
 }
 
+#include "FFMPEGKeyframeIndex.h"
+
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include <QString>
@@ -76,8 +78,11 @@ public:
     /**
      * Constructor.
      * @param uri: the movie file to open.
+     * @param scanKeyframes: scan the whole file to index its keyframes if the
+     *        index is not available otherwise, see FFMPEGKeyframeIndex. Only
+     *        for the probes of the master, never on a render thread.
      */
-    FFMPEGMovie(const QString& uri);
+    FFMPEGMovie(const QString& uri, bool scanKeyframes = false);
 
     /** Destructor */
     ~FFMPEGMovie();
@@ -99,7 +104,10 @@ public:
 
     /**
      * Update the internal timestamp to play the movie.
-     * @param timestamp The desired timestamp.
+     *
+     * The frame presented at the given timestamp is decoded, seeking if the
+     * timestamp moved backwards or far enough ahead.
+     * @param timestamp The desired timestamp, usually from a PresentationScheduler.
      * @param skipDecoding Only update the timestamp without reading or decoding the movie.
      */
     void update(const boost::posix_time::time_duration timestamp, const bool skipDecoding);
@@ -113,12 +121,18 @@ public:
      */
     bool isNewFrameAvailable() const;
 
-    /** Set looping behaviour when reaching the end of the file. */
-    void setLoop(const bool loop);
-
     /** Get the movie duration in seconds. May be unavailable for some movies. */
     double getDuration() const;
 
+    /** Get the number of frames per second. */
+    double getFrameRate() const;
+
+    /** Get the number of keyframes in the video stream. */
+    size_t getKeyframeCount() const;
+
+    /** Get the sorted keyframe timestamps, in the video stream time base. */
+    const std::vector<int64_t>& getKeyframes() const;
+
     /** Get the current timestamp. */
     boost::posix_time::time_duration getTimestamp() const;
 
@@ -127,6 +141,10 @@ public:
 
     /**
      * Jump to a random position in the movie.
+     *
+     * The movie seeks to the keyframe preceding the requested position and
+     * decodes forward to the exact frame, or only decodes forward if the
+     * current frame is already past that keyframe.
      * @param timePosInSeconds The desired position in seconds
      * @return true on success
      */
@@ -142,6 +160,7 @@ private:
     FFMPEGVideoFrameConverter * videoFrameConverter_; // Convert decoded frames to RGBA format
 
     // used for seeking
+    FFMPEGKeyframeIndex keyframeIndex_;
     int64_t numFrames_;
     double frameDuration_;
     double frameDurationInSeconds_;
@@ -149,7 +168,6 @@ private:
     boost::posix_time::time_duration timePosition_;
 
     // Internal
-    bool loop_;
     int frameDecodingComplete_;
     bool isValid_;
     bool skippedFrames_;
@@ -158,10 +176,10 @@ private:
     bool newFrameAvailable_;
     bool isAtEOF_;
 
-    /** Init the global FFMPEG context. */
+    /** Init the global FFMPEG context, thread-safe. */
     static void initGlobalState();
 
-    bool open(const QString& uri);
+    bool open(const QString& uri, bool scanKeyframes);
 
     bool createAvFormatContext(const QString& uri);
     void releaseAvFormatContext();
@@ -172,12 +190,11 @@ private:
     void closeVideoStreamDecoder() const;
 
     bool readVideoFrame();
-    bool seekToNearestFullframe(const int64_t frameIndex);
-    void clampTimePosition();
+    bool seekToFrame(const int64_t frameIndex);
+    bool decodeUntil(const int64_t timestamp);
     int64_t getTimestampForFrameIndex(const int64_t frameIndex) const;
     bool decodeVideoFrame(AVPacket& packet);
     bool convertVideoFrame();
-    void rewind();
     bool isVideoStream(const AVPacket& packet) const;
     bool generateSeekingParameters();
 };
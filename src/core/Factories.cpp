@@ -42,10 +42,70 @@
 #include "Content.h"
 #include "DisplayGroup.h"
 #include "ContentWindow.h"
+#include "SessionPreload.h"
+#include "WallToWallChannel.h"
+#include "log.h"
 #include <deflect/PixelStreamFrame.h>
 
+#include <QtConcurrentRun>
+
+#include <boost/bind.hpp>
 #include <boost/foreach.hpp>
 
+// Release the objects of a preload which is not ready or not displayed in time
+#define PRELOAD_TIMEOUT_MS 60000
+
+namespace
+{
+FactoryObjectPtr keepObject( FactoryObjectPtr object )
+{
+    return object;
+}
+
+#if ENABLE_PDF_SUPPORT
+FactoryObjectPtr createPDF( const QString& uri, PDFDocumentPtr document )
+{
+    return FactoryObjectPtr( new PDF( uri, document ));
+}
+#endif
+
+FactoryObjectPtr createSVG( const QString& uri, const QByteArray& imageData )
+{
+    return FactoryObjectPtr( new SVG( uri, imageData ));
+}
+
+// Called from a worker thread to open and parse the file of a Content. The
+// returned function creates the object in the render thread, which must own
+// all TiledTextures and QObjects: PDF and SVG only get their document or data
+// here, the other types have no such constraint and are fully created.
+// PixelStreams are not prepared at all, creating them does not block.
+Factories::ObjectCreator prepareFactoryObject( const CONTENT_TYPE type,
+                                               const QString uri )
+{
+    switch( type )
+    {
+    case CONTENT_TYPE_TEXTURE:
+        return boost::bind( &keepObject, FactoryObjectPtr( new Texture( uri )));
+    case CONTENT_TYPE_DYNAMIC_TEXTURE:
+        return boost::bind( &keepObject,
+                            FactoryObjectPtr( new DynamicTexture( uri )));
+#if ENABLE_PDF_SUPPORT
+    case CONTENT_TYPE_PDF:
+        return boost::bind( &createPDF, uri, PDFDocument::get( uri ));
+#endif
+    case CONTENT_TYPE_SVG:
+        return boost::bind( &createSVG, uri, SVG::readFile( uri ));
+    case CONTENT_TYPE_MOVIE:
+        return boost::bind( &keepObject, FactoryObjectPtr( new Movie( uri )));
+    case CONTENT_TYPE_TILED_MOVIE:
+        return boost::bind( &keepObject,
+                            FactoryObjectPtr( new TiledMovie( uri )));
+    default:
+        return Factories::ObjectCreator();
+    }
+}
+}
+
 Factories::Factories(const Factory<FactoryObject>::NewObjectFunc& func)
     : frameIndex_(0)
     , textureFactory_(func)
@@ -56,6 +116,9 @@ Factories::Factories(const Factory<FactoryObject>::NewObjectFunc& func)
     , svgFactory_(func)
     , movieFactory_(func)
     , pixelStreamFactory_(func)
+    , tiledMovieFactory_(func)
+    , preloadReady_(false)
+    , preloadFinished_(false)
 {
 }
 
@@ -69,6 +132,7 @@ void Factories::clearStaleFactoryObjects()
     svgFactory_.clearStaleObjects(frameIndex_);
     movieFactory_.clearStaleObjects(frameIndex_);
     pixelStreamFactory_.clearStaleObjects(frameIndex_);
+    tiledMovieFactory_.clearStaleObjects(frameIndex_);
 
     ++frameIndex_;
 }
@@ -83,6 +147,7 @@ void Factories::clear()
     svgFactory_.clear();
     movieFactory_.clear();
     pixelStreamFactory_.clear();
+    tiledMovieFactory_.clear();
 }
 
 void Factories::preRenderUpdate( DisplayGroup& displayGroup, WallToWallChannel& wallChannel )
@@ -98,6 +163,14 @@ void Factories::preRenderUpdate( DisplayGroup& displayGroup, WallToWallChannel&
     ContentPtr backgroundContent = displayGroup.getBackgroundContent();
     if( backgroundContent )
         backgroundContent->preRenderUpdate( *this, ContentWindowPtr(), wallChannel );
+
+    if( preload_ )
+    {
+        if( preloadFinished_ )
+            keepPreloadedObjects();
+        else
+            preloadReady_ = preloadObjects();
+    }
 }
 
 void Factories::postRenderUpdate( DisplayGroup& displayGroup, WallToWallChannel& wallChannel )
@@ -114,6 +187,11 @@ void Factories::postRenderUpdate( DisplayGroup& displayGroup, WallToWallChannel&
     if( backgroundContent )
         backgroundContent->postRenderUpdate( *this, ContentWindowPtr(), wallChannel );
 
+    movieClock_.synchronize( wallChannel );
+
+    if( preload_ )
+        updatePreload( wallChannel );
+
     clearStaleFactoryObjects();
 }
 
@@ -142,6 +220,9 @@ FactoryObjectPtr Factories::getFactoryObject(ContentPtr content)
     case CONTENT_TYPE_PIXEL_STREAM:
         object = pixelStreamFactory_.getObject(content->getURI());
         break;
+    case CONTENT_TYPE_TILED_MOVIE:
+        object = tiledMovieFactory_.getObject(content->getURI());
+        break;
     default:
         return FactoryObjectPtr();
         break;
@@ -150,6 +231,61 @@ FactoryObjectPtr Factories::getFactoryObject(ContentPtr content)
     return object;
 }
 
+FactoryObjectPtr Factories::findFactoryObject(ContentPtr content)
+{
+    switch (content->getType())
+    {
+    case CONTENT_TYPE_TEXTURE:
+        return textureFactory_.findObject(content->getURI());
+    case CONTENT_TYPE_DYNAMIC_TEXTURE:
+        return dynamicTextureFactory_.findObject(content->getURI());
+#if ENABLE_PDF_SUPPORT
+    case CONTENT_TYPE_PDF:
+        return pdfFactory_.findObject(content->getURI());
+#endif
+    case CONTENT_TYPE_SVG:
+        return svgFactory_.findObject(content->getURI());
+    case CONTENT_TYPE_MOVIE:
+        return movieFactory_.findObject(content->getURI());
+    case CONTENT_TYPE_PIXEL_STREAM:
+        return pixelStreamFactory_.findObject(content->getURI());
+    case CONTENT_TYPE_TILED_MOVIE:
+        return tiledMovieFactory_.findObject(content->getURI());
+    default:
+        return FactoryObjectPtr();
+    }
+}
+
+FactoryObjectPtr Factories::addFactoryObject(ContentPtr content,
+                                             FactoryObjectPtr object)
+{
+    switch (content->getType())
+    {
+    case CONTENT_TYPE_TEXTURE:
+        return textureFactory_.addObject(content->getURI(),
+                    boost::static_pointer_cast<Texture>(object));
+    case CONTENT_TYPE_DYNAMIC_TEXTURE:
+        return dynamicTextureFactory_.addObject(content->getURI(),
+                    boost::static_pointer_cast<DynamicTexture>(object));
+#if ENABLE_PDF_SUPPORT
+    case CONTENT_TYPE_PDF:
+        return pdfFactory_.addObject(content->getURI(),
+                    boost::static_pointer_cast<PDF>(object));
+#endif
+    case CONTENT_TYPE_SVG:
+        return svgFactory_.addObject(content->getURI(),
+                    boost::static_pointer_cast<SVG>(object));
+    case CONTENT_TYPE_MOVIE:
+        return movieFactory_.addObject(content->getURI(),
+                    boost::static_pointer_cast<Movie>(object));
+    case CONTENT_TYPE_TILED_MOVIE:
+        return tiledMovieFactory_.addObject(content->getURI(),
+                    boost::static_pointer_cast<TiledMovie>(object));
+    default:
+        return FactoryObjectPtr();
+    }
+}
+
 void Factories::updatePixelStream(deflect::PixelStreamFramePtr frame)
 {
     typedef boost::shared_ptr<PixelStream> PixelStreamPtr;
@@ -189,3 +325,120 @@ Factory<PixelStream> & Factories::getPixelStreamFactory()
 {
     return pixelStreamFactory_;
 }
+
+Factory<TiledMovie> & Factories::getTiledMovieFactory()
+{
+    return tiledMovieFactory_;
+}
+
+MovieClock& Factories::getMovieClock()
+{
+    return movieClock_;
+}
+
+void Factories::setPreload( SessionPreloadPtr preload )
+{
+    // Objects still being prepared for a replaced preload are dropped when
+    // their worker thread finishes, which is safe as they do not own any
+    // TiledTexture or QObject yet
+    pendingObjects_.clear();
+
+    preload_ = preload;
+    preloadReady_ = false;
+    preloadFinished_ = false;
+    preloadDeadline_ = boost::posix_time::ptime();
+}
+
+bool Factories::preloadObjects()
+{
+    bool ready = true;
+    BOOST_FOREACH( ContentPtr content, preload_->getContents( ))
+    {
+        FactoryObjectPtr object = findFactoryObject( content );
+        if( !object && content->getType() == CONTENT_TYPE_PIXEL_STREAM )
+            object = getFactoryObject( content );
+
+        if( !object )
+        {
+            // Creating the objects opens and parses their files, which must
+            // not delay the rendering of the current session
+            const QString& uri = content->getURI();
+            PendingObjects::iterator it = pendingObjects_.find( uri );
+            if( it == pendingObjects_.end( ))
+            {
+                pendingObjects_[uri] = QtConcurrent::run( prepareFactoryObject,
+                                                          content->getType(),
+                                                          uri );
+                ready = false;
+                continue;
+            }
+            if( !it->second.isFinished( ))
+            {
+                ready = false;
+                continue;
+            }
+            // Contents without a factory have nothing to preload
+            const ObjectCreator createObject = it->second.result();
+            if( !createObject )
+                continue;
+
+            object = addFactoryObject( content, createObject( ));
+            pendingObjects_.erase( it );
+        }
+
+        // Accessing the objects also protects them from garbage collection
+        object->setFrameIndex( frameIndex_ );
+        if( !object->preload( ))
+            ready = false;
+    }
+    return ready;
+}
+
+void Factories::keepPreloadedObjects()
+{
+    BOOST_FOREACH( ContentPtr content, preload_->getContents( ))
+    {
+        FactoryObjectPtr object = findFactoryObject( content );
+        if( object )
+            object->setFrameIndex( frameIndex_ );
+    }
+}
+
+void Factories::updatePreload( WallToWallChannel& wallChannel )
+{
+    const boost::posix_time::ptime now = wallChannel.getTime();
+    if( preloadDeadline_.is_not_a_date_time( ))
+        preloadDeadline_ = now + boost::posix_time::milliseconds( PRELOAD_TIMEOUT_MS );
+    const bool expired = now > preloadDeadline_;
+
+    // Once finished, the master releases the preload when it displays the
+    // session or discards it; the deadline covers a session never displayed
+    if( preloadFinished_ )
+    {
+        if( expired )
+            setPreload( SessionPreloadPtr( ));
+        return;
+    }
+
+    // The preload is swapped synchronously, so all processes take part in
+    // the collective operation during the same frames. It also makes them
+    // agree on giving up if any of them has expired.
+    std::vector< int64_t > localValues;
+    localValues.push_back( preloadReady_ ? 1 : 0 );
+    localValues.push_back( expired ? 0 : 1 );
+    const std::vector< int64_t > globalValues =
+            wallChannel.globalMin( localValues );
+
+    if( globalValues[0] )
+    {
+        preloadFinished_ = true;
+        preloadDeadline_ = now + boost::posix_time::milliseconds( PRELOAD_TIMEOUT_MS );
+        emit preloadFinished( preload_->getId( ));
+    }
+    else if( !globalValues[1] )
+    {
+        put_flog( LOG_WARN, "Could not preload session %u in time, releasing it",
+                  preload_->getId( ));
+        setPreload( SessionPreloadPtr( ));
+    }
+}
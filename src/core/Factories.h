@@ -41,6 +41,7 @@
 #define FACTORIES_H
 
 #include "config.h"
+#include "types.h"
 #include "Factory.hpp"
 #include "Texture.h"
 #include "DynamicTexture.h"
@@ -49,10 +50,17 @@
 #endif
 #include "SVG.h"
 #include "Movie.h"
+#include "MovieClock.h"
 #include "PixelStream.h"
+#include "TiledMovie.h"
 
+#include <QFuture>
 #include <QObject>
 
+#include <map>
+#include <boost/function.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
 /**
  * A set of Factory<T> for all valid ContentTypes.
  *
@@ -101,8 +109,35 @@ public:
     Factory<SVG> & getSVGFactory();
     Factory<Movie> & getMovieFactory();
     Factory<PixelStream> & getPixelStreamFactory();
+    Factory<TiledMovie> & getTiledMovieFactory();
     //@}
 
+    /** Create an object prepared in a worker thread, in the render thread. */
+    typedef boost::function< FactoryObjectPtr() > ObjectCreator;
+
+    /** Get the clock which synchronizes all movies after rendering. */
+    MovieClock& getMovieClock();
+
+    /**
+     * Load the contents of an upcoming session in the background.
+     *
+     * The objects are created in worker threads, then preloaded a little more
+     * every frame on the render thread. They are kept alive until the preload
+     * is cancelled or replaced, which the master does once it displays the
+     * session, or until it expires if the session is never displayed.
+     * Must be called on all processes in the same frame.
+     * @param preload The contents to load, or a null pointer to cancel
+     * @see preloadFinished()
+     */
+    void setPreload(SessionPreloadPtr preload);
+
+signals:
+    /**
+     * Emitted on all processes once they have all finished preloading.
+     * @param id The identifier of the preloaded session
+     */
+    void preloadFinished(unsigned int id);
+
 public slots:
     /**
      * Update a PixelStream with the given frame.
@@ -123,6 +158,21 @@ private:
      */
     void clearStaleFactoryObjects();
 
+    /** Get the existing factory object of a Content, without creating it. */
+    FactoryObjectPtr findFactoryObject(ContentPtr content);
+
+    /** Add an object created in a worker thread to its factory. */
+    FactoryObjectPtr addFactoryObject(ContentPtr content, FactoryObjectPtr object);
+
+    /** Preload the objects of the session, @return true if all are ready. */
+    bool preloadObjects();
+
+    /** Keep the objects of a finished preload from being garbage-collected. */
+    void keepPreloadedObjects();
+
+    /** Check if all processes are ready, or release an expired preload. */
+    void updatePreload(WallToWallChannel& wallChannel);
+
     uint64_t frameIndex_;
 
     Factory<Texture> textureFactory_;
@@ -133,6 +183,17 @@ private:
     Factory<SVG> svgFactory_;
     Factory<Movie> movieFactory_;
     Factory<PixelStream> pixelStreamFactory_;
+    Factory<TiledMovie> tiledMovieFactory_;
+
+    MovieClock movieClock_;
+
+    SessionPreloadPtr preload_;
+    bool preloadReady_;
+    bool preloadFinished_;
+    boost::posix_time::ptime preloadDeadline_;
+
+    typedef std::map< QString, QFuture< ObjectCreator > > PendingObjects;
+    PendingObjects pendingObjects_;
 };
 
 #endif // FACTORIES_H
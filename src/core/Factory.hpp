@@ -75,6 +75,29 @@ public:
         return map_[uri];
     }
 
+    boost::shared_ptr<T> findObject(const QString& uri)
+    {
+        QMutexLocker locker(&mapMutex_);
+
+        typename std::map<QString, boost::shared_ptr<T> >::iterator it = map_.find(uri);
+        return it != map_.end() ? it->second : boost::shared_ptr<T>();
+    }
+
+    // Add an object constructed elsewhere, unless one already exists for uri
+    boost::shared_ptr<T> addObject(const QString& uri, boost::shared_ptr<T> object)
+    {
+        QMutexLocker locker(&mapMutex_);
+
+        if(!map_.count(uri))
+        {
+            newObjectSignal_(*object);
+
+            map_[uri] = object;
+        }
+
+        return map_[uri];
+    }
+
     void removeObject(const QString& uri)
     {
         QMutexLocker locker(&mapMutex_);
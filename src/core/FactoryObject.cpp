@@ -53,6 +53,11 @@ void FactoryObject::setRenderContext(RenderContext* renderContext)
     renderContext_ = renderContext;
 }
 
+bool FactoryObject::preload()
+{
+    return true;
+}
+
 RenderContext* FactoryObject::getRenderContext() const
 {
     return renderContext_;
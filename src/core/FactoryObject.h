@@ -63,6 +63,15 @@ public:
      */
     virtual void render(const QRectF& textCoord) = 0;
 
+    /**
+     * Load the data needed for rendering in the background.
+     *
+     * Called every frame while the object belongs to a session which is being
+     * prepared, from the render thread.
+     * @return true once the object can be rendered without blocking
+     */
+    virtual bool preload();
+
     /**
      * Set the render context.
      * @param renderContext The render context
@@ -44,16 +44,18 @@
 #include "ContentLoader.h"
 #include "ContentFactory.h"
 #include "ContentWindow.h"
-#include "StateSerializationHelper.h"
+#include "SessionPreloader.h"
 #include "PixelStreamWindowManager.h"
 #include "log.h"
 
 #include <QFileInfo>
 
 FileCommandHandler::FileCommandHandler(DisplayGroupPtr displayGroup,
-                                       PixelStreamWindowManager& windowManager)
+                                       PixelStreamWindowManager& windowManager,
+                                       SessionPreloader& sessionPreloader)
     : displayGroup_(displayGroup)
     , pixelStreamWindowManager_(windowManager)
+    , sessionPreloader_(sessionPreloader)
 {
 }
 
@@ -67,9 +69,10 @@ void FileCommandHandler::handle(const deflect::Command& command, const QString&
     const QString& uri = command.getArguments();
     const QString& extension = QFileInfo(uri).suffix().toLower();
 
-    if( extension == "dcx" )
+    if( extension == "dcx" || extension == "dcxb" )
     {
-        StateSerializationHelper(displayGroup_).load(uri);
+        // Switch to the session once the walls have loaded its contents
+        sessionPreloader_.load(uri);
     }
     else if ( ContentFactory::getSupportedExtensions().contains( extension ))
     {
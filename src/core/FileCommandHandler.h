@@ -44,6 +44,8 @@
 
 #include "types.h"
 
+class SessionPreloader;
+
 /**
  * Handle file Commands.
  */
@@ -55,9 +57,11 @@ public:
      * @param displayGroup The target DisplayGroup for the commands.
      * @param windowManager The window manager used to retrive the position of
      *        the senderURI window in handle().
+     * @param sessionPreloader The preloader used to switch to state files.
      */
     FileCommandHandler(DisplayGroupPtr displayGroup,
-                       PixelStreamWindowManager& windowManager);
+                       PixelStreamWindowManager& windowManager,
+                       SessionPreloader& sessionPreloader);
 
     /** Get the type of commands handled by the implementation. */
     deflect::CommandType getType() const override;
@@ -72,6 +76,7 @@ public:
 private:
     DisplayGroupPtr displayGroup_;
     PixelStreamWindowManager& pixelStreamWindowManager_;
+    SessionPreloader& sessionPreloader_;
 };
 
 #endif // FILECOMMANDHANDLER_H
@@ -0,0 +1,139 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "LocalStreamServer.h"
+
+#include "LocalStreamSource.h"
+#include "localstreamer/SharedMemoryRingBuffer.h"
+#include "log.h"
+
+#include <deflect/CommandHandler.h>
+#include <deflect/PixelStreamDispatcher.h>
+
+#include <QCoreApplication>
+#include <QLocalSocket>
+
+#include <stdexcept>
+
+LocalStreamServer::LocalStreamServer( deflect::PixelStreamDispatcher& dispatcher,
+                                      deflect::CommandHandler& handler )
+    : dispatcher_( dispatcher )
+    , handler_( handler )
+{
+    const QString name = QString( "%1-%2" ).arg( LOCALSTREAM_SERVER_PREFIX )
+                                     .arg( QCoreApplication::applicationPid( ));
+
+    // Remove what crashed instances left behind: the socket file of a previous
+    // process with the same pid and the shared memory of orphaned streams
+    QLocalServer::removeServer( name );
+    const int removed =
+        SharedMemoryRingBuffer::removeOrphans( LOCALSTREAM_SERVER_PREFIX );
+    if( removed > 0 )
+        put_flog( LOG_INFO, "Removed %d orphaned shared memory segments",
+                  removed );
+
+    if( !server_.listen( name ))
+        throw std::runtime_error( "LocalStreamServer: could not listen on '" +
+                                  name.toStdString() + "': " +
+                                  server_.errorString().toStdString( ));
+
+    connect( &server_, SIGNAL( newConnection( )),
+             this, SLOT( onNewConnection( )));
+}
+
+LocalStreamServer::~LocalStreamServer()
+{
+    server_.close();
+}
+
+QString LocalStreamServer::getName() const
+{
+    return server_.serverName();
+}
+
+void LocalStreamServer::onPixelStreamerClosed( const QString uri )
+{
+    foreach( LocalStreamSource* source, getSources( uri ))
+        source->close();
+}
+
+void LocalStreamServer::onEventRegistrationReply( const QString uri,
+                                                  const bool success )
+{
+    foreach( LocalStreamSource* source, getSources( uri ))
+        source->sendEventRegistrationReply( success );
+}
+
+void LocalStreamServer::onNewConnection()
+{
+    while( server_.hasPendingConnections( ))
+    {
+        QLocalSocket* socket = server_.nextPendingConnection();
+        LocalStreamSource* source = new LocalStreamSource( socket, this );
+
+        connect( source, SIGNAL( addSource( QString, size_t )),
+                 &dispatcher_, SLOT( addSource( QString, size_t )));
+        connect( source, SIGNAL( receivedSegment( QString, size_t,
+                                                  deflect::PixelStreamSegment )),
+                 &dispatcher_, SLOT( processSegment( QString, size_t,
+                                                     deflect::PixelStreamSegment )));
+        connect( source, SIGNAL( receivedFrameFinished( QString, size_t )),
+                 &dispatcher_, SLOT( processFrameFinished( QString, size_t )));
+        connect( source, SIGNAL( removeSource( QString, size_t )),
+                 &dispatcher_, SLOT( removeSource( QString, size_t )));
+
+        connect( source, SIGNAL( receivedCommand( QString, QString )),
+                 &handler_, SLOT( process( QString, QString )));
+        connect( source, SIGNAL( registerToEvents( QString, bool,
+                                                   deflect::EventReceiver* )),
+                 this, SIGNAL( registerToEvents( QString, bool,
+                                                 deflect::EventReceiver* )));
+    }
+}
+
+QList<LocalStreamSource*>
+LocalStreamServer::getSources( const QString& uri ) const
+{
+    QList<LocalStreamSource*> sources;
+    foreach( LocalStreamSource* source, findChildren<LocalStreamSource*>( ))
+    {
+        if( source->getUri() == uri )
+            sources.append( source );
+    }
+    return sources;
+}
@@ -0,0 +1,117 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef LOCALSTREAMSERVER_H
+#define LOCALSTREAMSERVER_H
+
+#include "localstreamer/LocalStreamProtocol.h"
+
+#include <QLocalServer>
+#include <QObject>
+
+namespace deflect
+{
+class CommandHandler;
+class EventReceiver;
+class PixelStreamDispatcher;
+}
+
+class LocalStreamSource;
+
+/**
+ * Accept the LocalStream connections of the local streamers.
+ *
+ * The sources feed the same PixelStreamDispatcher and CommandHandler as the
+ * deflect::NetworkListener, so the rest of the application does not make any
+ * difference between the two transports.
+ */
+class LocalStreamServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Start listening for local streamers.
+     *
+     * The server is named after the pid of the process, so that several
+     * master applications can run on the same host. The shared memory
+     * segments left behind by the streams of crashed instances are removed.
+     * @param dispatcher The dispatcher for the frames of the streams.
+     * @param handler The handler for the commands of the streams.
+     * @throw std::runtime_error if the server could not be started.
+     */
+    LocalStreamServer( deflect::PixelStreamDispatcher& dispatcher,
+                       deflect::CommandHandler& handler );
+
+    /** Destructor. Closes all connections. */
+    ~LocalStreamServer();
+
+    /** @return The name to pass to the streamers, see LocalStream. */
+    QString getName() const;
+
+public slots:
+    /**
+     * Close the connection of a stream after its window was closed.
+     * @param uri the URI of the streamer
+     */
+    void onPixelStreamerClosed( QString uri );
+
+    /**
+     * Forward the result of an event registration to the stream.
+     * @param uri the URI of the streamer
+     * @param success true if event registration was successful
+     */
+    void onEventRegistrationReply( QString uri, bool success );
+
+signals:
+    /** @see LocalStreamSource::registerToEvents */
+    void registerToEvents( QString uri, bool exclusive,
+                           deflect::EventReceiver* receiver );
+
+private slots:
+    void onNewConnection();
+
+private:
+    QLocalServer server_;
+    deflect::PixelStreamDispatcher& dispatcher_;
+    deflect::CommandHandler& handler_;
+
+    QList<LocalStreamSource*> getSources( const QString& uri ) const;
+};
+
+#endif // LOCALSTREAMSERVER_H
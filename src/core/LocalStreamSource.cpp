@@ -0,0 +1,203 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "LocalStreamSource.h"
+
+#include "localstreamer/LocalStreamChannel.h"
+#include "localstreamer/SharedMemoryRingBuffer.h"
+#include "log.h"
+
+#include <QDataStream>
+#include <QLocalSocket>
+
+LocalStreamSource::LocalStreamSource( QLocalSocket* socket, QObject* parent_ )
+    : channel_( 0 )
+    // Unique among the sources of the NetworkListener, which use their
+    // socket descriptors as well
+    , sourceIndex_( socket->socketDescriptor( ))
+{
+    setParent( parent_ );
+
+    channel_ = new LocalStreamChannel( socket, this );
+    connect( channel_, SIGNAL( messageReceived( int, QByteArray )),
+             this, SLOT( processMessage( int, QByteArray )));
+    connect( channel_, SIGNAL( disconnected( )),
+             this, SLOT( onDisconnected( )), Qt::QueuedConnection );
+}
+
+LocalStreamSource::~LocalStreamSource()
+{
+}
+
+const QString& LocalStreamSource::getUri() const
+{
+    return uri_;
+}
+
+size_t LocalStreamSource::getSourceIndex() const
+{
+    return sourceIndex_;
+}
+
+void LocalStreamSource::sendEventRegistrationReply( const bool success )
+{
+    QByteArray payload;
+    QDataStream stream( &payload, QIODevice::WriteOnly );
+    stream << success;
+    channel_->send( MESSAGE_EVENT_REGISTRATION_REPLY, payload );
+}
+
+void LocalStreamSource::close()
+{
+    channel_->close();
+}
+
+void LocalStreamSource::processEvent( deflect::Event event_ )
+{
+    // Both processes run on the same host, the event can be copied as is
+    const QByteArray payload( reinterpret_cast<const char*>( &event_ ),
+                              sizeof( deflect::Event ));
+    channel_->send( MESSAGE_EVENT, payload );
+}
+
+void LocalStreamSource::processMessage( const int type, QByteArray payload )
+{
+    QDataStream stream( payload );
+    switch( type )
+    {
+    case MESSAGE_OPEN:
+        if( !uri_.isEmpty( ))
+            break;
+        stream >> uri_;
+        emit addSource( uri_, sourceIndex_ );
+        break;
+    case MESSAGE_BUFFER:
+    {
+        QString key;
+        quint32 slotSize = 0, slotCount = 0;
+        stream >> key >> slotSize >> slotCount;
+        buffer_.reset( new SharedMemoryRingBuffer( key ));
+        if( !buffer_->attach( slotSize, slotCount ))
+        {
+            put_flog( LOG_WARN, "Could not attach to the shared memory of "
+                                "stream: '%s'", uri_.toStdString().c_str( ));
+            buffer_.reset();
+            close();
+        }
+        break;
+    }
+    case MESSAGE_FRAME:
+        processFrame( stream );
+        break;
+    case MESSAGE_REGISTER_EVENTS:
+    {
+        bool exclusive = false;
+        stream >> exclusive;
+        emit registerToEvents( uri_, exclusive, this );
+        break;
+    }
+    case MESSAGE_COMMAND:
+    {
+        QString command;
+        stream >> command;
+        emit receivedCommand( command, uri_ );
+        break;
+    }
+    default:
+        put_flog( LOG_WARN, "Unexpected message type: %d", type );
+        break;
+    }
+}
+
+void LocalStreamSource::processFrame( QDataStream& stream )
+{
+    quint32 slot = 0, segmentCount = 0;
+    stream >> slot >> segmentCount;
+
+    const uchar* data = buffer_ ? buffer_->getSlot( slot ) : 0;
+    if( uri_.isEmpty() || !data )
+    {
+        put_flog( LOG_WARN, "Invalid frame for stream: '%s'",
+                  uri_.toStdString().c_str( ));
+        close();
+        return;
+    }
+
+    const quint32 slotSize = buffer_->getSlotSize();
+    for( quint32 i = 0; i < segmentCount; ++i )
+    {
+        qint32 x = 0, y = 0, width = 0, height = 0;
+        quint32 offset = 0, size = 0;
+        bool compressed = false;
+        stream >> x >> y >> width >> height >> offset >> size >> compressed;
+
+        const quint32 rawSize = width * height * LOCALSTREAM_BYTES_PER_PIXEL;
+        if( x < 0 || y < 0 || width <= 0 || height <= 0 ||
+            ( !compressed && size != rawSize ) ||
+            offset > slotSize || size > slotSize - offset )
+        {
+            put_flog( LOG_WARN, "Invalid segment for stream: '%s'",
+                      uri_.toStdString().c_str( ));
+            continue;
+        }
+
+        // The segments outlive the slot, which is reused by the next frames
+        deflect::PixelStreamSegment segment;
+        segment.parameters.x = x;
+        segment.parameters.y = y;
+        segment.parameters.width = width;
+        segment.parameters.height = height;
+        segment.parameters.compressed = compressed;
+        segment.imageData = QByteArray( reinterpret_cast<const char*>( data + offset ),
+                                        size );
+        emit receivedSegment( uri_, sourceIndex_, segment );
+    }
+    emit receivedFrameFinished( uri_, sourceIndex_ );
+
+    QByteArray payload;
+    QDataStream reply( &payload, QIODevice::WriteOnly );
+    reply << slot;
+    channel_->send( MESSAGE_RELEASE, payload );
+}
+
+void LocalStreamSource::onDisconnected()
+{
+    if( !uri_.isEmpty( ))
+        emit removeSource( uri_, sourceIndex_ );
+    deleteLater();
+}
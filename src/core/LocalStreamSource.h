@@ -0,0 +1,125 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef LOCALSTREAMSOURCE_H
+#define LOCALSTREAMSOURCE_H
+
+#include <deflect/Event.h>
+#include <deflect/EventReceiver.h>
+#include <deflect/PixelStreamSegment.h>
+
+#include <QByteArray>
+#include <QString>
+
+#include <boost/scoped_ptr.hpp>
+
+class LocalStreamChannel;
+class QDataStream;
+class QLocalSocket;
+class SharedMemoryRingBuffer;
+
+/**
+ * The master side of a LocalStream.
+ *
+ * Reads the frames of a local streamer from shared memory and hands them
+ * over as raw or JPEG segments, as chosen by the streamer, in the same way as
+ * the sources connected to the deflect::NetworkListener. Events of the stream's window are forwarded
+ * on the control socket.
+ */
+class LocalStreamSource : public deflect::EventReceiver
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Constructor.
+     * @param socket The connection of the streamer. The source takes ownership.
+     * @param parent The parent QObject.
+     */
+    LocalStreamSource( QLocalSocket* socket, QObject* parent = 0 );
+
+    /** Destructor. */
+    ~LocalStreamSource();
+
+    /** Get the uri of the stream, empty until the streamer has opened it. */
+    const QString& getUri() const;
+
+    /** Get the index of this source in its stream. */
+    size_t getSourceIndex() const;
+
+    /** Send the result of the event registration to the streamer. */
+    void sendEventRegistrationReply( bool success );
+
+    /** Close the connection, which terminates the streamer. */
+    void close();
+
+public slots:
+    /** Forward an event of the stream's window to the streamer. */
+    void processEvent( deflect::Event event ) override;
+
+signals:
+    /** @name Connect to the deflect::PixelStreamDispatcher */
+    //@{
+    void addSource( QString uri, size_t sourceIndex );
+    void receivedSegment( QString uri, size_t sourceIndex,
+                          deflect::PixelStreamSegment segment );
+    void receivedFrameFinished( QString uri, size_t sourceIndex );
+    void removeSource( QString uri, size_t sourceIndex );
+    //@}
+
+    /** Emitted when the streamer requests to receive events. */
+    void registerToEvents( QString uri, bool exclusive,
+                           deflect::EventReceiver* receiver );
+
+    /** Emitted when the streamer sends a command. */
+    void receivedCommand( QString command, QString senderUri );
+
+private slots:
+    void processMessage( int type, QByteArray payload );
+    void onDisconnected();
+
+private:
+    LocalStreamChannel* channel_;
+    boost::scoped_ptr<SharedMemoryRingBuffer> buffer_;
+    const size_t sourceIndex_;
+    QString uri_;
+
+    void processFrame( QDataStream& stream );
+};
+
+#endif // LOCALSTREAMSOURCE_H
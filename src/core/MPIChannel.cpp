@@ -104,6 +104,14 @@ int MPIChannel::globalSum(const int localValue) const
     return globalValue;
 }
 
+std::vector<int64_t> MPIChannel::globalMin(const std::vector<int64_t>& localValues) const
+{
+    std::vector<int64_t> globalValues(localValues.size());
+    MPI_CHECK(MPI_Allreduce((void *)localValues.data(), (void *)globalValues.data(),
+                            localValues.size(), MPI_LONG_LONG_INT, MPI_MIN, mpiComm_));
+    return globalValues;
+}
+
 bool MPIChannel::isMessageAvailable(const int src)
 {
     int flag;
@@ -115,6 +115,13 @@ public:
      */
     int globalSum(const int localValue) const;
 
+    /**
+     * Get the minimum of each of the given local values across all processes.
+     * @param localValues The values to reduce, same count on all processes
+     * @return the minimum of each value, in the same order as localValues
+     */
+    std::vector<int64_t> globalMin(const std::vector<int64_t>& localValues) const;
+
     /**
      * Send data to a single process
      * @param type The type of data to send
@@ -53,7 +53,8 @@ enum MPIMessageType
     MPI_MESSAGE_TYPE_OPTIONS,
     MPI_MESSAGE_TYPE_MARKERS,
     MPI_MESSAGE_TYPE_REQUEST_FRAME,
-    MPI_MESSAGE_TYPE_TIMESTAMP
+    MPI_MESSAGE_TYPE_PRELOAD,
+    MPI_MESSAGE_TYPE_PRELOAD_FINISHED
 };
 
 /** Fixed-size message header. */
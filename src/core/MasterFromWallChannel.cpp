@@ -68,6 +68,13 @@ void MasterFromWallChannel::processMessages()
             emit receivedRequestFrame(uri);
             break;
         }
+        case MPI_MESSAGE_TYPE_PRELOAD_FINISHED:
+        {
+            unsigned int id = 0;
+            buffer_.deserialize(id);
+            emit receivedPreloadFinished(id);
+            break;
+        }
         case MPI_MESSAGE_TYPE_QUIT:
             processMessages_ = false;
             break;
@@ -70,6 +70,12 @@ signals:
      */
     void receivedRequestFrame(const QString uri);
 
+    /**
+     * Emitted when all the wall processes have preloaded a session
+     * @param id The identifier of the session
+     */
+    void receivedPreloadFinished(unsigned int id);
+
 private:
     MPIChannelPtr mpiChannel_;
     SerializeBuffer buffer_;
@@ -44,6 +44,7 @@
 #include "ContentWindow.h"
 #include "Options.h"
 #include "Markers.h"
+#include "SessionPreload.h"
 #include <deflect/PixelStreamFrame.h>
 
 MasterToWallChannel::MasterToWallChannel( MPIChannelPtr mpiChannel )
@@ -86,6 +87,11 @@ void MasterToWallChannel::sendAsync( MarkersPtr markers )
     broadcastAsync( markers, MPI_MESSAGE_TYPE_MARKERS );
 }
 
+void MasterToWallChannel::sendAsync( SessionPreloadPtr preload )
+{
+    broadcastAsync( preload, MPI_MESSAGE_TYPE_PRELOAD );
+}
+
 void MasterToWallChannel::send( deflect::PixelStreamFramePtr frame )
 {
     assert( !frame->segments.empty() && "received an empty frame" );
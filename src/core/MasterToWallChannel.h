@@ -90,6 +90,12 @@ public slots:
      */
     void sendAsync( MarkersPtr markers );
 
+    /**
+     * Send the contents of an upcoming session to the wall processes.
+     * @param preload The contents to preload
+     */
+    void sendAsync( SessionPreloadPtr preload );
+
     /**
      * Send pixel stream frame to the wall processes.
      * @param frame The frame to send
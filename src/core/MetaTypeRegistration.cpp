@@ -55,6 +55,7 @@ struct MetaTypeRegistration
         qRegisterMetaType< OptionsPtr >( "OptionsPtr" );
         qRegisterMetaType< MarkersPtr >( "MarkersPtr" );
         qRegisterMetaType< DisplayGroupPtr >( "DisplayGroupPtr" );
+        qRegisterMetaType< SessionPreloadPtr >( "SessionPreloadPtr" );
         qRegisterMetaType< ContentWindowPtr >( "ContentWindowPtr" );
         qRegisterMetaType< ContentWindow::WindowState >( "ContentWindow::WindowState" );
         qRegisterMetaType< ContentWindow::WindowBorder >( "ContentWindow::WindowBorder" );
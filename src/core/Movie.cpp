@@ -44,10 +44,12 @@
 Movie::Movie(QString uri)
     : ffmpegMovie_(new FFMPEGMovie(uri))
     , uri_(uri)
-    , paused_(false)
     , isVisible_(true)
     , skippedLastFrame_(false)
-{}
+    , preloaded_(false)
+{
+    setScheduler(PresentationSchedulerPtr(new PresentationScheduler));
+}
 
 Movie::~Movie()
 {
@@ -56,39 +58,26 @@ Movie::~Movie()
 
 void Movie::preRenderUpdate(WallToWallChannel& wallToWallChannel)
 {
-    if(paused_)
-        return;
+    scheduler_->update(wallToWallChannel.getTime());
 
-    elapsedTimer_.setCurrentTime(wallToWallChannel.getTime());
-    timestamp_ += elapsedTimer_.getElapsedTime();
+    if(scheduler_->isPaused())
+        return;
 
     skippedLastFrame_ = !isVisible_;
-    ffmpegMovie_->update(timestamp_, skippedLastFrame_);
-
-    // Get the current timestamp back from the FFMPEG movie.
-    timestamp_ = ffmpegMovie_->getTimestamp();
+    ffmpegMovie_->update(scheduler_->getPresentationTime(), skippedLastFrame_);
 
     if (ffmpegMovie_->isNewFrameAvailable())
         texture_.update(ffmpegMovie_->getData(), GL_RGBA);
 }
 
-void Movie::synchronizeTimestamp(WallToWallChannel& wallToWallChannel)
+bool Movie::hasSkippedLastFrame() const
 {
-    // Elect a leader among processes which have decoded a frame
-    const int leader = wallToWallChannel.electLeader(!skippedLastFrame_);
-
-    if (leader < 0)
-        return;
-
-    if (leader == wallToWallChannel.getRank())
-        wallToWallChannel.broadcast(timestamp_);
-    else
-        timestamp_ = wallToWallChannel.receiveTimestampBroadcast(leader);
+    return skippedLastFrame_;
 }
 
-void Movie::postRenderUpdate(WallToWallChannel& wallToWallChannel)
+PresentationSchedulerPtr Movie::getScheduler() const
 {
-    synchronizeTimestamp(wallToWallChannel);
+    return scheduler_;
 }
 
 bool Movie::generateTexture()
@@ -114,6 +103,24 @@ void Movie::render(const QRectF& texCoords)
     glPopAttrib();
 }
 
+bool Movie::preload()
+{
+    if(preloaded_ || !ffmpegMovie_->isValid())
+        return true;
+
+    // Retried next frame, the preload expires if it keeps failing
+    if(!texture_.isValid() && !generateTexture())
+        return false;
+
+    // The scheduler is not running yet, this is the starting position
+    ffmpegMovie_->update(scheduler_->getPosition(), false);
+    if (ffmpegMovie_->isNewFrameAvailable())
+        texture_.update(ffmpegMovie_->getData(), GL_RGBA);
+
+    preloaded_ = true;
+    return true;
+}
+
 void Movie::setVisible(const bool isVisible)
 {
     isVisible_ = isVisible;
@@ -121,10 +128,22 @@ void Movie::setVisible(const bool isVisible)
 
 void Movie::setPause(const bool pause)
 {
-    paused_ = pause;
+    scheduler_->setPaused(pause);
 }
 
 void Movie::setLoop(const bool loop)
 {
-    ffmpegMovie_->setLoop(loop);
+    scheduler_->setLoop(loop);
+}
+
+void Movie::setScheduler(PresentationSchedulerPtr scheduler)
+{
+    scheduler_ = scheduler;
+
+    if(ffmpegMovie_->isValid())
+    {
+        // AV_TIME_BASE is the number of microseconds per second
+        const double duration = ffmpegMovie_->getDuration();
+        scheduler_->setDuration(boost::posix_time::microseconds(duration * AV_TIME_BASE));
+    }
 }
@@ -42,7 +42,7 @@
 #include "FactoryObject.h"
 #include "GLTexture2D.h"
 #include "GLQuad.h"
-#include "ElapsedTimer.h"
+#include "PresentationScheduler.h"
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
@@ -57,13 +57,27 @@ public:
 
     void render(const QRectF& texCoords) override;
 
+    /** Decode and upload the frame at the current position. */
+    bool preload() override;
+
     void setVisible(const bool isVisible);
 
     void setPause(const bool pause);
     void setLoop(const bool loop);
 
+    /**
+     * Share a scheduler with other movies to frame-lock them.
+     * All the movies of a group are expected to have the same duration.
+     */
+    void setScheduler(PresentationSchedulerPtr scheduler);
+
     void preRenderUpdate(WallToWallChannel& wallToWallChannel);
-    void postRenderUpdate(WallToWallChannel& wallToWallChannel);
+
+    /** Did this process skip decoding the last frame (movie not visible). */
+    bool hasSkippedLastFrame() const;
+
+    /** Get the scheduler which sets the playback position. */
+    PresentationSchedulerPtr getScheduler() const;
 
 private:
     FFMPEGMovie* ffmpegMovie_;
@@ -71,16 +85,13 @@ private:
     QString uri_;
     GLTexture2D texture_;
     GLQuad quad_;
-    ElapsedTimer elapsedTimer_;
-
-    bool paused_;
+    PresentationSchedulerPtr scheduler_;
 
     bool isVisible_;
     bool skippedLastFrame_;
-    boost::posix_time::time_duration timestamp_;
+    bool preloaded_;
 
     bool generateTexture();
-    void synchronizeTimestamp(WallToWallChannel& wallToWallChannel);
 };
 
 #endif
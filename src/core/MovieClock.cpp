@@ -0,0 +1,102 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "MovieClock.h"
+
+#include "Movie.h"
+#include "WallToWallChannel.h"
+
+#include <limits>
+
+namespace
+{
+// Value reported by processes which did not decode the movie this frame
+const int64_t NO_TIMESTAMP = std::numeric_limits<int64_t>::max();
+}
+
+MovieClock::MovieClock()
+{
+}
+
+void MovieClock::add(MoviePtr movie)
+{
+    add(movie->getScheduler(), movie->hasSkippedLastFrame());
+}
+
+void MovieClock::add(PresentationSchedulerPtr scheduler, const bool skippedLastFrame)
+{
+    for(std::vector<Entry>::iterator it = entries_.begin(); it != entries_.end(); ++it)
+    {
+        if(it->scheduler == scheduler)
+        {
+            it->skippedLastFrame = it->skippedLastFrame && skippedLastFrame;
+            return;
+        }
+    }
+
+    const Entry entry = { scheduler, skippedLastFrame };
+    entries_.push_back(entry);
+}
+
+void MovieClock::synchronize(WallToWallChannel& wallToWallChannel)
+{
+    if(entries_.empty())
+        return;
+
+    std::vector<int64_t> timestamps;
+    timestamps.reserve(entries_.size());
+
+    for(std::vector<Entry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it)
+    {
+        timestamps.push_back(it->skippedLastFrame ? NO_TIMESTAMP :
+                             it->scheduler->getPosition().total_microseconds());
+    }
+
+    // The slowest process which decoded a movie sets the reference timestamp;
+    // processes that are ahead simply hold their current frame until it
+    // catches up, instead of the late ones having to skip frames.
+    const std::vector<int64_t> reference = wallToWallChannel.globalMin(timestamps);
+
+    for(size_t i = 0; i < entries_.size(); ++i)
+    {
+        if(reference[i] != NO_TIMESTAMP)
+            entries_[i].scheduler->setPosition(boost::posix_time::microseconds(reference[i]));
+    }
+
+    entries_.clear();
+}
@@ -0,0 +1,95 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef MOVIECLOCK_H
+#define MOVIECLOCK_H
+
+#include "types.h"
+#include "PresentationScheduler.h"
+
+class WallToWallChannel;
+
+/**
+ * Keep the playback position of movies synchronized across wall processes.
+ *
+ * All movies advance using the frame clock distributed by
+ * WallToWallChannel::synchronizeClock(), so their timestamps only drift apart
+ * when some processes decode slower than others. The corrections for all the
+ * movies rendered during a frame are exchanged in a single collective.
+ */
+class MovieClock
+{
+public:
+    /** Constructor */
+    MovieClock();
+
+    /**
+     * Register a movie to be synchronized at the end of the current frame.
+     * Adding the same movie more than once has no effect.
+     * @param movie The movie to synchronize
+     */
+    void add(MoviePtr movie);
+
+    /**
+     * Register the scheduler of a movie or group of frame-locked movies.
+     * Adding the same scheduler more than once has no effect.
+     * @param scheduler The scheduler to synchronize
+     * @param skippedLastFrame true if this process did not decode any frame
+     *        using this scheduler (the movie is not visible here)
+     */
+    void add(PresentationSchedulerPtr scheduler, const bool skippedLastFrame);
+
+    /**
+     * Synchronize the timestamps of all registered movies and clear the list.
+     *
+     * Must be called by all wall processes after rendering, with movies
+     * registered in the same order on all processes.
+     * @param wallToWallChannel The channel used for the collective operation
+     */
+    void synchronize(WallToWallChannel& wallToWallChannel);
+
+private:
+    struct Entry
+    {
+        PresentationSchedulerPtr scheduler;
+        bool skippedLastFrame;
+    };
+    std::vector<Entry> entries_;
+};
+
+#endif // MOVIECLOCK_H
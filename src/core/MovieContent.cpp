@@ -40,11 +40,13 @@
 
 #include "ContentWindow.h"
 #include "Factories.h"
-#include "FFMPEGMovie.h"
 #include "Movie.h"
+#include "MovieMetadataCache.h"
 #include "RenderContext.h"
 #include "WallToWallChannel.h"
 
+#include <QDataStream>
+
 #include <boost/serialization/export.hpp>
 BOOST_CLASS_EXPORT_GUID( MovieContent, "MovieContent" )
 
@@ -73,15 +75,11 @@ CONTENT_TYPE MovieContent::getType()
 
 bool MovieContent::readMetadata()
 {
-    QFileInfo file( getURI( ));
-    if( !file.exists() || !file.isReadable( ))
-        return false;
-
-    const FFMPEGMovie movie( getURI( ));
-    if( !movie.isValid( ))
+    MovieMetadata metadata;
+    if( !MovieMetadataCache::get( getURI(), metadata ))
         return false;
 
-    size_ = QSize( movie.getWidth(), movie.getHeight( ));
+    size_ = metadata.size;
     return true;
 }
 
@@ -117,15 +115,15 @@ void MovieContent::preRenderUpdate(Factories& factories, ContentWindowPtr window
     movie->preRenderUpdate( wallToWallChannel );
 }
 
-void MovieContent::postRenderUpdate(Factories& factories, ContentWindowPtr window, WallToWallChannel& wallToWallChannel)
+void MovieContent::postRenderUpdate(Factories& factories, ContentWindowPtr window, WallToWallChannel&)
 {
     // Stop decoding when the window is moving to avoid saccades when reaching a new GLWindow
     // The decoding resumes when the movement is finished
     if( window && ( window->isMoving() || window->isResizing( )))
         return;
 
-    boost::shared_ptr< Movie > movie = factories.getMovieFactory().getObject( uri_ );
-    movie->postRenderUpdate( wallToWallChannel );
+    MoviePtr movie = factories.getMovieFactory().getObject( uri_ );
+    factories.getMovieClock().add( movie );
 }
 
 void MovieContent::play()
@@ -148,3 +146,15 @@ void MovieContent::createActions()
     connect( playPauseAction, SIGNAL( unchecked( )), this, SLOT( play( )));
     actions_.add( playPauseAction );
 }
+
+void MovieContent::writeState( QDataStream& out ) const
+{
+    out << (qint32)controlState_;
+}
+
+void MovieContent::readState( QDataStream& in )
+{
+    qint32 controlState = 0;
+    in >> controlState;
+    controlState_ = (ControlState)controlState;
+}
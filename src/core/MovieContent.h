@@ -68,7 +68,10 @@ public:
     static const QStringList& getSupportedExtensions();
 
     void preRenderUpdate(Factories&, ContentWindowPtr window, WallToWallChannel& wallToWallChannel) override;
-    void postRenderUpdate(Factories& factories, ContentWindowPtr window, WallToWallChannel& wallToWallChannel) override;
+    void postRenderUpdate(Factories& factories, ContentWindowPtr window, WallToWallChannel&) override;
+
+    void writeState( QDataStream& out ) const override;
+    void readState( QDataStream& in ) override;
 
 private slots:
     void play();
@@ -0,0 +1,259 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "MovieMetadataCache.h"
+
+#include "CacheDirectory.h"
+#include "FFMPEGMovie.h"
+#include "log.h"
+
+#include <QCache>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QWaitCondition>
+
+#include <cstdio>
+
+#define PREVIEW_RELATIVE_POSITION  0.5
+
+namespace
+{
+const QString CACHE_SUBDIRECTORY( "/displaycluster/movies" );
+const QString CACHE_FILE_SUFFIX( ".dcmeta" );
+const quint32 CACHE_MAGIC = 0x44434d4d; // "DCMM"
+const quint32 CACHE_VERSION = 2;
+
+// Large enough for the dock and session previews, small enough to keep
+// a few hundred entries in memory.
+const QSize THUMBNAIL_SIZE( 512, 512 );
+const int MAX_ENTRIES_IN_MEMORY = 200;
+
+// Entries are about 100 kB with their thumbnail
+const qint64 MAX_CACHE_SIZE_BYTES = 200 * 1024 * 1024;
+const int MAX_CACHE_AGE_DAYS = 60;
+
+QMutex cacheMutex;
+QCache<QString, MovieMetadata> memoryCache( MAX_ENTRIES_IN_MEMORY );
+bool diskCachePruned = false;
+QSet<QString> probesInProgress;
+QWaitCondition probeFinished;
+
+QString getKey( const QFileInfo& file )
+{
+    QCryptographicHash hash( QCryptographicHash::Md5 );
+    hash.addData( file.absoluteFilePath().toUtf8( ));
+    hash.addData( QByteArray::number( file.size( )));
+    hash.addData( QByteArray::number( file.lastModified().toMSecsSinceEpoch( )));
+    return QString( hash.result().toHex( ));
+}
+
+QString getCacheFilename( const QString& key )
+{
+    return MovieMetadataCache::getCacheDirectory() + "/" + key + CACHE_FILE_SUFFIX;
+}
+}
+
+bool MovieMetadataCache::get( const QString& uri, MovieMetadata& metadata )
+{
+    if( lookup( uri, metadata ))
+        return true;
+
+    const QFileInfo file( uri );
+    if( !file.exists() || !file.isReadable( ))
+        return false;
+
+    const QString key = getKey( file );
+
+    // Threads asking for the same movie, like the workers generating the
+    // thumbnails of the dock, wait for a single probe instead of opening it
+    // concurrently. Different movies are probed in parallel, FFMPEGMovie
+    // serializes the non-reentrant parts of FFMPEG.
+    {
+        QMutexLocker locker( &cacheMutex );
+        while( probesInProgress.contains( key ))
+            probeFinished.wait( &cacheMutex );
+        probesInProgress.insert( key );
+    }
+
+    MovieMetadata result;
+    const bool found = lookup( uri, result );
+    const bool probed = !found && probe( uri, result );
+    if( probed )
+        writeToDisk( key, result );
+
+    bool pruneDiskCache = false;
+    {
+        QMutexLocker locker( &cacheMutex );
+        if( probed )
+        {
+            memoryCache.insert( key, new MovieMetadata( result ));
+            pruneDiskCache = !diskCachePruned;
+            diskCachePruned = true;
+        }
+        probesInProgress.remove( key );
+        probeFinished.wakeAll();
+    }
+    // Once per process, on the first write, which is when the cache grows
+    if( pruneDiskCache )
+        CacheDirectory::prune( getCacheDirectory(), "*" + CACHE_FILE_SUFFIX + "*",
+                               MAX_CACHE_SIZE_BYTES, MAX_CACHE_AGE_DAYS );
+
+    if( !found && !probed )
+        return false;
+
+    metadata = result;
+    return true;
+}
+
+bool MovieMetadataCache::lookup( const QString& uri, MovieMetadata& metadata )
+{
+    const QFileInfo file( uri );
+    if( !file.exists() || !file.isReadable( ))
+        return false;
+
+    const QString key = getKey( file );
+
+    {
+        QMutexLocker locker( &cacheMutex );
+        if( const MovieMetadata* cached = memoryCache.object( key ))
+        {
+            metadata = *cached;
+            return true;
+        }
+    }
+
+    MovieMetadata result;
+    if( !readFromDisk( key, result ))
+        return false;
+
+    {
+        QMutexLocker locker( &cacheMutex );
+        memoryCache.insert( key, new MovieMetadata( result ));
+    }
+
+    metadata = result;
+    return true;
+}
+
+QString MovieMetadataCache::getCacheDirectory()
+{
+    return CacheDirectory::getUserCacheHome() + CACHE_SUBDIRECTORY;
+}
+
+bool MovieMetadataCache::probe( const QString& uri, MovieMetadata& metadata )
+{
+    // Probes run off the GUI thread and once for all the processes, so this
+    // is where movies without an index in their container get scanned
+    FFMPEGMovie movie( uri, true );
+    if( !movie.isValid( ))
+        return false;
+
+    metadata.size = QSize( movie.getWidth(), movie.getHeight( ));
+    metadata.duration = movie.getDuration();
+    metadata.frameRate = movie.getFrameRate();
+    const std::vector<int64_t>& keyframes = movie.getKeyframes();
+    metadata.keyframes.reserve( keyframes.size( ));
+    for( size_t i = 0; i < keyframes.size(); ++i )
+        metadata.keyframes.append( keyframes[i] );
+
+    if( movie.jumpTo( PREVIEW_RELATIVE_POSITION * metadata.duration ))
+    {
+        const QImage frame( (const uchar*)movie.getData(), movie.getWidth(),
+                            movie.getHeight(), QImage::Format_ARGB32 );
+        metadata.thumbnail = frame.scaled( THUMBNAIL_SIZE, Qt::KeepAspectRatio,
+                                           Qt::SmoothTransformation ).rgbSwapped();
+    }
+    return true;
+}
+
+bool MovieMetadataCache::readFromDisk( const QString& key, MovieMetadata& metadata )
+{
+    QFile file( getCacheFilename( key ));
+    if( !file.open( QIODevice::ReadOnly ))
+        return false;
+
+    QDataStream in( &file );
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if( magic != CACHE_MAGIC || version != CACHE_VERSION )
+        return false;
+
+    in >> metadata.size >> metadata.duration >> metadata.frameRate
+       >> metadata.keyframes >> metadata.thumbnail;
+
+    return in.status() == QDataStream::Ok && metadata.size.isValid();
+}
+
+void MovieMetadataCache::writeToDisk( const QString& key, const MovieMetadata& metadata )
+{
+    if( !QDir().mkpath( getCacheDirectory( )))
+    {
+        put_flog( LOG_DEBUG, "could not create cache directory: %s",
+                  getCacheDirectory().toLocal8Bit().constData( ));
+        return;
+    }
+
+    // Several processes may probe the same movie concurrently; write to a
+    // private file first and atomically move it in place.
+    const QString filename = getCacheFilename( key );
+    QFile file( filename + "." +
+                QString::number( QCoreApplication::applicationPid( )));
+    if( !file.open( QIODevice::WriteOnly ))
+        return;
+
+    QDataStream out( &file );
+    out << CACHE_MAGIC << CACHE_VERSION;
+    out << metadata.size << metadata.duration << metadata.frameRate
+        << metadata.keyframes << metadata.thumbnail;
+    file.close();
+
+    if( out.status() != QDataStream::Ok ||
+        std::rename( file.fileName().toLocal8Bit().constData(),
+                     filename.toLocal8Bit().constData( )) != 0 )
+    {
+        file.remove();
+    }
+}
@@ -0,0 +1,116 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef MOVIEMETADATACACHE_H
+#define MOVIEMETADATACACHE_H
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+/**
+ * Information about a movie file which is expensive to obtain.
+ */
+struct MovieMetadata
+{
+    MovieMetadata()
+        : duration( 0.0 )
+        , frameRate( 0.0 )
+    {}
+
+    /** Frame dimensions in pixels. */
+    QSize size;
+
+    /** Duration in seconds, 0 if unknown. */
+    double duration;
+
+    /** Frames per second. */
+    double frameRate;
+
+    /** Sorted keyframe timestamps, in the time base of the video stream. */
+    QVector<qint64> keyframes;
+
+    /** A frame from the middle of the movie, downscaled. */
+    QImage thumbnail;
+};
+
+/**
+ * Cache the metadata of movie files to avoid reopening them.
+ *
+ * Entries are keyed by absolute path, size and modification time of the file,
+ * kept in memory and persisted on disk so that they are shared between the
+ * master application, the session loader and the dock local streamer.
+ * All methods are thread-safe, and a movie requested by several threads at
+ * once is only probed by one of them.
+ */
+class MovieMetadataCache
+{
+public:
+    /**
+     * Get the metadata of a movie, opening the file only on a cache miss.
+     * @param uri The movie file
+     * @param metadata The output metadata, only modified on success
+     * @return false if the file does not exist or is not a valid movie
+     */
+    static bool get( const QString& uri, MovieMetadata& metadata );
+
+    /**
+     * Get the metadata of a movie only if it is already cached.
+     *
+     * Used by the wall processes to reuse the keyframe index built by the
+     * master instead of scanning the same file again.
+     * @param uri The movie file
+     * @param metadata The output metadata, only modified on success
+     * @return false on a cache miss
+     */
+    static bool lookup( const QString& uri, MovieMetadata& metadata );
+
+    /**
+     * @return The directory where the metadata is persisted,
+     * $XDG_CACHE_HOME/displaycluster/movies or ~/.cache/...
+     */
+    static QString getCacheDirectory();
+
+private:
+    static bool probe( const QString& uri, MovieMetadata& metadata );
+    static bool readFromDisk( const QString& key, MovieMetadata& metadata );
+    static void writeToDisk( const QString& key, const MovieMetadata& metadata );
+};
+
+#endif // MOVIEMETADATACACHE_H
@@ -39,82 +39,79 @@
 
 #include "PDF.h"
 
-// detect Qt version
-#if QT_VERSION >= 0x050000
-#define POPPLER_QT5
-#include <poppler-qt5.h>
-#elif QT_VERSION >= 0x040000
-#define POPPLER_QT4
-#include <poppler-qt4.h>
-#else
-#error PopplerPixelStreamer needs Qt4 or Qt5
-#endif
-
-#include "GLWindow.h"
+#include "TiledTexture.h"
 #include "log.h"
 
+#include <QThread>
+
+#include <boost/bind.hpp>
+
 #define INVALID_PAGE_NUMBER -1
 
-PDF::PDF(const QString& uri)
-    : uri_(uri)
-    , pdfDoc_(0)
-    , pdfPage_(0)
-    , pageNumber_(INVALID_PAGE_NUMBER)
+#define POINTS_PER_INCH   72.0
+#define MAX_RESOLUTION    1200.0 // dpi
+
+// Tiles rasterized concurrently, each one with its own Poppler document
+#define MAX_TILE_RENDERERS 4
+
+namespace
 {
-    openDocument(uri_);
+PyramidTiling makeTiling(const QSizeF& pageSize)
+{
+    return PyramidTiling(pageSize, MAX_RESOLUTION / POINTS_PER_INCH);
 }
 
-PDF::~PDF()
+// Called from the TileRenderer worker threads, PDFDocument is thread-safe
+QImage renderTile(PDFDocumentPtr document, const TileIndex& index)
 {
-    closeDocument();
+    const PyramidTiling tiling = makeTiling(document->getPageSize(index.page));
+    const QRect tile = tiling.getTileRect(index);
+    if (tile.isEmpty())
+        return QImage();
+
+    const double resolution = POINTS_PER_INCH * tiling.getScale(index.level);
+    const QImage image = document->renderPage(index.page, resolution, tile);
+    if (image.isNull())
+        put_flog(LOG_DEBUG, "Could not render tile (%d, %d) of page %d",
+                 index.x, index.y, index.page);
+    return image;
+}
 }
 
-bool PDF::isValid() const
+PDF::PDF(const QString& uri)
+    : PDF(uri, PDFDocument::get(uri))
 {
-    return (pdfDoc_ != 0);
 }
 
-void PDF::closePage()
+PDF::PDF(const QString& uri, PDFDocumentPtr document)
+    : uri_(uri)
+    , document_(document)
+    , pageNumber_(INVALID_PAGE_NUMBER)
 {
-    if (pdfPage_)
+    if (document_)
     {
-        delete pdfPage_;
-        pdfPage_ = 0;
-        pageNumber_ = INVALID_PAGE_NUMBER;
-        textureRect_ = QRect();
+        const int renderers = qBound(1, QThread::idealThreadCount(),
+                                     MAX_TILE_RENDERERS);
+        tiledTexture_.reset(new TiledTexture(boost::bind(&renderTile,
+                                                         document_, _1),
+                                             renderers));
+        setPage(0);
     }
 }
 
-void PDF::closeDocument()
+PDF::~PDF()
 {
-    if (pdfDoc_)
-    {
-        closePage();
-        delete pdfDoc_;
-        pdfDoc_ = 0;
-    }
 }
 
-void PDF::openDocument(const QString& filename)
+bool PDF::isValid() const
 {
-    closeDocument();
-
-    pdfDoc_ = Poppler::Document::load(filename);
-    if (!pdfDoc_ || pdfDoc_->isLocked())
-    {
-        put_flog(LOG_DEBUG, "Could not open document %s", filename.toLocal8Bit().constData());
-        closeDocument();
-        return;
-    }
-
-    pdfDoc_->setRenderHint(Poppler::Document::TextAntialiasing);
-
-    setPage(0);
+    return document_.get() != 0;
 }
 
 bool PDF::isValid(const int pageNumber) const
 {
-    return pageNumber >=0 && pageNumber < pdfDoc_->numPages();
+    return document_ && pageNumber >= 0 &&
+           pageNumber < document_->getPageCount();
 }
 
 void PDF::setPage(const int pageNumber)
@@ -122,114 +119,60 @@ void PDF::setPage(const int pageNumber)
     if (pageNumber == pageNumber_ || !isValid(pageNumber))
         return;
 
-    closePage();
-
-    pdfPage_ = pdfDoc_->page(pageNumber); // Document starts at page 0
-    if (!pdfPage_)
+    // The page sizes are read when the document is opened, this never blocks
+    if (document_->getPageSize(pageNumber).isEmpty())
     {
         put_flog(LOG_DEBUG, "Could not open page %d", pageNumber);
         return;
     }
 
     pageNumber_ = pageNumber;
+
+    // Keep the requests for the new page and its neighbours
+    tiledTexture_->cancelPendingRequests(pageNumber_ - 1, pageNumber_ + 1);
 }
 
 int PDF::getPageCount() const
 {
-    return pdfDoc_->numPages();
+    return document_ ? document_->getPageCount() : 0;
 }
 
 QImage PDF::renderToImage() const
 {
-    return pdfPage_->renderToImage();
+    return document_ ? document_->renderPage(pageNumber_) : QImage();
 }
 
 QSize PDF::getSize() const
 {
-    return pdfPage_ ? pdfPage_->pageSize() : QSize();
+    if (pageNumber_ == INVALID_PAGE_NUMBER)
+        return QSize();
+    return document_->getPageSize(pageNumber_).toSize();
 }
 
-void PDF::render(const QRectF& texCoords)
+PyramidTiling PDF::getTiling(const int pageNumber) const
 {
-    if (!pdfPage_)
-        return;
-
-    // get on-screen and full rectangle corresponding to the window
-    const QRectF screenRect = GLWindow::getProjectedPixelRect(true);
-    const QRectF fullRect = GLWindow::getProjectedPixelRect(false);
-
-    // if we're not visible or we don't have a valid SVG, we're done...
-    if(screenRect.isEmpty())
-    {
-        // TODO clear existing FBO for this OpenGL window
-        return;
-    }
-
-    // generate texture corresponding to the visible part of these texture coordinates
-    generateTexture(screenRect, fullRect, texCoords);
-
-    if(!texture_.isValid())
-        return;
-
-    // figure out what visible region is for screenRect, a subregion of [0, 0, 1, 1]
-    const float xp = (screenRect.x() - fullRect.x()) / fullRect.width();
-    const float yp = (screenRect.y() - fullRect.y()) / fullRect.height();
-    const float wp = screenRect.width() / fullRect.width();
-    const float hp = screenRect.height() / fullRect.height();
-
-    // Render the entire texture on a (scaled) unit textured quad
-    glPushMatrix();
-
-    glTranslatef(xp, yp, 0);
-    glScalef(wp, hp, 1.f);
-
-    drawUnitTexturedQuad();
-
-    glPopMatrix();
+    return makeTiling(document_->getPageSize(pageNumber));
 }
 
-void PDF::drawUnitTexturedQuad()
+bool PDF::preload()
 {
-    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT);
-
-    texture_.bind();
-    quad_.render();
+    if (pageNumber_ == INVALID_PAGE_NUMBER)
+        return true;
 
-    glPopAttrib();
+    return tiledTexture_->preload(pageNumber_);
 }
 
-void PDF::generateTexture(const QRectF& screenRect, const QRectF& fullRect, const QRectF& texCoords)
+void PDF::render(const QRectF& texCoords)
 {
-    // figure out the coordinates of the topLeft corner of the texture in the PDF page
-    const double tXp = texCoords.x()/texCoords.width()*fullRect.width()  + (screenRect.x() - fullRect.x());
-    const double tYp = texCoords.y()/texCoords.height()*fullRect.height() + (screenRect.y() - fullRect.y());
-
-    // Compute the actual texture dimensions
-    const QRect textureRect(tXp, tYp, screenRect.width(), screenRect.height());
-
-    // TODO The instance of this class is shared between GLWindows, so the
-    // texture is constantly regenerated because the size changes...
-    if(textureRect == textureRect_)
-        return; // no need to regenerate texture
-
-    // Adjust the quality to match the actual displayed size
-    // Multiply resolution by the zoom factor (1/t[W,H])
-    const double resFactorX = fullRect.width() / pdfPage_->pageSize().width() / texCoords.width();
-    const double resFactorY = fullRect.height() / pdfPage_->pageSize().height() / texCoords.height();
-
-    // Generate a QImage of the rendered page
-    QImage image = pdfPage_->renderToImage(72.0*resFactorX , 72.0*resFactorY,
-                                            textureRect.x(), textureRect.y(),
-                                            textureRect.width(), textureRect.height()
-                                            );
-
-    if (image.isNull())
-    {
-        put_flog(LOG_DEBUG, "Could not render pdf to image");
+    if (pageNumber_ == INVALID_PAGE_NUMBER)
         return;
-    }
 
-    texture_.update(image, GL_BGRA);
-    textureRect_ = textureRect; // keep rendered texture information so we know when to rerender
-}
+    tiledTexture_->render(texCoords, getTiling(pageNumber_), pageNumber_);
 
+    if (isValid(pageNumber_ + 1))
+        tiledTexture_->prefetch(texCoords, getTiling(pageNumber_ + 1),
+                                pageNumber_ + 1);
+    if (isValid(pageNumber_ - 1))
+        tiledTexture_->prefetch(texCoords, getTiling(pageNumber_ - 1),
+                                pageNumber_ - 1);
+}
@@ -41,20 +41,40 @@
 #define PDF_H
 
 #include "FactoryObject.h"
-#include "GLTexture2D.h"
-#include "GLQuad.h"
+#include "PDFDocument.h"
+#include "PyramidTiling.h"
 
 #include <QString>
 
-namespace Poppler {
-    class Document;
-    class Page;
-}
+#include <boost/scoped_ptr.hpp>
 
+class TiledTexture;
+
+/**
+ * A PDF document rendered as a pyramid of tiles by a TiledTexture.
+ *
+ * The visible tiles of the neighbouring pages are prefetched at the same
+ * resolution, so that turning a page only swaps the textures.
+ *
+ * The parsed document is shared with all the other users of the same file
+ * through PDFDocument. Tiles are rasterized by several worker threads at once,
+ * and the render thread never waits for them: the page sizes are known since
+ * the document was opened.
+ */
 class PDF : public FactoryObject
 {
 public:
     PDF(const QString& uri);
+
+    /**
+     * Constructor for a document opened beforehand.
+     *
+     * The document can be opened in a worker thread, but the PDF itself must
+     * be constructed in the render thread, as it owns a TiledTexture.
+     * @param uri The location of the document
+     * @param document The opened document, or a null pointer if it is invalid
+     */
+    PDF(const QString& uri, PDFDocumentPtr document);
     ~PDF();
 
     bool isValid() const;
@@ -62,6 +82,9 @@ public:
     QSize getSize() const;
     void render(const QRectF& texCoords) override;
 
+    /** Rasterize the overview tile of the current page. */
+    bool preload() override;
+
     void setPage(const int pageNumber);
     int getPageCount() const;
 
@@ -70,21 +93,12 @@ public:
 private:
     QString uri_;
 
-    Poppler::Document* pdfDoc_;
-    Poppler::Page* pdfPage_;
+    PDFDocumentPtr document_;
     int pageNumber_;
+    boost::scoped_ptr<TiledTexture> tiledTexture_;
 
-    GLTexture2D texture_;
-    GLQuad quad_;
-    QRect textureRect_;
-
-    void openDocument(const QString& filename);
-    void closeDocument();
-    void closePage();
     bool isValid(const int pageNumber) const;
-
-    void drawUnitTexturedQuad();
-    void generateTexture(const QRectF& screenRect, const QRectF& fullRect, const QRectF& texCoords);
+    PyramidTiling getTiling(const int pageNumber) const;
 };
 
 #endif // PDF_H
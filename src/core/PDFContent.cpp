@@ -39,9 +39,12 @@
 
 #include "PDFContent.h"
 #include "PDF.h"
+#include "PDFDocument.h"
 #include "Factories.h"
 
 #include "serializationHelpers.h"
+#include <QDataStream>
+
 #include <boost/serialization/export.hpp>
 
 BOOST_CLASS_EXPORT_GUID(PDFContent, "PDFContent")
@@ -61,12 +64,13 @@ CONTENT_TYPE PDFContent::getType()
 
 bool PDFContent::readMetadata()
 {
-    const PDF pdf( uri_ );
-    if( !pdf.isValid( ))
+    // Shares the parsed document with the other users of this file
+    const PDFDocumentPtr document = PDFDocument::get( uri_ );
+    if( !document )
         return false;
 
-    size_ = pdf.getSize();
-    pageCount_ = pdf.getPageCount();
+    size_ = document->getPageSize( 0 ).toSize();
+    pageCount_ = document->getPageCount();
     pageNumber_ = std::min( pageNumber_, pageCount_ - 1 );
 
     return true;
@@ -106,3 +110,15 @@ void PDFContent::postRenderUpdate(Factories& factories, ContentWindowPtr, WallTo
 {
     factories.getPDFFactory().getObject(getURI())->setPage(pageNumber_);
 }
+
+void PDFContent::writeState( QDataStream& out ) const
+{
+    out << (qint32)pageNumber_;
+}
+
+void PDFContent::readState( QDataStream& in )
+{
+    qint32 pageNumber = 0;
+    in >> pageNumber;
+    pageNumber_ = pageNumber;
+}
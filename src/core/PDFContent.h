@@ -71,6 +71,9 @@ public:
     /** Rank0 : go to previous page **/
     void previousPage();
 
+    void writeState( QDataStream& out ) const override;
+    void readState( QDataStream& in ) override;
+
 signals:
     /** Emitted when the page number is changed **/
     void pageChanged();
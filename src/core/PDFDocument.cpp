@@ -0,0 +1,192 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "PDFDocument.h"
+
+#if QT_VERSION >= 0x050000
+#include <poppler-qt5.h>
+#else
+#include <poppler-qt4.h>
+#endif
+
+#include "log.h"
+
+#include <QFileInfo>
+#include <boost/scoped_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+namespace
+{
+typedef std::map<QString, boost::weak_ptr<PDFDocument> > OpenDocuments;
+OpenDocuments openDocuments;
+QMutex openDocumentsMutex;
+
+Poppler::Document* loadDocument(const QString& filename)
+{
+    Poppler::Document* document = Poppler::Document::load(filename);
+    if (!document || document->isLocked())
+    {
+        put_flog(LOG_DEBUG, "Could not open document %s",
+                 filename.toLocal8Bit().constData());
+        delete document;
+        return 0;
+    }
+    document->setRenderHint(Poppler::Document::TextAntialiasing);
+    return document;
+}
+}
+
+PDFDocumentPtr PDFDocument::get(const QString& uri)
+{
+    const QString filename = QFileInfo(uri).absoluteFilePath();
+
+    const QMutexLocker lock(&openDocumentsMutex);
+
+    PDFDocumentPtr document = openDocuments[filename].lock();
+    if (document)
+        return document;
+
+    Poppler::Document* popplerDoc = loadDocument(filename);
+    if (!popplerDoc)
+    {
+        openDocuments.erase(filename);
+        return PDFDocumentPtr();
+    }
+
+    document.reset(new PDFDocument(filename, popplerDoc));
+    openDocuments[filename] = document;
+
+    // Forget the documents which have been released in the meantime
+    OpenDocuments::iterator it = openDocuments.begin();
+    while (it != openDocuments.end())
+    {
+        if (it->second.expired())
+            openDocuments.erase(it++);
+        else
+            ++it;
+    }
+
+    return document;
+}
+
+PDFDocument::PDFDocument(const QString& filename, Poppler::Document* document)
+    : filename_(filename)
+{
+    documents_.push_back(PopplerDocumentPtr(document));
+    idleDocuments_.push_back(document);
+
+    pageSizes_.resize(document->numPages());
+    for (size_t i = 0; i < pageSizes_.size(); ++i)
+    {
+        boost::scoped_ptr<Poppler::Page> page(document->page(i));
+        if (page)
+            pageSizes_[i] = page->pageSizeF();
+    }
+}
+
+PDFDocument::~PDFDocument()
+{
+}
+
+int PDFDocument::getPageCount() const
+{
+    return pageSizes_.size();
+}
+
+QSizeF PDFDocument::getPageSize(const int pageNumber) const
+{
+    if (pageNumber < 0 || pageNumber >= getPageCount())
+        return QSizeF();
+
+    return pageSizes_[pageNumber];
+}
+
+QImage PDFDocument::renderPage(const int pageNumber, const double resolution,
+                               const QRect& region) const
+{
+    if (pageNumber < 0 || pageNumber >= getPageCount())
+        return QImage();
+
+    Poppler::Document* document = acquireDocument();
+    if (!document)
+        return QImage();
+
+    QImage image;
+    {
+        boost::scoped_ptr<Poppler::Page> page(document->page(pageNumber));
+        if (!page)
+            put_flog(LOG_DEBUG, "Could not open page %d", pageNumber);
+        else if (region.isEmpty())
+            image = page->renderToImage(resolution, resolution);
+        else
+            image = page->renderToImage(resolution, resolution,
+                                        region.x(), region.y(),
+                                        region.width(), region.height());
+    }
+
+    releaseDocument(document);
+    return image;
+}
+
+Poppler::Document* PDFDocument::acquireDocument() const
+{
+    {
+        const QMutexLocker lock(&documentsMutex_);
+        if (!idleDocuments_.empty())
+        {
+            Poppler::Document* document = idleDocuments_.back();
+            idleDocuments_.pop_back();
+            return document;
+        }
+    }
+
+    // All the documents are rendering, open a new one for this thread
+    Poppler::Document* document = loadDocument(filename_);
+    if (!document)
+        return 0;
+
+    const QMutexLocker lock(&documentsMutex_);
+    documents_.push_back(PopplerDocumentPtr(document));
+    return document;
+}
+
+void PDFDocument::releaseDocument(Poppler::Document* document) const
+{
+    const QMutexLocker lock(&documentsMutex_);
+    idleDocuments_.push_back(document);
+}
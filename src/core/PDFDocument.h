@@ -0,0 +1,121 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef PDFDOCUMENT_H
+#define PDFDOCUMENT_H
+
+#include <QImage>
+#include <QMutex>
+#include <QRect>
+#include <QSizeF>
+#include <QString>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace Poppler {
+    class Document;
+}
+
+class PDFDocument;
+typedef boost::shared_ptr<PDFDocument> PDFDocumentPtr;
+
+/**
+ * A parsed PDF document, shared by all the users of the same file in a
+ * process.
+ *
+ * The size of all the pages is read when the document is opened, so that it
+ * is then available without touching the document. A Poppler document can
+ * only render one page at a time: the document is cloned (opened again) for
+ * each additional page rendered concurrently, and the clones are reused
+ * afterwards. The methods of this class are thread-safe.
+ */
+class PDFDocument : public boost::noncopyable
+{
+public:
+    /**
+     * Get the document for a file, opening it if it is not already in use.
+     *
+     * Opening a document reads all its pages, which can be slow for large
+     * documents; avoid calling this from the render thread.
+     * @param uri The path to the PDF file
+     * @return the shared document, or a null pointer if it can't be opened
+     */
+    static PDFDocumentPtr get(const QString& uri);
+
+    /** Destructor */
+    ~PDFDocument();
+
+    /** @return the number of pages. */
+    int getPageCount() const;
+
+    /**
+     * Get the size of a page, without blocking.
+     * @param pageNumber The page, starting at 0
+     * @return the size of the page in points, empty if the page is invalid
+     */
+    QSizeF getPageSize(const int pageNumber) const;
+
+    /**
+     * Rasterize a page.
+     * @param pageNumber The page, starting at 0
+     * @param resolution The resolution in dots per inch
+     * @param region The area to render in pixels at this resolution,
+     *        the whole page if empty
+     * @return the image, null if the page can not be rendered
+     */
+    QImage renderPage(const int pageNumber, const double resolution = 72.0,
+                      const QRect& region = QRect()) const;
+
+private:
+    PDFDocument(const QString& filename, Poppler::Document* document);
+
+    const QString filename_;
+    std::vector<QSizeF> pageSizes_;
+
+    typedef boost::shared_ptr<Poppler::Document> PopplerDocumentPtr;
+    mutable QMutex documentsMutex_;
+    mutable std::vector<PopplerDocumentPtr> documents_;
+    mutable std::vector<Poppler::Document*> idleDocuments_;
+
+    Poppler::Document* acquireDocument() const;
+    void releaseDocument(Poppler::Document* document) const;
+};
+
+#endif // PDFDOCUMENT_H
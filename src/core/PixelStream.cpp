@@ -44,6 +44,7 @@
 #include "log.h"
 #include "PixelStreamSegmentRenderer.h"
 
+#include <deflect/PixelStreamBuffer.h>
 #include <deflect/PixelStreamFrame.h>
 #include <deflect/PixelStreamSegmentDecoder.h>
 #include <deflect/PixelStreamSegmentParameters.h>
@@ -96,13 +97,16 @@ void PixelStream::preRenderUpdate(const QRectF& windowRect, WallToWallChannel& w
 void PixelStream::updateRenderers(const deflect::PixelStreamSegments& segments)
 {
     assert(segmentRenderers_.size() == segments.size());
+    assert(changedSegments_.size() == segments.size());
 
     for(size_t i=0; i<segments.size(); i++)
     {
         // The parameters always need to be up to date to determine visibility when rendering.
         segmentRenderers_[i]->setParameters(segments[i].parameters.x, segments[i].parameters.y,
                                             segments[i].parameters.width, segments[i].parameters.height);
-        segmentRenderers_[i]->setTextureNeedsUpdate();
+        // The textures of the segments kept from the previous frame are still valid
+        if (changedSegments_[i])
+            segmentRenderers_[i]->setTextureNeedsUpdate();
     }
 }
 
@@ -127,7 +131,7 @@ void PixelStream::swapBuffers()
 {
     assert(!backBuffer_.empty());
 
-    frontBuffer_ = backBuffer_;
+    frontBuffer_ = mergeSegments(frontBuffer_, backBuffer_, &changedSegments_);
     backBuffer_.clear();
 
     buffersSwapped_ = true;
@@ -200,6 +204,79 @@ void PixelStream::setNewFrame(const deflect::PixelStreamFramePtr frame)
     syncPixelStreamFrame_.update(frame);
 }
 
+namespace
+{
+bool coversFrame(const deflect::PixelStreamSegments& segments)
+{
+    const QSize size = deflect::PixelStreamBuffer::computeFrameDimensions(segments);
+
+    size_t area = 0;
+    for (size_t i = 0; i < segments.size(); ++i)
+        area += segments[i].parameters.width * segments[i].parameters.height;
+
+    return area >= (size_t)size.width() * (size_t)size.height();
+}
+
+bool hasSamePosition(const deflect::PixelStreamSegment& a,
+                     const deflect::PixelStreamSegment& b)
+{
+    return a.parameters.x == b.parameters.x && a.parameters.y == b.parameters.y;
+}
+}
+
+deflect::PixelStreamSegments
+PixelStream::mergeSegments(const deflect::PixelStreamSegments& previous,
+                           const deflect::PixelStreamSegments& update,
+                           std::vector<bool>* changed)
+{
+    if (previous.empty() || coversFrame(update))
+    {
+        if (changed)
+            changed->assign(update.size(), true);
+        return update;
+    }
+
+    const QSize size = deflect::PixelStreamBuffer::computeFrameDimensions(update);
+
+    deflect::PixelStreamSegments merged;
+    std::vector<bool> changedSegments;
+    merged.reserve(previous.size() + update.size());
+    for (size_t i = 0; i < previous.size(); ++i)
+    {
+        const deflect::PixelStreamSegmentParameters& params = previous[i].parameters;
+        if (params.x + params.width <= (unsigned int)size.width() &&
+            params.y + params.height <= (unsigned int)size.height())
+        {
+            // Segments shifted by a dropped one move to another renderer
+            changedSegments.push_back(merged.size() != i);
+            merged.push_back(previous[i]);
+        }
+    }
+
+    // Keep the order of the previous segments to preserve their renderers
+    BOOST_FOREACH(const deflect::PixelStreamSegment& segment, update)
+    {
+        deflect::PixelStreamSegments::iterator it = merged.begin();
+        while (it != merged.end() && !hasSamePosition(*it, segment))
+            ++it;
+
+        if (it != merged.end())
+        {
+            *it = segment;
+            changedSegments[it - merged.begin()] = true;
+        }
+        else
+        {
+            merged.push_back(segment);
+            changedSegments.push_back(true);
+        }
+    }
+
+    if (changed)
+        changed->swap(changedSegments);
+    return merged;
+}
+
 void PixelStream::setRenderingOptions(const bool showSegmentBorders,
                                       const bool showSegmentStatistics)
 {
@@ -213,7 +290,8 @@ void PixelStream::sync(WallToWallChannel& wallToWallChannel)
         boost::bind( &WallToWallChannel::checkVersion, &wallToWallChannel, _1 );
     if (syncPixelStreamFrame_.sync(versionCheckFunc))
     {
-        backBuffer_ = syncPixelStreamFrame_.get()->segments;
+        // Partial frames must not be lost if the previous one was not used
+        backBuffer_ = mergeSegments(backBuffer_, syncPixelStreamFrame_.get()->segments);
         emit requestFrame(uri_);
     }
 }
@@ -68,6 +68,24 @@ public:
 
     void setNewFrame(const deflect::PixelStreamFramePtr frame);
 
+    /**
+     * Merge the segments of a new frame with those of the previous one.
+     *
+     * A partial frame only contains the segments which have changed; they
+     * replace the previous segments at the same position, while those which
+     * fall outside of the new frame dimensions are dropped. A frame whose
+     * segments cover its whole area replaces the previous frame.
+     * @param previous The segments of the previous frame.
+     * @param update The segments of the new frame.
+     * @param changed Optional output, for each merged segment: true if it
+     *        differs from the previous segment at the same index.
+     * @return The segments of the merged frame.
+     */
+    static deflect::PixelStreamSegments
+    mergeSegments(const deflect::PixelStreamSegments& previous,
+                  const deflect::PixelStreamSegments& update,
+                  std::vector<bool>* changed = 0);
+
     void setRenderingOptions(const bool showSegmentBorders,
                              const bool showSegmentStatistics);
 
@@ -91,6 +109,8 @@ private:
     // The back buffer contains the next frame to process (last frame received)
     deflect::PixelStreamSegments backBuffer_;
     bool buffersSwapped_;
+    // The segments of the front buffer which were replaced by the last swap
+    std::vector<bool> changedSegments_;
 
     // The list of decoded images for the next frame
     std::vector<PixelStreamSegmentDecoderPtr> frameDecoders_;
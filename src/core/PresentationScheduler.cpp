@@ -0,0 +1,130 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "PresentationScheduler.h"
+
+namespace
+{
+const int DEFAULT_REFRESH_RATE = 60;
+const int MICROSECONDS_PER_SECOND = 1000000;
+}
+
+PresentationScheduler::PresentationScheduler()
+    : refreshInterval_(boost::posix_time::microseconds(MICROSECONDS_PER_SECOND / DEFAULT_REFRESH_RATE))
+    , loop_(false)
+    , paused_(false)
+{
+}
+
+void PresentationScheduler::setRefreshInterval(const Duration& interval)
+{
+    refreshInterval_ = interval;
+}
+
+void PresentationScheduler::setDuration(const Duration& duration)
+{
+    duration_ = duration;
+}
+
+void PresentationScheduler::setLoop(const bool loop)
+{
+    loop_ = loop;
+}
+
+void PresentationScheduler::setPaused(const bool paused)
+{
+    if(paused == paused_)
+        return;
+
+    // Re-anchor so that the position is frozen while paused and playback
+    // resumes exactly from where it stopped.
+    anchorPosition_ = getPosition();
+    anchorTime_ = frameTime_;
+    paused_ = paused;
+}
+
+bool PresentationScheduler::isPaused() const
+{
+    return paused_;
+}
+
+void PresentationScheduler::update(const Time& frameTime)
+{
+    if(anchorTime_.is_not_a_date_time())
+        anchorTime_ = frameTime;
+
+    frameTime_ = frameTime;
+}
+
+PresentationScheduler::Duration PresentationScheduler::getPosition() const
+{
+    if(paused_ || frameTime_.is_not_a_date_time())
+        return wrap(anchorPosition_);
+
+    return wrap(anchorPosition_ + (frameTime_ - anchorTime_));
+}
+
+void PresentationScheduler::setPosition(const Duration& position)
+{
+    anchorPosition_ = position;
+    anchorTime_ = frameTime_;
+}
+
+PresentationScheduler::Duration PresentationScheduler::getPresentationTime() const
+{
+    if(paused_)
+        return getPosition();
+
+    return wrap(getPosition() + refreshInterval_ / 2);
+}
+
+PresentationScheduler::Duration PresentationScheduler::wrap(const Duration& position) const
+{
+    if(duration_.total_microseconds() <= 0)
+        return position;
+
+    if(position >= duration_)
+    {
+        if(!loop_)
+            return duration_;
+
+        return boost::posix_time::microseconds(position.total_microseconds() %
+                                               duration_.total_microseconds());
+    }
+    return position;
+}
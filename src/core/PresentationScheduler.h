@@ -0,0 +1,129 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef PRESENTATIONSCHEDULER_H
+#define PRESENTATIONSCHEDULER_H
+
+#ifndef Q_MOC_RUN
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/shared_ptr.hpp>
+#endif
+
+/**
+ * Map the synchronized wall frame clock to the presentation timestamps of a
+ * movie stream.
+ *
+ * The stream position is derived from the wall clock relative to an anchor
+ * point instead of being accumulated frame by frame, so it never drifts from
+ * the real time when the render loop is late. Movies which share the same
+ * scheduler present the same position every frame and are thus frame-locked.
+ */
+class PresentationScheduler
+{
+public:
+    typedef boost::posix_time::ptime Time;
+    typedef boost::posix_time::time_duration Duration;
+
+    /** Constructor */
+    PresentationScheduler();
+
+    /**
+     * Set the display refresh interval.
+     * Frames are selected for the middle of each interval, which makes the
+     * selection robust to small variations of the render loop timing.
+     * @param interval The vsync interval, 1/60s by default
+     */
+    void setRefreshInterval(const Duration& interval);
+
+    /**
+     * Set the duration of the stream.
+     * @param duration The duration, a null duration means unknown
+     */
+    void setDuration(const Duration& duration);
+
+    /** Wrap around at the end of the stream instead of stopping. */
+    void setLoop(const bool loop);
+
+    /**
+     * Pause or resume playback.
+     * Playback resumes from the position at which it was paused.
+     */
+    void setPaused(const bool paused);
+
+    /** @return true if the playback is paused. */
+    bool isPaused() const;
+
+    /**
+     * Advance to a new wall frame.
+     * Calling this method several times with the same time has no effect,
+     * which allows a scheduler to be shared by a group of movies.
+     * @param frameTime The synchronized wall clock of the frame
+     */
+    void update(const Time& frameTime);
+
+    /** @return The stream position at the start of the current frame. */
+    Duration getPosition() const;
+
+    /**
+     * Set the stream position for the current frame.
+     * Used for seeking and to correct the drift between processes.
+     */
+    void setPosition(const Duration& position);
+
+    /**
+     * @return The stream position to present during the current refresh
+     *         interval, that is the middle of the interval.
+     */
+    Duration getPresentationTime() const;
+
+private:
+    Duration refreshInterval_;
+    Duration duration_;
+    bool loop_;
+    bool paused_;
+
+    Time frameTime_;
+    Time anchorTime_;
+    Duration anchorPosition_;
+
+    Duration wrap(const Duration& position) const;
+};
+
+typedef boost::shared_ptr<PresentationScheduler> PresentationSchedulerPtr;
+
+#endif // PRESENTATIONSCHEDULER_H
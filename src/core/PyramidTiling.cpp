@@ -0,0 +1,165 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "PyramidTiling.h"
+
+#include <algorithm>
+#include <cmath>
+
+const int PyramidTiling::tileSize = 512;
+
+TileIndex TileIndex::getAncestor(const int ancestorLevel) const
+{
+    const int shift = level - ancestorLevel;
+    return TileIndex(page, ancestorLevel, x >> shift, y >> shift);
+}
+
+bool TileIndex::operator<(const TileIndex& other) const
+{
+    if (page != other.page)
+        return page < other.page;
+    if (level != other.level)
+        return level < other.level;
+    if (y != other.y)
+        return y < other.y;
+    return x < other.x;
+}
+
+bool TileIndex::operator==(const TileIndex& other) const
+{
+    return page == other.page && level == other.level &&
+           x == other.x && y == other.y;
+}
+
+PyramidTiling::PyramidTiling(const QSizeF& size, const double maxScale)
+    : size_(size)
+    , baseScale_(0.0)
+    , maxLevel_(0)
+{
+    if (size_.isEmpty())
+        return;
+
+    baseScale_ = tileSize / std::max(size_.width(), size_.height());
+
+    const double maxZoom = maxScale / baseScale_;
+    if (maxZoom > 1.0)
+        maxLevel_ = (int)std::floor(std::log(maxZoom) / std::log(2.0));
+}
+
+const QSizeF& PyramidTiling::getSize() const
+{
+    return size_;
+}
+
+int PyramidTiling::getMaxLevel() const
+{
+    return maxLevel_;
+}
+
+int PyramidTiling::getLevel(const QSizeF& displayedSize) const
+{
+    const QSize baseSize = getImageSize(0);
+    if (baseSize.isEmpty())
+        return 0;
+
+    const double ratio = std::max(displayedSize.width() / baseSize.width(),
+                                  displayedSize.height() / baseSize.height());
+    if (ratio <= 1.0)
+        return 0;
+
+    const int level = (int)std::ceil(std::log(ratio) / std::log(2.0));
+    return std::min(level, maxLevel_);
+}
+
+double PyramidTiling::getScale(const int level) const
+{
+    return baseScale_ * (1 << level);
+}
+
+QSize PyramidTiling::getImageSize(const int level) const
+{
+    // Tolerance avoids an extra pixel (and tile) from rounding errors
+    const double scale = baseScale_ * (1 << level);
+    return QSize((int)std::ceil(size_.width() * scale - 1e-6),
+                 (int)std::ceil(size_.height() * scale - 1e-6));
+}
+
+QSize PyramidTiling::getTileCount(const int level) const
+{
+    const QSize imageSize = getImageSize(level);
+    return QSize((imageSize.width() + tileSize - 1) / tileSize,
+                 (imageSize.height() + tileSize - 1) / tileSize);
+}
+
+QRect PyramidTiling::getTileRect(const TileIndex& index) const
+{
+    const QRect tile(index.x * tileSize, index.y * tileSize, tileSize, tileSize);
+    return tile & QRect(QPoint(0, 0), getImageSize(index.level));
+}
+
+QRectF PyramidTiling::getNormalizedTileRect(const TileIndex& index) const
+{
+    const QSize imageSize = getImageSize(index.level);
+    if (imageSize.isEmpty())
+        return QRectF();
+
+    const QRect tile = getTileRect(index);
+    return QRectF((double)tile.x() / imageSize.width(),
+                  (double)tile.y() / imageSize.height(),
+                  (double)tile.width() / imageSize.width(),
+                  (double)tile.height() / imageSize.height());
+}
+
+QRect PyramidTiling::getTilesInRegion(const int level, const QRectF& region) const
+{
+    const QRectF visible = region & QRectF(0.0, 0.0, 1.0, 1.0);
+    if (visible.isEmpty())
+        return QRect();
+
+    const QSize imageSize = getImageSize(level);
+    const QSize tileCount = getTileCount(level);
+
+    const int x0 = (int)std::floor(visible.left() * imageSize.width() / tileSize);
+    const int y0 = (int)std::floor(visible.top() * imageSize.height() / tileSize);
+    const int x1 = (int)std::ceil(visible.right() * imageSize.width() / tileSize);
+    const int y1 = (int)std::ceil(visible.bottom() * imageSize.height() / tileSize);
+
+    return QRect(QPoint(std::max(x0, 0), std::max(y0, 0)),
+                 QPoint(std::min(x1, tileCount.width()) - 1,
+                        std::min(y1, tileCount.height()) - 1));
+}
@@ -0,0 +1,130 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef PYRAMIDTILING_H
+#define PYRAMIDTILING_H
+
+#include <QRect>
+#include <QRectF>
+#include <QSizeF>
+
+/**
+ * Identify a tile of a TiledTexture.
+ */
+struct TileIndex
+{
+    TileIndex(const int page_ = 0, const int level_ = 0,
+              const int x_ = 0, const int y_ = 0)
+        : page(page_), level(level_), x(x_), y(y_) {}
+
+    /** @return the tile covering this one at a lower level. */
+    TileIndex getAncestor(const int ancestorLevel) const;
+
+    bool operator<(const TileIndex& other) const;
+    bool operator==(const TileIndex& other) const;
+
+    /** The page of a document, 0 for single-page contents. */
+    int page;
+    int level;
+    int x;
+    int y;
+};
+
+/**
+ * Divide a vector image into fixed-size tiles at discrete zoom levels.
+ *
+ * At level 0 the whole image fits in a single tile, and each following level
+ * doubles the resolution, like the levels of an image pyramid.
+ */
+class PyramidTiling
+{
+public:
+    /** The size of a tile, in pixels. */
+    static const int tileSize;
+
+    /**
+     * Constructor.
+     * @param size The size of the image in its own units (i.e. points for PDF)
+     * @param maxScale The maximum number of pixels per unit, which limits the
+     *        number of levels
+     */
+    explicit PyramidTiling(const QSizeF& size = QSizeF(),
+                           const double maxScale = 1.0);
+
+    /** @return the size of the image in its own units. */
+    const QSizeF& getSize() const;
+
+    /** @return the highest zoom level. */
+    int getMaxLevel() const;
+
+    /**
+     * Get the lowest level with a resolution sufficient for display.
+     * @param displayedSize The size of the whole image on screen, in pixels
+     */
+    int getLevel(const QSizeF& displayedSize) const;
+
+    /** @return the number of pixels per unit at the given level. */
+    double getScale(const int level) const;
+
+    /** @return the size of the full image at the given level, in pixels. */
+    QSize getImageSize(const int level) const;
+
+    /** @return the number of tiles in each dimension at the given level. */
+    QSize getTileCount(const int level) const;
+
+    /** @return the area covered by a tile in the full image, in pixels. */
+    QRect getTileRect(const TileIndex& index) const;
+
+    /** @return the area covered by a tile, in normalized coordinates. */
+    QRectF getNormalizedTileRect(const TileIndex& index) const;
+
+    /**
+     * Get the range of tiles intersecting a region of the image.
+     * @param level The zoom level
+     * @param region A region of the image, in normalized coordinates
+     * @return the (x, y) indices of the tiles, empty if none intersects
+     */
+    QRect getTilesInRegion(const int level, const QRectF& region) const;
+
+private:
+    QSizeF size_;
+    double baseScale_;
+    int maxLevel_;
+};
+
+#endif // PYRAMIDTILING_H
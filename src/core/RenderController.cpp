@@ -47,6 +47,7 @@
 
 #include "DisplayGroup.h"
 #include "Options.h"
+#include "Factories.h"
 
 #include <boost/make_shared.hpp>
 #include <boost/bind.hpp>
@@ -70,6 +71,8 @@ RenderController::RenderController(RenderContextPtr renderContext, FactoriesPtr
 
     syncOptions_.setCallback(boost::bind(&RenderController::setRenderOptions,
                                          this, _1));
+    syncPreload_.setCallback(boost::bind(&Factories::setPreload,
+                                         factories.get(), _1));
 }
 
 DisplayGroupPtr RenderController::getDisplayGroup() const
@@ -83,6 +86,7 @@ void RenderController::synchronizeObjects(const SyncFunction& versionCheckFunc)
     syncDisplayGroup_.sync(versionCheckFunc);
     syncMarkers_.sync(versionCheckFunc);
     syncOptions_.sync(versionCheckFunc);
+    syncPreload_.sync(versionCheckFunc);
 }
 
 bool RenderController::quitRendering() const
@@ -105,6 +109,11 @@ void RenderController::updateMarkers(MarkersPtr markers)
     syncMarkers_.update(markers);
 }
 
+void RenderController::updatePreload(SessionPreloadPtr preload)
+{
+    syncPreload_.update(preload);
+}
+
 void RenderController::updateOptions(OptionsPtr options)
 {
     syncOptions_.update(options);
@@ -71,6 +71,7 @@ public slots:
     void updateDisplayGroup(DisplayGroupPtr displayGroup);
     void updateOptions(OptionsPtr options);
     void updateMarkers(MarkersPtr markers);
+    void updatePreload(SessionPreloadPtr preload);
 
 private:
     RenderContextPtr renderContext_;
@@ -82,6 +83,7 @@ private:
     SwapSyncObject<DisplayGroupPtr> syncDisplayGroup_;
     SwapSyncObject<OptionsPtr> syncOptions_;
     SwapSyncObject<MarkersPtr> syncMarkers_;
+    SwapSyncObject<SessionPreloadPtr> syncPreload_;
 
     void setRenderOptions(OptionsPtr options);
 };
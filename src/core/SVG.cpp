@@ -38,34 +38,80 @@
 
 #include "SVG.h"
 #include "log.h"
-#include "GLWindow.h"
-#include "RenderContext.h"
+#include "TiledTexture.h"
 
-#include <cmath>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
 
-#define MULTI_SAMPLE_ANTI_ALIASING_SAMPLES 8
+// Maximum zoom level relative to the default size of the SVG
+#define MAX_SCALE 32.0
+
+namespace
+{
+typedef boost::shared_ptr<QSvgRenderer> QSvgRendererPtr;
+
+// Called from the TileRenderer worker thread, with its own QSvgRenderer
+QImage renderTile(QSvgRendererPtr renderer, const QRectF& extents,
+                  const PyramidTiling& tiling, const TileIndex& index)
+{
+    const QRect tile = tiling.getTileRect(index);
+    if (tile.isEmpty())
+        return QImage();
+
+    // generate and set view box in logical coordinates
+    const QSize imageSize = tiling.getImageSize(index.level);
+    const double scaleX = extents.width() / imageSize.width();
+    const double scaleY = extents.height() / imageSize.height();
+    renderer->setViewBox(QRectF(extents.x() + tile.x() * scaleX,
+                                extents.y() + tile.y() * scaleY,
+                                tile.width() * scaleX,
+                                tile.height() * scaleY));
+
+    QImage image(tile.size(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(0);
+
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing |
+                           QPainter::SmoothPixmapTransform);
+    renderer->render(&painter);
+    painter.end();
+
+    return image;
+}
+}
 
 SVG::SVG(const QString uri)
+    : SVG(uri, readFile(uri))
+{
+}
+
+SVG::SVG(const QString& uri, const QByteArray& imageData)
     : uri_(uri)
 {
-    QFile file(uri);
+    if(imageData.isEmpty())
+        return;
 
-    if(!file.open(QIODevice::ReadOnly))
+    if(!setImageData(imageData))
     {
-        put_flog(LOG_WARN, "could not open file %s", uri.toLocal8Bit().constData());
+        put_flog(LOG_WARN, "could not setImageData %s", uri.toLocal8Bit().constData());
         return;
     }
+}
+
+QByteArray SVG::readFile(const QString& uri)
+{
+    QFile file(uri);
 
-    if(!setImageData(file.readAll()))
+    if(!file.open(QIODevice::ReadOnly))
     {
-        put_flog(LOG_WARN, "could not setImageData %s", uri.toLocal8Bit().constData());
-        return;
+        put_flog(LOG_WARN, "could not open file %s", uri.toLocal8Bit().constData());
+        return QByteArray();
     }
+    return file.readAll();
 }
 
 SVG::~SVG()
 {
-    // no need to delete textures, that's handled in FBO destructor
 }
 
 QSize SVG::getSize() const
@@ -86,147 +132,29 @@ bool SVG::setImageData(const QByteArray& imageData)
         return false;
     }
 
-    // save logical coordinates
-    svgExtents_ = svgRenderer_.viewBoxF();
-
-    // reset rendered texture information to force regenerating the texture
-    for( std::map<int, SVGTextureData>::iterator it = textureData_.begin();
-         it != textureData_.end(); ++it )
-    {
-        it->second.region = QRectF();
-    }
+    // The worker thread needs its own renderer, as setting the view box
+    // modifies it
+    QSvgRendererPtr tileRenderer = boost::make_shared<QSvgRenderer>(imageData);
 
+    tiling_ = PyramidTiling(QSizeF(svgRenderer_.defaultSize()), MAX_SCALE);
+    tiledTexture_.reset(new TiledTexture(boost::bind(&renderTile, tileRenderer,
+                                                     svgRenderer_.viewBoxF(),
+                                                     tiling_, _1)));
     return true;
 }
 
 void SVG::render(const QRectF& texCoords)
 {
-    // get on-screen and full rectangle corresponding to the window in pixel units
-    const QRectF screenRect = GLWindow::getProjectedPixelRect(true);
-    const QRectF fullRect = GLWindow::getProjectedPixelRect(false); // maps to [tX, tY, tW, tH]
-
-    // If we're not visible or we don't have a valid SVG, we're done.
-    if(screenRect.isEmpty() || !svgRenderer_.isValid())
-    {
-        textureData_.erase(renderContext_->getActiveGLWindowIndex());
+    if(!tiledTexture_)
         return;
-    }
 
-    // Get the texture for the current GLWindow
-    SVGTextureData& textureData = textureData_[renderContext_->getActiveGLWindowIndex()];
-
-    const QRectF textureRect = computeTextureRect(screenRect, fullRect, texCoords);
-    const QSize textureSize(round(screenRect.width()), round(screenRect.height()));
-
-    const bool recreateTextureFbo = !textureData.fbo || textureData.fbo->size() != textureSize;
-
-    if( recreateTextureFbo || textureRect != textureData.region )
-    {
-        if ( recreateTextureFbo )
-        {
-            textureData.fbo.reset( new QGLFramebufferObject( textureSize ));
-        }
-
-        renderToTexture(textureRect, textureData.fbo);
-
-        // keep rendered texture information so we know when to rerender
-        // this works great when the SVG is only rendered once per GLWindow
-        // however, it will rerender every time otherwise, for example if the zoom context is shown
-        textureData.region = textureRect;
-    }
-    assert(textureData.fbo);
-
-    // figure out what visible region is for screenRect, a subregion of [0, 0, 1, 1]
-    const float xp = (screenRect.x() - fullRect.x()) / fullRect.width();
-    const float yp = (screenRect.y() - fullRect.y()) / fullRect.height();
-    const float wp = screenRect.width() / fullRect.width();
-    const float hp = screenRect.height() / fullRect.height();
-
-    // Render the (scaled) unit textured quad
-    glPushMatrix();
-
-    glTranslatef(xp, yp, 0);
-    glScalef(wp, hp, 1.f);
-
-    drawUnitTexturedQuad(textureData.fbo->texture());
-
-    glPopMatrix();
-}
-
-void SVG::drawUnitTexturedQuad(const GLuint textureID)
-{
-    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT);
-
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    // flip the y texture coordinate since the textures are loaded upside down
-    quad_.setTexCoords(QRectF(0.f, 1.f, 1.f, -1.f));
-    quad_.render();
-
-    glPopAttrib();
-}
-
-QRectF SVG::computeTextureRect(const QRectF& screenRect, const QRectF& fullRect,
-                               const QRectF& texCoords) const
-{
-    // figure out what visible [tX, tY, tW, tH] is for screenRect
-    const float tXp = texCoords.x() + (screenRect.x() - fullRect.x()) / fullRect.width() * texCoords.width();
-    const float tYp = texCoords.y() + (screenRect.y() - fullRect.y()) / fullRect.height() * texCoords.height();
-    const float tWp = screenRect.width() / fullRect.width() * texCoords.width();
-    const float tHp = screenRect.height() / fullRect.height() * texCoords.height();
-
-    return QRectF(tXp, tYp, tWp, tHp);
-}
-
-void SVG::renderToTexture(const QRectF& textureRect, QGLFramebufferObjectPtr targetFbo)
-{
-    saveGLState();
-
-    // generate and set view box in logical coordinates
-    QRectF viewbox(svgExtents_.x() + textureRect.x() * svgExtents_.width(),
-                   svgExtents_.y() + textureRect.y() * svgExtents_.height(),
-                   textureRect.width() * svgExtents_.width(),
-                   textureRect.height() * svgExtents_.height());
-    svgRenderer_.setViewBox(viewbox);
-
-    // Multisampled FBO for anti-aliased rendering
-    QGLFramebufferObjectFormat format;
-    format.setAttachment(QGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(MULTI_SAMPLE_ANTI_ALIASING_SAMPLES);
-
-    QGLFramebufferObjectPtr renderFbo( new QGLFramebufferObject( targetFbo->size(), format ));
-
-    // Render to multisampled FBO
-    QPainter painter(renderFbo.get());
-    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
-    svgRenderer_.render(&painter);
-    painter.end();
-
-    // Copy to texture FBO
-    QGLFramebufferObject::blitFramebuffer(
-            targetFbo.get(), QRect(0, 0, renderFbo->width(), renderFbo->height()),
-            renderFbo.get(), QRect(0, 0, renderFbo->width(), renderFbo->height()));
-
-    glBindTexture(GL_TEXTURE_2D, targetFbo->texture());
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    restoreGLState();
+    tiledTexture_->render(texCoords, tiling_);
 }
 
-void SVG::saveGLState()
+bool SVG::preload()
 {
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-}
+    if(!tiledTexture_)
+        return true;
 
-void SVG::restoreGLState()
-{
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
-    glPopAttrib();
+    return tiledTexture_->preload(0);
 }
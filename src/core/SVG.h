@@ -40,66 +40,59 @@
 #define SVG_H
 
 #include "FactoryObject.h"
+#include "PyramidTiling.h"
 #include "types.h"
-#include "GLQuad.h"
 
 #include <QtSvg>
-#include <QGLWidget>
-#include <QGLFramebufferObject>
-#include <boost/shared_ptr.hpp>
-#include <map>
+#include <boost/scoped_ptr.hpp>
 
-typedef boost::shared_ptr<QGLFramebufferObject> QGLFramebufferObjectPtr;
+class TiledTexture;
 
 /**
- * Hold texture FBO and region rendered for one GLWindow.
+ * An SVG image rendered as a pyramid of tiles by a TiledTexture.
+ *
+ * The tiles are rasterized with QPainter in a worker thread, so that complex
+ * drawings do not block the render loop while panning and zooming.
  */
-struct SVGTextureData
-{
-    /** Frame buffer Object */
-    QGLFramebufferObjectPtr fbo;
-
-    /** Texture region */
-    QRectF region;
-};
-
 class SVG : public FactoryObject
 {
 public:
     SVG(const QString uri);
+
+    /**
+     * Constructor for an image read beforehand.
+     *
+     * The file can be read in a worker thread, but the SVG itself must be
+     * constructed in the render thread, as it owns QObjects and a TiledTexture.
+     * @param uri The location of the image
+     * @param imageData The contents of the file
+     * @see readFile()
+     */
+    SVG(const QString& uri, const QByteArray& imageData);
     ~SVG();
 
+    /** Read the contents of an SVG file, @return an empty array on error. */
+    static QByteArray readFile(const QString& uri);
+
     bool isValid() const;
 
     QSize getSize() const;
     void render(const QRectF& texCoords) override;
 
+    /** Rasterize the overview tile of the image. */
+    bool preload() override;
+
 private:
     // image location
     QString uri_;
 
     // SVG renderer
-    QRectF svgExtents_;
     QSvgRenderer svgRenderer_;
 
-    // Per-GLWindow texture data
-    std::map<int, SVGTextureData> textureData_;
-
-    // SVG default dimensions
-    QSize size_;
-
-    GLQuad quad_;
+    PyramidTiling tiling_;
+    boost::scoped_ptr<TiledTexture> tiledTexture_;
 
     bool setImageData(const QByteArray& imageData);
-    void drawUnitTexturedQuad(const GLuint textureID);
-
-    QRectF computeTextureRect(const QRectF& screenRect, const QRectF& fullRect,
-                              const QRectF& texCoords) const;
-
-    void renderToTexture(const QRectF& textureRect, QGLFramebufferObjectPtr targetFbo);
-
-    void saveGLState();
-    void restoreGLState();
 };
 
 #endif
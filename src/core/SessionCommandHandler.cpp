@@ -41,12 +41,17 @@
 
 #include <deflect/Command.h>
 #include "DisplayGroup.h"
+#include "SessionPreloader.h"
 #include "log.h"
 
 #define CLEARALL_COMMAND "clearall"
+#define PREPARE_COMMAND  "prepare "
+#define ACTIVATE_COMMAND "activate"
 
-SessionCommandHandler::SessionCommandHandler(DisplayGroup& displayGroup)
+SessionCommandHandler::SessionCommandHandler(DisplayGroup& displayGroup,
+                                             SessionPreloader& sessionPreloader)
     : displayGroup_(displayGroup)
+    , sessionPreloader_(sessionPreloader)
 {
 }
 
@@ -61,6 +66,14 @@ void SessionCommandHandler::handle(const deflect::Command& command, const QStrin
 
     if (arguments == CLEARALL_COMMAND)
         displayGroup_.clear();
+    else if (arguments.startsWith(PREPARE_COMMAND))
+    {
+        // Errors are reported by the SessionPreloader once the file is read
+        const QString filename = arguments.mid(QString(PREPARE_COMMAND).length());
+        sessionPreloader_.prepare(filename.trimmed());
+    }
+    else if (arguments == ACTIVATE_COMMAND)
+        sessionPreloader_.activate();
     else
         put_flog( LOG_ERROR, "Invalid Session command received: '%s'",
                   arguments.toStdString().c_str());
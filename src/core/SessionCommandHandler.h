@@ -43,6 +43,7 @@
 #include <deflect/AbstractCommandHandler.h>
 
 class DisplayGroup;
+class SessionPreloader;
 
 /**
  * Handle session Commands.
@@ -53,8 +54,11 @@ public:
     /**
      * Constructor
      * @param displayGroup The target DisplayGroup for the commands.
+     * @param sessionPreloader The preloader for the prepare and activate
+     *        commands.
      */
-    SessionCommandHandler(DisplayGroup& displayGroup);
+    SessionCommandHandler(DisplayGroup& displayGroup,
+                          SessionPreloader& sessionPreloader);
 
     /** Get the type of commands handled by the implementation. */
     deflect::CommandType getType() const override;
@@ -69,6 +73,7 @@ public:
 
 private:
     DisplayGroup& displayGroup_;
+    SessionPreloader& sessionPreloader_;
 };
 
 #endif // SESSIONCOMMANDHANDLER_H
@@ -0,0 +1,94 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef SESSIONPRELOAD_H
+#define SESSIONPRELOAD_H
+
+#include "types.h"
+#include "Content.h"
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/vector.hpp>
+
+/**
+ * The contents of an upcoming session, which the Wall processes load in the
+ * background before the session is shown.
+ *
+ * Can be serialized and distributed to the Wall applications.
+ */
+class SessionPreload
+{
+public:
+    /** Default constructor, used for serialization. */
+    SessionPreload()
+        : id_( 0 )
+    {}
+
+    /**
+     * Constructor
+     * @param id The identifier of the session, reported back by the walls
+     *        once they are ready.
+     * @param contents The contents to load.
+     */
+    SessionPreload( const unsigned int id, const ContentPtrs& contents )
+        : id_( id )
+        , contents_( contents )
+    {}
+
+    /** @return The identifier of the session. */
+    unsigned int getId() const { return id_; }
+
+    /** @return The contents to load. */
+    const ContentPtrs& getContents() const { return contents_; }
+
+private:
+    friend class boost::serialization::access;
+
+    template< class Archive >
+    void serialize( Archive & ar, const unsigned int )
+    {
+        ar & id_;
+        ar & contents_;
+    }
+
+    unsigned int id_;
+    ContentPtrs contents_;
+};
+
+#endif // SESSIONPRELOAD_H
@@ -0,0 +1,212 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "SessionPreloader.h"
+
+#include "SessionPreload.h"
+#include "StateSerializationHelper.h"
+#include "DisplayGroup.h"
+#include "ContentWindow.h"
+#include "log.h"
+
+#include <QtConcurrentRun>
+
+#include <algorithm>
+
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+#define DEFAULT_ACTIVATION_TIMEOUT_MS 10000
+
+namespace
+{
+// Called from a worker thread, the windows are not shared until it returns
+bool loadState( DisplayGroupPtr displayGroup, const QString filename,
+                boost::shared_ptr< ContentWindowPtrs > contentWindows )
+{
+    return StateSerializationHelper( displayGroup ).load( filename,
+                                                          *contentWindows );
+}
+}
+
+SessionPreloader::SessionPreloader( DisplayGroupPtr displayGroup )
+    : displayGroup_( displayGroup )
+    , sessionId_( 0 )
+    , loading_( false )
+    , prepared_( false )
+    , ready_( false )
+    , activating_( false )
+{
+    activationTimer_.setSingleShot( true );
+    activationTimer_.setInterval( DEFAULT_ACTIVATION_TIMEOUT_MS );
+    connect( &activationTimer_, SIGNAL( timeout( )),
+             SLOT( activationTimeout( )));
+    connect( &loadWatcher_, SIGNAL( finished( )), SLOT( loadFinished( )));
+}
+
+void SessionPreloader::setActivationTimeout( const int timeoutMs )
+{
+    activationTimer_.setInterval( std::max( timeoutMs, 0 ));
+}
+
+void SessionPreloader::prepare( const QString& filename )
+{
+    // Let the walls release the objects of the discarded session
+    if( prepared_ )
+        emit preload( SessionPreloadPtr( ));
+
+    activationTimer_.stop();
+    contentWindows_.clear();
+    prepared_ = false;
+    ready_ = false;
+    activating_ = false;
+
+    // The result of a previous load, if any, is ignored: the watcher only
+    // reports the last future
+    loading_ = true;
+    loadingFilename_ = filename;
+    loadingWindows_ = boost::make_shared< ContentWindowPtrs >();
+    loadWatcher_.setFuture( QtConcurrent::run( loadState, displayGroup_,
+                                               filename, loadingWindows_ ));
+}
+
+void SessionPreloader::load( const QString& filename )
+{
+    prepare( filename );
+    activate();
+}
+
+void SessionPreloader::loadFinished()
+{
+    loading_ = false;
+    if( !loadWatcher_.result( ))
+    {
+        put_flog( LOG_ERROR, "Could not load session: '%s'",
+                  loadingFilename_.toLocal8Bit().constData( ));
+        activating_ = false;
+        emit loadFailed( loadingFilename_ );
+        return;
+    }
+
+    contentWindows_ = *loadingWindows_;
+    loadingWindows_.reset();
+    prepared_ = true;
+    if( activating_ )
+        startActivationTimer();
+
+    ContentPtrs contents;
+    contents.reserve( contentWindows_.size( ));
+    BOOST_FOREACH( ContentWindowPtr window, contentWindows_ )
+        contents.push_back( window->getContent( ));
+
+    emit preload( boost::make_shared< SessionPreload >( ++sessionId_, contents ));
+}
+
+void SessionPreloader::activate()
+{
+    if( loading_ )
+    {
+        activating_ = true;
+        return;
+    }
+
+    if( !prepared_ )
+        return;
+
+    if( ready_ )
+    {
+        showSession();
+        return;
+    }
+    activating_ = true;
+    startActivationTimer();
+}
+
+bool SessionPreloader::isLoading() const
+{
+    return loading_;
+}
+
+bool SessionPreloader::isReady() const
+{
+    return prepared_ && ready_;
+}
+
+void SessionPreloader::preloadFinished( const unsigned int id )
+{
+    // Ignore the reports for sessions which have been replaced
+    if( !prepared_ || id != sessionId_ )
+        return;
+
+    ready_ = true;
+    if( activating_ )
+        showSession();
+}
+
+void SessionPreloader::startActivationTimer()
+{
+    if( activationTimer_.interval() > 0 )
+        activationTimer_.start();
+    else
+        put_flog( LOG_INFO, "Waiting for the walls to preload the session" );
+}
+
+void SessionPreloader::activationTimeout()
+{
+    if( !prepared_ || ready_ )
+        return;
+
+    put_flog( LOG_WARN, "The walls did not preload the session within %d ms, "
+                        "showing it anyway", activationTimer_.interval( ));
+    showSession();
+}
+
+void SessionPreloader::showSession()
+{
+    activationTimer_.stop();
+    displayGroup_->setContentWindows( contentWindows_ );
+
+    // The windows now keep the objects alive on the walls, after the new
+    // DisplayGroup which is broadcasted first
+    emit preload( SessionPreloadPtr( ));
+
+    contentWindows_.clear();
+    prepared_ = false;
+    ready_ = false;
+    activating_ = false;
+}
@@ -0,0 +1,144 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef SESSIONPRELOADER_H
+#define SESSIONPRELOADER_H
+
+#include "types.h"
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QTimer>
+
+#include <boost/shared_ptr.hpp>
+
+/**
+ * Prepare a session on the walls before showing it.
+ *
+ * The state file is read and its contents are probed in a worker thread, so
+ * that the application stays responsive. The contents are then broadcasted to
+ * the wall processes, which load them in the background while the current
+ * session is still displayed.
+ * The DisplayGroup is swapped in a single step once all walls are ready, so
+ * that the new session appears at once instead of window by window.
+ */
+class SessionPreloader : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Constructor
+     * @param displayGroup The DisplayGroup in which to show the sessions.
+     */
+    SessionPreloader( DisplayGroupPtr displayGroup );
+
+    /**
+     * Start loading a state file, then preloading its contents on the walls.
+     * A session which was loading or prepared but not activated is discarded.
+     * Returns immediately, loadFailed() is emitted if the file can't be read.
+     * @param filename The state file to load.
+     */
+    void prepare( const QString& filename );
+
+    /**
+     * Show the session being prepared.
+     * The session is shown as soon as it is loaded and all walls are ready,
+     * or after the activation timeout if they fail to report it.
+     * @see setActivationTimeout()
+     */
+    void activate();
+
+    /**
+     * Set how long activate() waits for the walls before showing the session
+     * anyway. Its contents then load on the walls window by window.
+     * @param timeoutMs The timeout in milliseconds, 0 to always wait
+     */
+    void setActivationTimeout( int timeoutMs );
+
+    /** @return true while a state file is being read. */
+    bool isLoading() const;
+
+    /** @return true if a session is prepared and all walls are ready. */
+    bool isReady() const;
+
+public slots:
+    /**
+     * Load a state file and show it as soon as it is ready.
+     * @param filename The state file to load.
+     */
+    void load( const QString& filename );
+
+    /**
+     * Called when all the walls have preloaded a session.
+     * @param id The identifier of the session.
+     */
+    void preloadFinished( unsigned int id );
+
+signals:
+    /** Emitted to send the contents to preload to the walls. */
+    void preload( SessionPreloadPtr preload );
+
+    /**
+     * Emitted when a state file could not be loaded.
+     * @param filename The state file.
+     */
+    void loadFailed( QString filename );
+
+private slots:
+    void loadFinished();
+    void activationTimeout();
+
+private:
+    void startActivationTimer();
+    void showSession();
+
+    DisplayGroupPtr displayGroup_;
+    QFutureWatcher< bool > loadWatcher_;
+    QString loadingFilename_;
+    boost::shared_ptr< ContentWindowPtrs > loadingWindows_;
+    ContentWindowPtrs contentWindows_;
+    unsigned int sessionId_;
+    bool loading_;
+    bool prepared_;
+    bool ready_;
+    bool activating_;
+    QTimer activationTimer_;
+};
+
+#endif // SESSIONPRELOADER_H
@@ -0,0 +1,106 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "StateLoader.h"
+
+#include "DisplayGroup.h"
+#include "StateSerializationHelper.h"
+
+#include "log.h"
+
+#include <QtConcurrentRun>
+
+#include <boost/bind.hpp>
+
+StateLoader* StateLoader::start( DisplayGroupPtr displayGroup,
+                                 const QString& filename )
+{
+    StateLoader* loader = new StateLoader( displayGroup, filename );
+
+    loader->watcher_.setFuture( QtConcurrent::run( loader,
+                                                   &StateLoader::restore ));
+    return loader;
+}
+
+StateLoader::StateLoader( DisplayGroupPtr displayGroup,
+                          const QString& filename )
+    : displayGroup_( displayGroup )
+    , filename_( filename )
+    , cleared_( false )
+{
+    connect( this, SIGNAL( windowRestored( ContentWindowPtr )),
+             this, SLOT( addWindow( ContentWindowPtr )), Qt::QueuedConnection );
+    connect( &watcher_, SIGNAL( finished( )), this, SLOT( finished( )));
+}
+
+bool StateLoader::restore()
+{
+    // Called from the worker thread, which only reads the DisplayGroup size
+    return StateSerializationHelper( displayGroup_ ).load(
+                filename_, boost::bind( &StateLoader::windowRestored, this, _1 ));
+}
+
+void StateLoader::addWindow( ContentWindowPtr window )
+{
+    clearDisplayGroup();
+    displayGroup_->addContentWindow( window );
+}
+
+void StateLoader::finished()
+{
+    // All the windows have been queued before the future finished
+    deleteLater();
+
+    if( !watcher_.result( ))
+    {
+        put_flog( LOG_ERROR, "Could not load state file: '%s'",
+                  filename_.toLocal8Bit().constData( ));
+        emit failed( filename_ );
+        return;
+    }
+
+    // The state may not have any window
+    clearDisplayGroup();
+}
+
+void StateLoader::clearDisplayGroup()
+{
+    if( !cleared_ )
+        displayGroup_->clear();
+    cleared_ = true;
+}
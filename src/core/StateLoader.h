@@ -0,0 +1,97 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef STATELOADER_H
+#define STATELOADER_H
+
+#include "types.h"
+
+#include <QObject>
+#include <QFutureWatcher>
+
+/**
+ * Restore a state file in a DisplayGroup without blocking the caller.
+ *
+ * The file is parsed and its contents are probed in a worker thread. Each
+ * window is added to the DisplayGroup from the thread of the StateLoader as
+ * soon as it is validated, so that the windows of a large session appear one
+ * after the other. The previous windows are removed when the first new one is
+ * ready. A StateLoader deletes itself when done.
+ */
+class StateLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Start restoring a state file.
+     * @param displayGroup The DisplayGroup in which to restore the windows
+     * @param filename The xml or binary state file
+     * @return The loader, to connect to its signals before returning to the
+     *         event loop
+     */
+    static StateLoader* start( DisplayGroupPtr displayGroup,
+                               const QString& filename );
+
+signals:
+    /**
+     * Emitted when the state file could not be loaded.
+     * @param filename The state file.
+     */
+    void failed( QString filename );
+
+    /** Emitted from the worker thread for each window. */
+    void windowRestored( ContentWindowPtr window );
+
+private slots:
+    void addWindow( ContentWindowPtr window );
+    void finished();
+
+private:
+    StateLoader( DisplayGroupPtr displayGroup, const QString& filename );
+
+    DisplayGroupPtr displayGroup_;
+    QString filename_;
+    bool cleared_;
+    QFutureWatcher< bool > watcher_;
+
+    bool restore();
+    void clearDisplayGroup();
+};
+
+#endif // STATELOADER_H
@@ -41,6 +41,7 @@
 
 #include <QRectF>
 
+#include "BinaryStateFile.h"
 #include "ContentWindow.h"
 #include "log.h"
 
@@ -78,9 +79,10 @@ QString StatePreview::previewFilename() const
 {
     QFileInfo fileinfo( dcxFileName_ );
 
-    if ( fileinfo.suffix().toLower() != "dcx" )
+    const QString& suffix = fileinfo.suffix().toLower();
+    if ( suffix != "dcx" && suffix != BinaryStateFile::getFileExtension( ))
     {
-        put_flog( LOG_WARN, "wrong state file extension (expected .dcx)" );
+        put_flog( LOG_WARN, "wrong state file extension (expected .dcx or .dcxb)" );
         return QString();
     }
     return fileinfo.path() + "/" + fileinfo.completeBaseName() + getFileExtension();
@@ -41,17 +41,163 @@
 
 #include "State.h"
 #include "StatePreview.h"
+#include "BinaryStateFile.h"
 #include "DisplayGroup.h"
 #include "ContentFactory.h"
 
 #include "log.h"
 
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QThread>
+#include <QtConcurrentRun>
+
+#include <deque>
 #include <fstream>
+#include <boost/bind.hpp>
 #include <boost/foreach.hpp>
 #include <boost/archive/xml_iarchive.hpp>
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_archive_exception.hpp>
 
+namespace
+{
+// Called from a worker thread, the content is not shared until it returns
+bool readMetadata( ContentPtr content )
+{
+    return content->readMetadata();
+}
+
+bool isRestorable( const ContentWindow& contentWindow )
+{
+    if( !contentWindow.getContent( ))
+    {
+        put_flog( LOG_WARN, "Window '%s' does not have a Content.",
+                  contentWindow.getID().toString().toStdString().c_str( ));
+        return false;
+    }
+    // PixelStreams are not supported yet, don't restore them.
+    // This feature will be implemented in DISCL-6
+    return contentWindow.getContent()->getType() != CONTENT_TYPE_PIXEL_STREAM;
+}
+
+/**
+ * Give the objects of a window to the thread of the application.
+ *
+ * Windows loaded in a worker thread would otherwise keep their affinity with
+ * it. Their connections to each other (content actions, modified signals...)
+ * are then queued to a thread without event loop and never delivered.
+ * The actions of a Content are children of its ContentActionsModel and move
+ * with it.
+ */
+void moveToApplicationThread( ContentWindow& window )
+{
+    QCoreApplication* application = QCoreApplication::instance();
+    if( !application || window.thread() == application->thread( ))
+        return;
+
+    window.moveToThread( application->thread( ));
+    ContentPtr content = window.getContent();
+    content->moveToThread( application->thread( ));
+    content->getActions()->moveToThread( application->thread( ));
+}
+
+void appendWindow( ContentWindowPtrs* contentWindows, ContentWindowPtr window )
+{
+    contentWindows->push_back( window );
+}
+
+/**
+ * Replace the windows of a DisplayGroup one at a time. The previous windows
+ * are only removed when the first new one is available, so that an invalid
+ * file leaves the DisplayGroup untouched.
+ */
+class WindowAdder
+{
+public:
+    explicit WindowAdder( DisplayGroup& displayGroup )
+        : displayGroup_( displayGroup )
+        , cleared_( false )
+    {}
+
+    void operator()( ContentWindowPtr window )
+    {
+        clear();
+        displayGroup_.addContentWindow( window );
+    }
+
+    void clear()
+    {
+        if( !cleared_ )
+            displayGroup_.clear();
+        cleared_ = true;
+    }
+
+private:
+    DisplayGroup& displayGroup_;
+    bool cleared_;
+};
+
+/**
+ * Refresh content information, files can have been modified or removed
+ * since the state was saved. The contents are probed in parallel as soon as
+ * their window is known, which hides most of the latency of network file
+ * systems. The windows are handed over in their original order as soon as
+ * they and all the preceding ones are probed.
+ */
+class ContentProber
+{
+public:
+    explicit ContentProber( const StateSerializationHelper::WindowHandler& handler )
+        : handler_( handler )
+    {}
+
+    void operator()( ContentWindowPtr contentWindow )
+    {
+        if( !isRestorable( *contentWindow ))
+            return;
+
+        contentWindows_.push_back( contentWindow );
+        probes_.push_back( QtConcurrent::run( readMetadata,
+                                              contentWindow->getContent( )));
+        flush( false );
+    }
+
+    /** Wait for all the remaining probes. */
+    void finish()
+    {
+        flush( true );
+    }
+
+private:
+    StateSerializationHelper::WindowHandler handler_;
+    std::deque< ContentWindowPtr > contentWindows_;
+    std::deque< QFuture< bool > > probes_;
+
+    void flush( const bool wait )
+    {
+        while( !probes_.empty() && ( wait || probes_.front().isFinished( )))
+        {
+            ContentWindowPtr window = contentWindows_.front();
+            // Replace invalid contents by error ones
+            if( !probes_.front().result( ))
+                window->setContent( ContentFactory::getErrorContent( ));
+
+            contentWindows_.pop_front();
+            probes_.pop_front();
+            moveToApplicationThread( *window );
+            handler_( window );
+        }
+    }
+};
+
+bool isBinaryFilename( const QString& filename )
+{
+    const QString& extension = QFileInfo( filename ).suffix().toLower();
+    return extension == BinaryStateFile::getFileExtension();
+}
+}
+
 StateSerializationHelper::StateSerializationHelper( DisplayGroupPtr displayGroup )
     : displayGroup_( displayGroup )
 {
@@ -70,24 +216,71 @@ bool StateSerializationHelper::save( const QString& filename, const bool generat
         filePreview.saveToFile();
     }
 
-    // serialize state
-    std::ofstream ofs( filename.toStdString( ));
-    if ( !ofs.good( ))
+    return write( filename, contentWindows );
+}
+
+bool StateSerializationHelper::load( const QString& filename )
+{
+    WindowAdder adder( *displayGroup_ );
+    if( !load( filename, boost::ref( adder )))
         return false;
 
-    // brace this so destructor is called on archive before we use the stream
+    // The state may not have any window
+    adder.clear();
+    return true;
+}
+
+bool StateSerializationHelper::load( const QString& filename,
+                                     ContentWindowPtrs& contentWindows ) const
+{
+    ContentWindowPtrs windows;
+    if( !load( filename, boost::bind( appendWindow, &windows, _1 )))
+        return false;
+
+    contentWindows = windows;
+    return true;
+}
+
+bool StateSerializationHelper::load( const QString& filename,
+                                     const WindowHandler& handler ) const
+{
+    ContentProber prober( handler );
+
+    if( BinaryStateFile::canRead( filename ))
     {
-        State state( contentWindows );
-        boost::archive::xml_oarchive oa( ofs );
-        oa << BOOST_SERIALIZATION_NVP( state );
+        // Start probing each content while the rest of the file is parsed
+        const bool success = BinaryStateFile::load( filename,
+                                                    boost::ref( prober ));
+        prober.finish();
+        return success;
     }
-    ofs.close();
 
+    ContentWindowPtrs contentWindows;
+    if( !read( filename, contentWindows ))
+        return false;
+
+    BOOST_FOREACH( ContentWindowPtr contentWindow, contentWindows )
+        prober( contentWindow );
+    prober.finish();
     return true;
 }
 
-bool StateSerializationHelper::load( const QString& filename )
+bool StateSerializationHelper::convert( const QString& input,
+                                        const QString& output )
 {
+    ContentWindowPtrs contentWindows;
+    if( !read( input, contentWindows ))
+        return false;
+    return write( output, contentWindows );
+}
+
+bool StateSerializationHelper::read( const QString& filename,
+                                     ContentWindowPtrs& contentWindows ) const
+{
+    if( BinaryStateFile::canRead( filename ))
+        return BinaryStateFile::load( filename, boost::bind( appendWindow,
+                                                             &contentWindows,
+                                                             _1 ));
     State state;
 
     // For backward compatibility, try to load the file as a legacy state file first
@@ -117,12 +310,31 @@ bool StateSerializationHelper::load( const QString& filename )
         ifs.close();
     }
 
-    ContentWindowPtrs contentWindows = state.getContentWindows();
+    contentWindows = state.getContentWindows();
     if( state.getVersion() < FIRST_PIXEL_COORDINATES_FILE_VERSION )
         scaleToDisplayGroup( contentWindows );
-    validate( contentWindows );
+    return true;
+}
+
+bool StateSerializationHelper::write( const QString& filename,
+                                      const ContentWindowPtrs& contentWindows ) const
+{
+    if( isBinaryFilename( filename ))
+        return BinaryStateFile::save( filename, contentWindows );
+
+    // serialize state
+    std::ofstream ofs( filename.toStdString( ));
+    if ( !ofs.good( ))
+        return false;
+
+    // brace this so destructor is called on archive before we use the stream
+    {
+        State state( contentWindows );
+        boost::archive::xml_oarchive oa( ofs );
+        oa << BOOST_SERIALIZATION_NVP( state );
+    }
+    ofs.close();
 
-    displayGroup_->setContentWindows( contentWindows );
     return true;
 }
 
@@ -140,36 +352,3 @@ void StateSerializationHelper::scaleToDisplayGroup( ContentWindowPtrs&
                                         norm.height() * group.height( )));
     }
 }
-
-void StateSerializationHelper::validate(ContentWindowPtrs& contentWindows) const
-{
-    ContentWindowPtrs validContentWindows;
-    validContentWindows.reserve( contentWindows.size( ));
-
-    BOOST_FOREACH( ContentWindowPtr contentWindow, contentWindows )
-    {
-        if( !contentWindow->getContent( ))
-        {
-            put_flog( LOG_WARN, "Window '%s' does not have a Content.",
-                      contentWindow->getID().toString().toStdString().c_str( ));
-            continue;
-        }
-        // PixelStreams are not supported yet, don't restore them.
-        // This feature will be implemented in DISCL-6
-        if( isPixelStream( *contentWindow ))
-            continue;
-
-        // Refresh content information, files can have been modified or removed
-        // since the state was saved.
-        if ( !contentWindow->getContent()->readMetadata( ))
-            contentWindow->setContent( ContentFactory::getErrorContent( ));
-
-        validContentWindows.push_back( contentWindow );
-    }
-    contentWindows = validContentWindows;
-}
-
-bool StateSerializationHelper::isPixelStream( const ContentWindow& contentWindow ) const
-{
-    return contentWindow.getContent()->getType() == CONTENT_TYPE_PIXEL_STREAM;
-}
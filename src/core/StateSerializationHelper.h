@@ -44,12 +44,17 @@
 
 #include "types.h"
 
+#include <boost/function.hpp>
+
 /**
  * Helper class to store the current session to a state file and restore it later.
  */
 class StateSerializationHelper
 {
 public:
+    /** Called for each window of a state file once its content is validated. */
+    typedef boost::function< void( ContentWindowPtr ) > WindowHandler;
+
     /**
      * Constructor
      *
@@ -60,22 +65,55 @@ public:
     /**
      * Save the state of the application.
      *
-     * @param filename The .dcx file to save the state.
+     * @param filename The .dcx file to save the state, or a .dcxb file to
+     *        save it in the binary format.
      * @param generatePreview Also generate a .dcxpreview thumbnail image for the state.
      */
     bool save( const QString& filename, const bool generatePreview = true );
 
     /**
-     * Load the state from a given xml file.
+     * Load the state from a given xml or binary file.
+     *
+     * The windows replace those of the DisplayGroup one at a time, as soon as
+     * their content is validated, so that the walls can start loading them
+     * while the rest of the file is processed.
      */
     bool load( const QString& filename );
 
+    /**
+     * Load and validate the windows of a state file one at a time.
+     *
+     * The contents of binary files are probed in parallel while the file is
+     * parsed. Can be called from a worker thread.
+     * @param filename The xml or binary state file.
+     * @param handler Called for each valid window, in the order of the file.
+     */
+    bool load( const QString& filename, const WindowHandler& handler ) const;
+
+    /**
+     * Load and validate the windows of a state file without showing them.
+     * @param filename The xml or binary state file.
+     * @param contentWindows Receives the windows of the state.
+     */
+    bool load( const QString& filename, ContentWindowPtrs& contentWindows ) const;
+
+    /**
+     * Convert a state file to another format without restoring it.
+     *
+     * The output format is chosen from its extension (.dcx or .dcxb). The
+     * contents are not validated, so that files can be converted on a
+     * machine which does not have access to them. Legacy files are scaled to
+     * the size of the DisplayGroup.
+     */
+    bool convert( const QString& input, const QString& output );
+
 private:
     DisplayGroupPtr displayGroup_;
 
+    bool read( const QString& filename, ContentWindowPtrs& contentWindows ) const;
+    bool write( const QString& filename,
+                const ContentWindowPtrs& contentWindows ) const;
     void scaleToDisplayGroup( ContentWindowPtrs& contentWindows ) const;
-    void validate( ContentWindowPtrs& contentWindows ) const;
-    bool isPixelStream( const ContentWindow& contentWindow ) const;
 };
 
 #endif // STATESERIALIZATIONHELPER_H
@@ -40,9 +40,19 @@
 #include "log.h"
 
 #include <QImageReader>
+#include <QtConcurrentRun>
+
+namespace
+{
+QImage loadImage(const QString uri)
+{
+    return QImage(uri);
+}
+}
 
 Texture::Texture(const QString uri)
     : uri_( uri )
+    , preloading_( false )
 {
     const QImageReader imageReader(uri_);
     if(!imageReader.canRead())
@@ -59,7 +69,10 @@ Texture::~Texture()
 
 bool Texture::generateTexture()
 {
-    const QImage image(uri_);
+    const QImage image = preloading_ ? preloadedImage_.result() : QImage(uri_);
+    preloading_ = false;
+    preloadedImage_ = QFuture<QImage>();
+
     if(image.isNull())
     {
         put_flog(LOG_ERROR, "error loading %s", uri_.toLocal8Bit().constData());
@@ -69,6 +82,24 @@ bool Texture::generateTexture()
     return texture_.init(image, GL_BGRA, true);
 }
 
+bool Texture::preload()
+{
+    if(texture_.isValid())
+        return true;
+
+    if(!preloading_)
+    {
+        preloadedImage_ = QtConcurrent::run(loadImage, uri_);
+        preloading_ = true;
+    }
+
+    if(!preloadedImage_.isFinished())
+        return false;
+
+    generateTexture();
+    return true;
+}
+
 void Texture::render(const QRectF& texCoords)
 {
     if(!texture_.isValid() && !generateTexture())
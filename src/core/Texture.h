@@ -43,6 +43,9 @@
 #include "GLTexture2D.h"
 #include "GLQuad.h"
 
+#include <QFuture>
+#include <QImage>
+
 class Texture : public FactoryObject
 {
 public:
@@ -51,10 +54,16 @@ public:
 
     void render(const QRectF& texCoords) override;
 
+    /** Decode the image in a worker thread, then upload it. */
+    bool preload() override;
+
 private:
     QString uri_;
     QSize imageSize_;
 
+    QFuture<QImage> preloadedImage_;
+    bool preloading_;
+
     GLTexture2D texture_;
     GLQuad quad_;
 
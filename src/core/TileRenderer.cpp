@@ -0,0 +1,160 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "TileRenderer.h"
+
+#include <QtConcurrentRun>
+
+#include <algorithm>
+
+#define MAX_QUEUED_REQUESTS 64
+
+namespace
+{
+bool isFinished(const QFuture<void>& future)
+{
+    return future.isFinished();
+}
+}
+
+TileRenderer::TileRenderer(const RenderFunction& renderFunction,
+                           const unsigned int maxWorkers)
+    : renderFunction_(renderFunction)
+    , maxWorkers_(std::max(maxWorkers, 1u))
+    , runningWorkers_(0)
+    , stopping_(false)
+{
+}
+
+TileRenderer::~TileRenderer()
+{
+    {
+        const QMutexLocker lock(&queueMutex_);
+        stopping_ = true;
+        queue_.clear();
+    }
+    for (size_t i = 0; i < workers_.size(); ++i)
+        workers_[i].waitForFinished();
+}
+
+void TileRenderer::request(const TileIndex& index, const bool prefetch)
+{
+    const QMutexLocker lock(&queueMutex_);
+
+    if (stopping_ || requested_.count(index) || renderedTiles_.count(index))
+        return;
+
+    if (prefetch)
+    {
+        if (queue_.size() >= MAX_QUEUED_REQUESTS)
+            return;
+        queue_.push_back(index);
+    }
+    else
+    {
+        queue_.push_front(index);
+        if (queue_.size() > MAX_QUEUED_REQUESTS)
+        {
+            requested_.erase(queue_.back());
+            queue_.pop_back();
+        }
+    }
+    requested_.insert(index);
+
+    // One more worker as long as there are requests for it to process
+    if (runningWorkers_ < maxWorkers_ && runningWorkers_ < queue_.size())
+    {
+        ++runningWorkers_;
+        workers_.erase(std::remove_if(workers_.begin(), workers_.end(),
+                                      isFinished), workers_.end());
+        workers_.push_back(QtConcurrent::run(this,
+                                             &TileRenderer::processRequests));
+    }
+}
+
+void TileRenderer::cancelPendingRequests(const int firstPage,
+                                         const int lastPage)
+{
+    const QMutexLocker lock(&queueMutex_);
+
+    std::deque<TileIndex>::iterator it = queue_.begin();
+    while (it != queue_.end())
+    {
+        if (it->page < firstPage || it->page > lastPage)
+        {
+            requested_.erase(*it);
+            it = queue_.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+TileRenderer::TileImages TileRenderer::takeRenderedTiles()
+{
+    TileImages tiles;
+
+    const QMutexLocker lock(&queueMutex_);
+    tiles.swap(renderedTiles_);
+    return tiles;
+}
+
+void TileRenderer::processRequests()
+{
+    while (true)
+    {
+        TileIndex index;
+        {
+            const QMutexLocker lock(&queueMutex_);
+            if (queue_.empty() || stopping_)
+            {
+                --runningWorkers_;
+                return;
+            }
+            index = queue_.front();
+            queue_.pop_front();
+        }
+
+        const QImage image = renderFunction_(index);
+
+        const QMutexLocker lock(&queueMutex_);
+        requested_.erase(index);
+        if (!image.isNull())
+            renderedTiles_[index] = image;
+    }
+}
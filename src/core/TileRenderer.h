@@ -0,0 +1,122 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef TILERENDERER_H
+#define TILERENDERER_H
+
+#include "PyramidTiling.h"
+
+#include <QFuture>
+#include <QImage>
+#include <QMutex>
+
+#include <boost/function/function1.hpp>
+#include <boost/noncopyable.hpp>
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+/**
+ * Rasterize tiles in a background thread.
+ *
+ * Requests are processed last-in first-out, so that the tiles for the current
+ * view are rendered before the ones requested for previous frames. The oldest
+ * requests are dropped when too many accumulate, for instance while panning.
+ * Prefetch requests are only processed once all the other ones are done.
+ *
+ * Each renderer uses its own worker threads from the global QThreadPool, so
+ * that different contents are rasterized in parallel. A renderer whose
+ * RenderFunction is reentrant can also use several workers, for instance to
+ * rasterize the tiles needed by several GLWindows at once.
+ */
+class TileRenderer : public boost::noncopyable
+{
+public:
+    typedef std::map<TileIndex, QImage> TileImages;
+
+    /** Render a tile, called from the worker thread. */
+    typedef boost::function<QImage(const TileIndex&)> RenderFunction;
+
+    /**
+     * Constructor.
+     * @param renderFunction The function which rasterizes a tile
+     * @param maxWorkers The maximum number of tiles rendered concurrently,
+     *        more than one only if renderFunction is reentrant
+     */
+    explicit TileRenderer(const RenderFunction& renderFunction,
+                          const unsigned int maxWorkers = 1);
+
+    /** Destructor, waits for the tiles being rendered. */
+    ~TileRenderer();
+
+    /**
+     * Request the rendering of a tile.
+     * Does nothing if the tile is already queued or being rendered.
+     * @param index The tile to render
+     * @param prefetch Render the tile with the lowest priority, only if the
+     *        queue is not full
+     */
+    void request(const TileIndex& index, const bool prefetch = false);
+
+    /**
+     * Drop the requests which have not started yet.
+     * @param firstPage The first page for which to keep the requests
+     * @param lastPage The last page for which to keep the requests
+     */
+    void cancelPendingRequests(const int firstPage, const int lastPage);
+
+    /** @return the tiles rendered since the previous call. */
+    TileImages takeRenderedTiles();
+
+private:
+    RenderFunction renderFunction_;
+    const unsigned int maxWorkers_;
+
+    QMutex queueMutex_;
+    std::deque<TileIndex> queue_;
+    std::set<TileIndex> requested_;
+    TileImages renderedTiles_;
+    unsigned int runningWorkers_;
+    bool stopping_;
+    std::vector< QFuture<void> > workers_;
+
+    void processRequests();
+};
+
+#endif // TILERENDERER_H
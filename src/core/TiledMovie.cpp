@@ -0,0 +1,202 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "TiledMovie.h"
+
+#include "Movie.h"
+#include "RenderContext.h"
+#include "WallToWallChannel.h"
+
+#include <algorithm>
+
+// Hidden tiles are closed after this delay, or beyond this number
+#define HIDDEN_TILE_RELEASE_DELAY_MS 10000
+#define MAX_HIDDEN_TILES 4
+
+TiledMovie::TiledMovie(const QString& uri)
+    : scheduler_(new PresentationScheduler)
+    , zoomRect_(0.0, 0.0, 1.0, 1.0)
+    , skippedLastFrame_(true)
+{
+    manifest_.load(uri);
+    tiles_.resize(manifest_.getTiles().size());
+    visible_.resize(tiles_.size(), false);
+    lastVisible_.resize(tiles_.size());
+}
+
+TiledMovie::~TiledMovie()
+{
+}
+
+void TiledMovie::preRenderUpdate(const QRectF& windowRect, const QRectF& zoomRect,
+                                 WallToWallChannel& wallToWallChannel)
+{
+    zoomRect_ = zoomRect;
+
+    // Keep the clock running even if no tile is open on this process
+    scheduler_->update(wallToWallChannel.getTime());
+
+    skippedLastFrame_ = true;
+
+    const boost::posix_time::ptime now = wallToWallChannel.getTime();
+    const MovieTiles& tiles = manifest_.getTiles();
+    for(size_t i = 0; i < tiles.size(); ++i)
+    {
+        const QRectF region = getVisibleRegion(tiles[i]);
+        visible_[i] = !region.isEmpty() &&
+              renderContext_->isRegionVisible(getSceneCoordinates(region, windowRect));
+
+        // Hidden tiles are not decoded, they seek when they become visible
+        if(!visible_[i])
+            continue;
+
+        lastVisible_[i] = now;
+        if(!tiles_[i])
+            tiles_[i] = openTile(tiles[i]);
+
+        tiles_[i]->preRenderUpdate(wallToWallChannel);
+        skippedLastFrame_ = false;
+    }
+
+    releaseHiddenTiles(now);
+}
+
+void TiledMovie::render(const QRectF& texCoords)
+{
+    const MovieTiles& tiles = manifest_.getTiles();
+    for(size_t i = 0; i < tiles.size(); ++i)
+    {
+        if(!tiles_[i] || !visible_[i])
+            continue;
+
+        const QRectF tileRect = manifest_.getNormalizedRegion(tiles[i]);
+        const QRectF region = tileRect.intersected(texCoords);
+        if(region.isEmpty())
+            continue;
+
+        // The part of the tile to render, in the tile's texture coordinates
+        const QRectF tileTexCoords((region.x() - tileRect.x()) / tileRect.width(),
+                                   (region.y() - tileRect.y()) / tileRect.height(),
+                                   region.width() / tileRect.width(),
+                                   region.height() / tileRect.height());
+
+        // Position the tile in the unit square where the window is rendered
+        glPushMatrix();
+        glTranslatef((region.x() - texCoords.x()) / texCoords.width(),
+                     (region.y() - texCoords.y()) / texCoords.height(), 0.f);
+        glScalef(region.width() / texCoords.width(),
+                 region.height() / texCoords.height(), 1.f);
+
+        tiles_[i]->render(tileTexCoords);
+
+        glPopMatrix();
+    }
+}
+
+void TiledMovie::setPause(const bool pause)
+{
+    scheduler_->setPaused(pause);
+}
+
+void TiledMovie::setLoop(const bool loop)
+{
+    scheduler_->setLoop(loop);
+}
+
+bool TiledMovie::hasSkippedLastFrame() const
+{
+    return skippedLastFrame_;
+}
+
+PresentationSchedulerPtr TiledMovie::getScheduler() const
+{
+    return scheduler_;
+}
+
+MoviePtr TiledMovie::openTile(const MovieTile& tile)
+{
+    MoviePtr movie(new Movie(tile.uri));
+    movie->setRenderContext(renderContext_);
+    movie->setScheduler(scheduler_);
+    return movie;
+}
+
+void TiledMovie::releaseHiddenTiles(const boost::posix_time::ptime& now)
+{
+    const boost::posix_time::time_duration releaseDelay =
+            boost::posix_time::milliseconds(HIDDEN_TILE_RELEASE_DELAY_MS);
+
+    // Sorted from the most to the least recently visible
+    std::vector< std::pair<boost::posix_time::ptime, size_t> > hiddenTiles;
+    for(size_t i = 0; i < tiles_.size(); ++i)
+    {
+        if(!tiles_[i] || visible_[i])
+            continue;
+
+        if(now - lastVisible_[i] > releaseDelay)
+            tiles_[i].reset();
+        else
+            hiddenTiles.push_back(std::make_pair(lastVisible_[i], i));
+    }
+
+    if(hiddenTiles.size() <= MAX_HIDDEN_TILES)
+        return;
+
+    std::sort(hiddenTiles.rbegin(), hiddenTiles.rend());
+    for(size_t i = MAX_HIDDEN_TILES; i < hiddenTiles.size(); ++i)
+        tiles_[hiddenTiles[i].second].reset();
+}
+
+QRectF TiledMovie::getVisibleRegion(const MovieTile& tile) const
+{
+    return manifest_.getNormalizedRegion(tile).intersected(zoomRect_);
+}
+
+QRectF TiledMovie::getSceneCoordinates(const QRectF& region,
+                                       const QRectF& windowRect) const
+{
+    // Map the region from movie to window coordinates, taking the zoom into account
+    const qreal x = (region.x() - zoomRect_.x()) / zoomRect_.width();
+    const qreal y = (region.y() - zoomRect_.y()) / zoomRect_.height();
+    const qreal w = region.width() / zoomRect_.width();
+    const qreal h = region.height() / zoomRect_.height();
+
+    return QRectF(windowRect.x() + x * windowRect.width(),
+                  windowRect.y() + y * windowRect.height(),
+                  w * windowRect.width(), h * windowRect.height());
+}
@@ -0,0 +1,120 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef TILEDMOVIE_H
+#define TILEDMOVIE_H
+
+#include "FactoryObject.h"
+#include "PresentationScheduler.h"
+#include "TiledMovieManifest.h"
+#include "types.h"
+
+#include <QRectF>
+#include <QString>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <vector>
+
+class WallToWallChannel;
+
+/**
+ * Play a movie made of a grid of movie files.
+ *
+ * Each wall process only opens and decodes the tiles which are visible on its
+ * screens. Tiles which leave the view stay open for a while, so that panning
+ * and zooming back and forth does not reopen them on the render thread. All
+ * the tiles share a single PresentationScheduler and are thus frame-locked to
+ * each other and to the wall clock.
+ */
+class TiledMovie : public FactoryObject
+{
+public:
+    /**
+     * Constructor.
+     * @param uri The TiledMovieManifest file
+     */
+    TiledMovie(const QString& uri);
+
+    /** Destructor */
+    ~TiledMovie();
+
+    /** Render the visible tiles. */
+    void render(const QRectF& texCoords) override;
+
+    /** Pause or resume all the tiles. */
+    void setPause(const bool pause);
+
+    /** Loop all the tiles at the end of the movie. */
+    void setLoop(const bool loop);
+
+    /**
+     * Open the tiles which became visible, close those hidden for too long,
+     * and decode.
+     * @param windowRect The coordinates of the window on the wall
+     * @param zoomRect The zoomed region of the movie, in normalized coordinates
+     * @param wallToWallChannel The channel providing the wall clock
+     */
+    void preRenderUpdate(const QRectF& windowRect, const QRectF& zoomRect,
+                         WallToWallChannel& wallToWallChannel);
+
+    /** Did this process skip decoding the last frame (no visible tile). */
+    bool hasSkippedLastFrame() const;
+
+    /** Get the scheduler shared by all the tiles. */
+    PresentationSchedulerPtr getScheduler() const;
+
+private:
+    TiledMovieManifest manifest_;
+    PresentationSchedulerPtr scheduler_;
+
+    // One entry per tile of the manifest, null when the tile is not open
+    MoviePtrs tiles_;
+    std::vector<bool> visible_;
+    std::vector<boost::posix_time::ptime> lastVisible_;
+
+    QRectF zoomRect_;
+    bool skippedLastFrame_;
+
+    MoviePtr openTile(const MovieTile& tile);
+    void releaseHiddenTiles(const boost::posix_time::ptime& now);
+    QRectF getVisibleRegion(const MovieTile& tile) const;
+    QRectF getSceneCoordinates(const QRectF& region, const QRectF& windowRect) const;
+};
+
+#endif // TILEDMOVIE_H
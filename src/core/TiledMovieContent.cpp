@@ -0,0 +1,155 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "TiledMovieContent.h"
+
+#include "ContentWindow.h"
+#include "Factories.h"
+#include "TiledMovie.h"
+#include "TiledMovieManifest.h"
+
+#include <QDataStream>
+
+#include <boost/serialization/export.hpp>
+BOOST_CLASS_EXPORT_GUID( TiledMovieContent, "TiledMovieContent" )
+
+namespace
+{
+const QString ICON_PAUSE( "qrc:///img/pause.svg" );
+const QString ICON_PLAY( "qrc:///img/play.svg" );
+}
+
+TiledMovieContent::TiledMovieContent( const QString& uri )
+    : Content( uri )
+    , controlState_( STATE_LOOP )
+{
+    createActions();
+}
+
+TiledMovieContent::TiledMovieContent()
+    : controlState_( STATE_LOOP )
+{
+}
+
+CONTENT_TYPE TiledMovieContent::getType()
+{
+    return CONTENT_TYPE_TILED_MOVIE;
+}
+
+bool TiledMovieContent::readMetadata()
+{
+    TiledMovieManifest manifest;
+    if( !manifest.load( getURI( )))
+        return false;
+
+    size_ = manifest.getSize();
+    return true;
+}
+
+const QStringList& TiledMovieContent::getSupportedExtensions()
+{
+    static QStringList extensions;
+
+    if( extensions.empty( ))
+        extensions << "tiledmovie";
+
+    return extensions;
+}
+
+void TiledMovieContent::preRenderUpdate( Factories& factories, ContentWindowPtr window,
+                                         WallToWallChannel& wallToWallChannel )
+{
+    // Stop decoding when the window is moving to avoid saccades when reaching a new GLWindow
+    // The decoding resumes when the movement is finished
+    if( !window || window->isMoving() || window->isResizing( ))
+        return;
+
+    boost::shared_ptr< TiledMovie > movie =
+            factories.getTiledMovieFactory().getObject( uri_ );
+
+    movie->setPause( controlState_ & STATE_PAUSED );
+    movie->setLoop( controlState_ & STATE_LOOP );
+
+    movie->preRenderUpdate( window->getCoordinates(), window->getZoomRect(),
+                            wallToWallChannel );
+}
+
+void TiledMovieContent::postRenderUpdate( Factories& factories, ContentWindowPtr window,
+                                          WallToWallChannel& )
+{
+    if( !window || window->isMoving() || window->isResizing( ))
+        return;
+
+    boost::shared_ptr< TiledMovie > movie =
+            factories.getTiledMovieFactory().getObject( uri_ );
+
+    factories.getMovieClock().add( movie->getScheduler(), movie->hasSkippedLastFrame( ));
+}
+
+void TiledMovieContent::play()
+{
+    controlState_ = (ControlState)(controlState_ & ~STATE_PAUSED);
+}
+
+void TiledMovieContent::pause()
+{
+    controlState_ = (ControlState)(controlState_ | STATE_PAUSED);
+}
+
+void TiledMovieContent::createActions()
+{
+    ContentAction* playPauseAction = new ContentAction();
+    playPauseAction->setCheckable( true );
+    playPauseAction->setIcon( ICON_PAUSE );
+    playPauseAction->setIconChecked( ICON_PLAY );
+    connect( playPauseAction, SIGNAL( checked( )), this, SLOT( pause( )));
+    connect( playPauseAction, SIGNAL( unchecked( )), this, SLOT( play( )));
+    actions_.add( playPauseAction );
+}
+
+void TiledMovieContent::writeState( QDataStream& out ) const
+{
+    out << (qint32)controlState_;
+}
+
+void TiledMovieContent::readState( QDataStream& in )
+{
+    qint32 controlState = 0;
+    in >> controlState;
+    controlState_ = (ControlState)controlState;
+}
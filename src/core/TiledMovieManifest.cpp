@@ -0,0 +1,134 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "TiledMovieManifest.h"
+
+#include "log.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QXmlStreamReader>
+
+TiledMovieManifest::TiledMovieManifest()
+{
+}
+
+bool TiledMovieManifest::load(const QString& uri)
+{
+    size_ = QSize();
+    tiles_.clear();
+
+    QFile file(uri);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        put_flog(LOG_ERROR, "could not open tiled movie manifest: %s",
+                 uri.toLocal8Bit().constData());
+        return false;
+    }
+
+    const QDir baseDir = QFileInfo(uri).absoluteDir();
+    QXmlStreamReader reader(&file);
+
+    while(!reader.atEnd())
+    {
+        if(reader.readNext() != QXmlStreamReader::StartElement)
+            continue;
+
+        const QXmlStreamAttributes attributes = reader.attributes();
+
+        if(reader.name() == "tiledmovie")
+        {
+            size_ = QSize(attributes.value("width").toString().toInt(),
+                          attributes.value("height").toString().toInt());
+        }
+        else if(reader.name() == "tile")
+        {
+            MovieTile tile;
+            tile.uri = baseDir.absoluteFilePath(attributes.value("uri").toString());
+            tile.region = QRect(attributes.value("x").toString().toInt(),
+                                attributes.value("y").toString().toInt(),
+                                attributes.value("width").toString().toInt(),
+                                attributes.value("height").toString().toInt());
+            tiles_.push_back(tile);
+        }
+    }
+
+    if(reader.hasError())
+    {
+        put_flog(LOG_ERROR, "error parsing tiled movie manifest %s: %s",
+                 uri.toLocal8Bit().constData(),
+                 reader.errorString().toLocal8Bit().constData());
+        tiles_.clear();
+        return false;
+    }
+
+    const QRect movieRect(QPoint(0, 0), size_);
+    for(MovieTiles::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it)
+    {
+        if(it->region.isEmpty() || !movieRect.contains(it->region))
+        {
+            put_flog(LOG_ERROR, "invalid tile '%s' in tiled movie manifest: %s",
+                     it->uri.toLocal8Bit().constData(),
+                     uri.toLocal8Bit().constData());
+            tiles_.clear();
+            return false;
+        }
+    }
+
+    return !size_.isEmpty() && !tiles_.empty();
+}
+
+const QSize& TiledMovieManifest::getSize() const
+{
+    return size_;
+}
+
+const MovieTiles& TiledMovieManifest::getTiles() const
+{
+    return tiles_;
+}
+
+QRectF TiledMovieManifest::getNormalizedRegion(const MovieTile& tile) const
+{
+    const qreal width = size_.width();
+    const qreal height = size_.height();
+
+    return QRectF(tile.region.x() / width, tile.region.y() / height,
+                  tile.region.width() / width, tile.region.height() / height);
+}
@@ -0,0 +1,105 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef TILEDMOVIEMANIFEST_H
+#define TILEDMOVIEMANIFEST_H
+
+#include <QRect>
+#include <QRectF>
+#include <QSize>
+#include <QString>
+#include <vector>
+
+/**
+ * A movie file covering a part of a TiledMovieManifest.
+ */
+struct MovieTile
+{
+    /** The absolute path of the movie file. */
+    QString uri;
+
+    /** The region covered by the tile, in pixels of the full movie. */
+    QRect region;
+};
+typedef std::vector<MovieTile> MovieTiles;
+
+/**
+ * Describe a very high resolution movie pre-split into a grid of movie files.
+ *
+ * The manifest is an xml file of the form:
+ * @code
+ * <tiledmovie width="7680" height="2160">
+ *     <tile uri="left.mp4" x="0" y="0" width="3840" height="2160"/>
+ *     <tile uri="right.mp4" x="3840" y="0" width="3840" height="2160"/>
+ * </tiledmovie>
+ * @endcode
+ * Relative tile uris are resolved from the folder of the manifest. The tiles
+ * should not contain audio and must all have the same duration and frame rate.
+ */
+class TiledMovieManifest
+{
+public:
+    /** Create an empty manifest. */
+    TiledMovieManifest();
+
+    /**
+     * Read a manifest file.
+     * @param uri The manifest file
+     * @return false if the file could not be read or is not a valid manifest
+     */
+    bool load(const QString& uri);
+
+    /** @return The dimensions of the full movie in pixels. */
+    const QSize& getSize() const;
+
+    /** @return The movie tiles. */
+    const MovieTiles& getTiles() const;
+
+    /**
+     * Get the region covered by a tile in normalized coordinates.
+     * @param tile One of the tiles of this manifest
+     * @return The region of the tile relative to the full movie, in [0,1]
+     */
+    QRectF getNormalizedRegion(const MovieTile& tile) const;
+
+private:
+    QSize size_;
+    MovieTiles tiles_;
+};
+
+#endif // TILEDMOVIEMANIFEST_H
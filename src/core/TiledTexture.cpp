@@ -0,0 +1,315 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "TiledTexture.h"
+
+#include "GLWindow.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+// Each tile texture uses up to 1 MB of GPU memory
+#define MAX_CACHED_TILES 192
+#define MAX_TOTAL_TILE_BYTES (512 * 1024 * 1024)
+
+namespace
+{
+// Shared by all instances, so that the lastUsed values of their tiles can be
+// compared with each other. Not synchronized: TiledTextures must only be
+// created, used and destroyed in the OpenGL thread, which Factories also
+// ensures for the objects of a preloaded session.
+uint64_t useCounter = 0;
+size_t totalTileBytes = 0;
+std::set<TiledTexture*> instances;
+}
+
+TiledTexture::TiledTexture(const TileRenderer::RenderFunction& renderFunction,
+                           const unsigned int maxRenderers)
+    : renderer_(renderFunction, maxRenderers)
+{
+    instances.insert(this);
+}
+
+TiledTexture::~TiledTexture()
+{
+    while (!tiles_.empty())
+        removeTile(tiles_.begin());
+    instances.erase(this);
+}
+
+void TiledTexture::render(const QRectF& texCoords, const PyramidTiling& tiling,
+                          const int page)
+{
+    QRectF visibleRegion;
+    int level = 0;
+    if (!getVisibleRegion(texCoords, tiling, visibleRegion, level))
+        return;
+
+    uploadRenderedTiles();
+
+    // the level 0 tile is the fallback for all others, make sure it exists
+    if (!getTexture(TileIndex(page)))
+        renderer_.request(TileIndex(page));
+
+    const QRect tiles = tiling.getTilesInRegion(level, visibleRegion);
+    for (int y = tiles.top(); y <= tiles.bottom(); ++y)
+    {
+        for (int x = tiles.left(); x <= tiles.right(); ++x)
+        {
+            const TileIndex index(page, level, x, y);
+            const QRectF region = tiling.getNormalizedTileRect(index) & visibleRegion;
+            renderTile(index, tiling, region, texCoords);
+        }
+    }
+
+    pruneTiles();
+}
+
+void TiledTexture::prefetch(const QRectF& texCoords, const PyramidTiling& tiling,
+                            const int page)
+{
+    QRectF visibleRegion;
+    int level = 0;
+    if (!getVisibleRegion(texCoords, tiling, visibleRegion, level))
+        return;
+
+    // Looking up the textures also keeps them from being evicted
+    if (!getTexture(TileIndex(page)))
+        renderer_.request(TileIndex(page), true);
+
+    const QRect tiles = tiling.getTilesInRegion(level, visibleRegion);
+    for (int y = tiles.top(); y <= tiles.bottom(); ++y)
+    {
+        for (int x = tiles.left(); x <= tiles.right(); ++x)
+        {
+            const TileIndex index(page, level, x, y);
+            if (!getTexture(index))
+                renderer_.request(index, true);
+        }
+    }
+}
+
+bool TiledTexture::preload(const int page)
+{
+    uploadRenderedTiles();
+
+    // The overview is the fallback for all other tiles, so it is enough to
+    // show the page without blank areas
+    if (getTexture(TileIndex(page)))
+        return true;
+
+    renderer_.request(TileIndex(page));
+    return false;
+}
+
+void TiledTexture::cancelPendingRequests(const int firstPage, const int lastPage)
+{
+    renderer_.cancelPendingRequests(firstPage, lastPage);
+}
+
+bool TiledTexture::getVisibleRegion(const QRectF& texCoords,
+                                    const PyramidTiling& tiling,
+                                    QRectF& region, int& level) const
+{
+    // get on-screen and full rectangle corresponding to the window
+    const QRectF screenRect = GLWindow::getProjectedPixelRect(true);
+    const QRectF fullRect = GLWindow::getProjectedPixelRect(false);
+
+    // if we're not visible or we don't have a valid image, we're done...
+    if (screenRect.isEmpty() || fullRect.isEmpty() || tiling.getSize().isEmpty())
+        return false;
+
+    // figure out what visible region is for screenRect, a subregion of [0, 0, 1, 1]
+    const double xp = (screenRect.x() - fullRect.x()) / fullRect.width();
+    const double yp = (screenRect.y() - fullRect.y()) / fullRect.height();
+    const double wp = screenRect.width() / fullRect.width();
+    const double hp = screenRect.height() / fullRect.height();
+
+    // the corresponding region of the image, in normalized coordinates
+    region = QRectF(texCoords.x() + xp * texCoords.width(),
+                    texCoords.y() + yp * texCoords.height(),
+                    wp * texCoords.width(), hp * texCoords.height())
+             & QRectF(0.0, 0.0, 1.0, 1.0);
+
+    // select the zoom level matching the size of the whole image on screen
+    const QSizeF displayedSize(fullRect.width() / texCoords.width(),
+                               fullRect.height() / texCoords.height());
+    level = tiling.getLevel(displayedSize);
+
+    return !region.isEmpty();
+}
+
+void TiledTexture::uploadRenderedTiles()
+{
+    const TileRenderer::TileImages images = renderer_.takeRenderedTiles();
+
+    for (TileRenderer::TileImages::const_iterator it = images.begin();
+         it != images.end(); ++it)
+    {
+        CachedTiles::iterator existing = tiles_.find(it->first);
+        if (existing != tiles_.end())
+            removeTile(existing);
+
+        CachedTile& tile = tiles_[it->first];
+        tile.texture.reset(new GLTexture2D());
+        tile.texture->init(it->second, GL_BGRA);
+        tile.lastUsed = ++useCounter;
+        tile.bytes = it->second.byteCount();
+        totalTileBytes += tile.bytes;
+    }
+}
+
+void TiledTexture::pruneTiles()
+{
+    if (totalTileBytes > MAX_TOTAL_TILE_BYTES)
+        pruneAllTiles();
+
+    if (tiles_.size() <= MAX_CACHED_TILES)
+        return;
+
+    std::vector<uint64_t> lastUsed;
+    lastUsed.reserve(tiles_.size());
+    for (CachedTiles::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it)
+        lastUsed.push_back(it->second.lastUsed);
+
+    // Keep the most recently used tiles
+    std::nth_element(lastUsed.begin(), lastUsed.end() - MAX_CACHED_TILES,
+                     lastUsed.end());
+    const uint64_t threshold = *(lastUsed.end() - MAX_CACHED_TILES);
+
+    CachedTiles::iterator it = tiles_.begin();
+    while (it != tiles_.end())
+    {
+        if (it->second.lastUsed < threshold)
+            removeTile(it++);
+        else
+            ++it;
+    }
+}
+
+void TiledTexture::removeTile(CachedTiles::iterator it)
+{
+    totalTileBytes -= it->second.bytes;
+    tiles_.erase(it);
+}
+
+void TiledTexture::pruneAllTiles()
+{
+    typedef std::pair<uint64_t, std::pair<TiledTexture*, TileIndex> > TileUse;
+    std::vector<TileUse> tileUses;
+
+    for (std::set<TiledTexture*>::const_iterator instance = instances.begin();
+         instance != instances.end(); ++instance)
+    {
+        const CachedTiles& tiles = (*instance)->tiles_;
+        for (CachedTiles::const_iterator it = tiles.begin(); it != tiles.end(); ++it)
+            tileUses.push_back(TileUse(it->second.lastUsed,
+                                       std::make_pair(*instance, it->first)));
+    }
+
+    // Evict the least recently used tiles of all instances first
+    std::sort(tileUses.begin(), tileUses.end());
+    for (std::vector<TileUse>::const_iterator it = tileUses.begin();
+         it != tileUses.end() && totalTileBytes > MAX_TOTAL_TILE_BYTES; ++it)
+    {
+        TiledTexture* instance = it->second.first;
+        instance->removeTile(instance->tiles_.find(it->second.second));
+    }
+}
+
+GLTexture2D* TiledTexture::getTexture(const TileIndex& index)
+{
+    CachedTiles::iterator it = tiles_.find(index);
+    if (it == tiles_.end())
+        return 0;
+
+    it->second.lastUsed = ++useCounter;
+    return it->second.texture.get();
+}
+
+void TiledTexture::renderTile(const TileIndex& index, const PyramidTiling& tiling,
+                              const QRectF& region, const QRectF& texCoords)
+{
+    if (region.isEmpty())
+        return;
+
+    // Use the sharpest available tile, down to the level 0 overview
+    for (int level = index.level; level >= 0; --level)
+    {
+        const TileIndex candidate = index.getAncestor(level);
+        GLTexture2D* texture = getTexture(candidate);
+
+        if (!texture && level == index.level)
+            renderer_.request(index);
+
+        if (texture)
+        {
+            drawTexture(*texture, tiling.getNormalizedTileRect(candidate),
+                        region, texCoords);
+            return;
+        }
+    }
+}
+
+void TiledTexture::drawTexture(GLTexture2D& texture, const QRectF& tileRect,
+                               const QRectF& region, const QRectF& texCoords)
+{
+    // The part of the tile texture covering the region
+    quad_.setTexCoords(QRectF((region.x() - tileRect.x()) / tileRect.width(),
+                              (region.y() - tileRect.y()) / tileRect.height(),
+                              region.width() / tileRect.width(),
+                              region.height() / tileRect.height()));
+
+    // Position of the region inside the window
+    glPushMatrix();
+
+    glTranslatef((region.x() - texCoords.x()) / texCoords.width(),
+                 (region.y() - texCoords.y()) / texCoords.height(), 0);
+    glScalef(region.width() / texCoords.width(),
+             region.height() / texCoords.height(), 1.f);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT);
+
+    texture.bind();
+    quad_.render();
+
+    glPopAttrib();
+
+    glPopMatrix();
+}
@@ -0,0 +1,142 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef TILEDTEXTURE_H
+#define TILEDTEXTURE_H
+
+#include "GLQuad.h"
+#include "GLTexture2D.h"
+#include "PyramidTiling.h"
+#include "TileRenderer.h"
+
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <map>
+#include <stdint.h>
+
+/**
+ * Display a vector image as a pyramid of tiles.
+ *
+ * The tiles are rasterized asynchronously by a TileRenderer and kept in a
+ * texture cache. Until the tiles matching the current zoom level are ready,
+ * the corresponding area is drawn from lower resolution tiles. Only the tiles
+ * intersecting the visible part of the current GLWindow are requested.
+ *
+ * The OpenGL contexts of a process are shared, so the cached tiles are used by
+ * all its GLWindows. The cache of each instance is limited in number of tiles,
+ * and the total size of the tiles of all instances is limited as well; the
+ * least recently used tiles of any instance are evicted first.
+ * Instances must be created, used and destroyed in the OpenGL thread.
+ */
+class TiledTexture : public boost::noncopyable
+{
+public:
+    /**
+     * Constructor.
+     * @param renderFunction The function which rasterizes a tile
+     * @param maxRenderers The maximum number of tiles rasterized concurrently
+     * @see TileRenderer
+     */
+    explicit TiledTexture(const TileRenderer::RenderFunction& renderFunction,
+                          const unsigned int maxRenderers = 1);
+
+    /** Destructor */
+    ~TiledTexture();
+
+    /**
+     * Render the visible part of an image in the current GLWindow.
+     * @param texCoords The region of the image to render in the unit square
+     * @param tiling The tiling of the image
+     * @param page The page of the image to render
+     */
+    void render(const QRectF& texCoords, const PyramidTiling& tiling,
+                const int page = 0);
+
+    /**
+     * Request, with a low priority, the tiles that render() would display for
+     * another page of the image.
+     * @param texCoords The region of the image to render in the unit square
+     * @param tiling The tiling of the prefetched page
+     * @param page The page to prefetch
+     */
+    void prefetch(const QRectF& texCoords, const PyramidTiling& tiling,
+                  const int page);
+
+    /**
+     * Rasterize and upload the overview tile of a page ahead of rendering.
+     * @param page The page to preload
+     * @return true once the overview tile is in the texture cache
+     */
+    bool preload(const int page);
+
+    /**
+     * Drop the requests which have not started yet.
+     * @param firstPage The first page for which to keep the requests
+     * @param lastPage The last page for which to keep the requests
+     */
+    void cancelPendingRequests(const int firstPage, const int lastPage);
+
+private:
+    TileRenderer renderer_;
+
+    struct CachedTile
+    {
+        boost::shared_ptr<GLTexture2D> texture;
+        uint64_t lastUsed;
+        size_t bytes;
+    };
+    typedef std::map<TileIndex, CachedTile> CachedTiles;
+    CachedTiles tiles_;
+
+    GLQuad quad_;
+
+    bool getVisibleRegion(const QRectF& texCoords, const PyramidTiling& tiling,
+                          QRectF& region, int& level) const;
+    void uploadRenderedTiles();
+    void pruneTiles();
+    void removeTile(CachedTiles::iterator it);
+    static void pruneAllTiles();
+    GLTexture2D* getTexture(const TileIndex& index);
+    void renderTile(const TileIndex& index, const PyramidTiling& tiling,
+                    const QRectF& region, const QRectF& texCoords);
+    void drawTexture(GLTexture2D& texture, const QRectF& tileRect,
+                     const QRectF& region, const QRectF& texCoords);
+};
+
+#endif // TILEDTEXTURE_H
@@ -44,6 +44,7 @@
 #include "ContentWindow.h"
 #include "Options.h"
 #include "Markers.h"
+#include "SessionPreload.h"
 #include <deflect/PixelStreamFrame.h>
 
 #define RANK0 0
@@ -74,6 +75,9 @@ void WallFromMasterChannel::receiveMessage()
     case MPI_MESSAGE_TYPE_MARKERS:
         emit received(receiveBroadcast<MarkersPtr>(mh.size));
         break;
+    case MPI_MESSAGE_TYPE_PRELOAD:
+        emit received(receiveBroadcast<SessionPreloadPtr>(mh.size));
+        break;
     case MPI_MESSAGE_TYPE_PIXELSTREAM:
         emit received(receiveBroadcast<deflect::PixelStreamFramePtr>(mh.size));
         break;
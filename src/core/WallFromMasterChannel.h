@@ -94,6 +94,13 @@ signals:
      */
     void received(MarkersPtr markers);
 
+    /**
+     * Emitted when the contents of an upcoming session were recieved
+     * @see receiveMessage()
+     * @param preload The contents to preload
+     */
+    void received(SessionPreloadPtr preload);
+
     /**
      * Emitted when a new PixelStream frame was recieved
      * @see receiveMessage()
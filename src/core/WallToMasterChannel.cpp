@@ -55,6 +55,12 @@ void WallToMasterChannel::sendRequestFrame(const QString uri)
     mpiChannel_->send(MPI_MESSAGE_TYPE_REQUEST_FRAME, data, 0);
 }
 
+void WallToMasterChannel::sendPreloadFinished(const unsigned int id)
+{
+    const std::string& data = SerializeBuffer::serialize(id);
+    mpiChannel_->send(MPI_MESSAGE_TYPE_PRELOAD_FINISHED, data, 0);
+}
+
 void WallToMasterChannel::sendQuit()
 {
     mpiChannel_->send(MPI_MESSAGE_TYPE_QUIT, "", 0);
@@ -62,6 +62,12 @@ public slots:
      */
     void sendRequestFrame(const QString uri);
 
+    /**
+     * Send a message telling that all wall processes have preloaded a session
+     * @param id The identifier of the session
+     */
+    void sendPreloadFinished(const unsigned int id);
+
     /**
      * Send quit message to the master application to stop the receiver.
      */
@@ -96,41 +96,9 @@ bool WallToWallChannel::checkVersion(const uint64_t version) const
     return true;
 }
 
-int WallToWallChannel::electLeader(const bool isCandidate)
+std::vector<int64_t> WallToWallChannel::globalMin(const std::vector<int64_t>& localValues) const
 {
-    const int status = isCandidate ? (1 << getRank()) : 0;
-    int globalStatus = globalSum(status);
-
-    if(globalStatus <= 0)
-        return -1;
-
-    int leader = 0;
-    while (globalStatus > 1)
-    {
-        globalStatus = globalStatus >> 1;
-        ++leader;
-    }
-    return leader;
-}
-
-void WallToWallChannel::broadcast(boost::posix_time::time_duration timestamp)
-{
-    const std::string& serializedString = buffer_.serialize(timestamp);
-
-    mpiChannel_->broadcast(MPI_MESSAGE_TYPE_TIMESTAMP, serializedString);
-}
-
-boost::posix_time::time_duration WallToWallChannel::receiveTimestampBroadcast(const int src)
-{
-    MPIHeader header = mpiChannel_->receiveHeader(src);
-    assert(header.type == MPI_MESSAGE_TYPE_TIMESTAMP);
-
-    buffer_.setSize(header.size);
-    mpiChannel_->receiveBroadcast(buffer_.data(), buffer_.size(), src);
-
-    boost::posix_time::time_duration timestamp;
-    buffer_.deserialize(timestamp);
-    return timestamp;
+    return mpiChannel_->globalMin(localValues);
 }
 
 void WallToWallChannel::sendClock()
@@ -83,20 +83,12 @@ public:
     bool checkVersion(const uint64_t version) const;
 
     /**
-     * Elect a leader amongst wall processes.
-     * @param isCandidate Is this process a candidate.
-     * @return the rank of the leader, or -1 if no leader could be elected.
+     * Get the minimum of each of the given local values across all processes.
+     * All the values are reduced in a single collective operation.
+     * @param localValues The values to reduce, same count on all processes
+     * @return the minimum of each value, in the same order as localValues
      */
-    int electLeader(const bool isCandidate);
-
-    /**
-     * Broadcast a timestamp.
-     * All other processes must recieve it with receiveTimestampBroadcast().
-     */
-    void broadcast(boost::posix_time::time_duration timestamp);
-
-    /** Receive a timestamp broadcasted by broadcast(timestamp). */
-    boost::posix_time::time_duration receiveTimestampBroadcast(const int src);
+    std::vector<int64_t> globalMin(const std::vector<int64_t>& localValues) const;
 
 private:
     MPIChannelPtr mpiChannel_;
@@ -48,9 +48,11 @@
 #define DEFAULT_WEBSERVICE_PORT 8888
 #define TRIM_REGEX "[\\n\\t\\r]"
 #define DEFAULT_URL "http://www.google.com";
+#define DEFAULT_SESSION_ACTIVATION_TIMEOUT_MS 10000
 
 MasterConfiguration::MasterConfiguration(const QString &filename)
     : Configuration(filename)
+    , sessionActivationTimeout_(DEFAULT_SESSION_ACTIVATION_TIMEOUT_MS)
     , backgroundColor_(Qt::black)
 {
     loadMasterSettings();
@@ -65,6 +67,7 @@ void MasterConfiguration::loadMasterSettings()
     loadDockStartDirectory(query);
     loadWebBrowserStartURL(query);
     loadBackgroundProperties(query);
+    loadSessionSettings(query);
 }
 
 void MasterConfiguration::loadDockStartDirectory(QXmlQuery& query)
@@ -118,6 +121,20 @@ void MasterConfiguration::loadBackgroundProperties(QXmlQuery& query)
     }
 }
 
+void MasterConfiguration::loadSessionSettings(QXmlQuery& query)
+{
+    QString queryResult;
+
+    query.setQuery("string(/configuration/session/@activationTimeout)");
+    if (query.evaluateTo(&queryResult))
+    {
+        bool ok = false;
+        const int timeout = queryResult.remove(QRegExp(TRIM_REGEX)).toInt(&ok);
+        if (ok && timeout >= 0)
+            sessionActivationTimeout_ = timeout;
+    }
+}
+
 const QString& MasterConfiguration::getDockStartDir() const
 {
     return dockStartDir_;
@@ -133,6 +150,11 @@ const QString& MasterConfiguration::getWebBrowserDefaultURL() const
     return webBrowserDefaultURL_;
 }
 
+int MasterConfiguration::getSessionActivationTimeout() const
+{
+    return sessionActivationTimeout_;
+}
+
 const QString& MasterConfiguration::getBackgroundUri() const
 {
     return backgroundUri_;
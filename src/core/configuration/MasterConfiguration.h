@@ -78,6 +78,13 @@ public:
      */
     const QString& getWebBrowserDefaultURL() const;
 
+    /**
+     * Get how long to wait for the walls to preload a session before showing
+     * it anyway, in which case its contents load window by window.
+     * @return timeout in milliseconds, 0 to always wait for the walls
+     */
+    int getSessionActivationTimeout() const;
+
     /**
      * Get the URI to the Content to be used as background
      * @return empty string if unspecified
@@ -120,10 +127,12 @@ private:
     void loadDockStartDirectory(QXmlQuery& query);
     void loadWebBrowserStartURL(QXmlQuery& query);
     void loadBackgroundProperties(QXmlQuery& query);
+    void loadSessionSettings(QXmlQuery& query);
 
     QString dockStartDir_;
     int dcWebServicePort_;
     QString webBrowserDefaultURL_;
+    int sessionActivationTimeout_;
 
     QString backgroundUri_;
     QColor backgroundColor_;
@@ -44,40 +44,104 @@
 
 #include <QFileInfo>
 #include <QDateTime>
+#include <QtConcurrentRun>
 
 #define USE_CACHE
 #define CACHE_MAX_SIZE 100
 #define MODIFICATION_DATE_KEY "lastModificationDate"
 
+namespace
+{
+// Called from a worker thread of the pool
+QImage generateThumbnail(const QString& filename, const QSize& size)
+{
+    return ThumbnailGeneratorFactory::getGenerator(filename, size)->generate(filename);
+}
+}
+
 AsyncImageLoader::AsyncImageLoader(const QSize& defaultSize)
     : defaultSize_(defaultSize)
+    , generation_(0)
 {
     cache_.setMaxCost(CACHE_MAX_SIZE);
 }
 
-void AsyncImageLoader::loadImage( const QString& filename, const int index )
+AsyncImageLoader::~AsyncImageLoader()
 {
-#ifdef USE_CACHE
-    if (imageInCache(filename))
+    pending_.clear();
+    threadPool_.waitForDone();
+}
+
+void AsyncImageLoader::load(const Requests& requests)
+{
+    pending_ = requests;
+    startJobs();
+}
+
+void AsyncImageLoader::cancel()
+{
+    pending_.clear();
+    ++generation_;
+}
+
+void AsyncImageLoader::startJobs()
+{
+    while (!pending_.empty() && running_.size() < threadPool_.maxThreadCount())
     {
-        emit imageLoaded(index, *cache_[filename]);
-        return;
-    }
+        const Request request = pending_.takeFirst();
+        if (isRunning(request))
+            continue;
+
+#ifdef USE_CACHE
+        if (imageInCache(request.second))
+        {
+            emit imageLoaded(request.first, *cache_[request.second]);
+            continue;
+        }
 #endif
 
-    QImage image = ThumbnailGeneratorFactory::getGenerator(filename, defaultSize_)->generate(filename);
+        Watcher* watcher = new Watcher(this);
+        connect(watcher, SIGNAL(finished()), this, SLOT(jobFinished()));
+
+        const Job job = { request, generation_ };
+        running_.insert(watcher, job);
+        watcher->setFuture(QtConcurrent::run(&threadPool_, generateThumbnail,
+                                             request.second, defaultSize_));
+    }
+}
+
+void AsyncImageLoader::jobFinished()
+{
+    Watcher* watcher = static_cast<Watcher*>(sender());
+    const Job job = running_.take(watcher);
+    const QImage image = watcher->result();
+    watcher->deleteLater();
+
+#ifdef USE_CACHE
     if (!image.isNull())
     {
-#ifdef USE_CACHE
         // QCache requires a <T>* and takes ownership, so we have to create new QImage
         QImage* cacheImage = new QImage(image);
-        cacheImage->setText(MODIFICATION_DATE_KEY, QFileInfo(filename).lastModified().toString());
-        cache_.insert(filename, cacheImage);
-#endif
-        emit imageLoaded(index, image);
+        cacheImage->setText(MODIFICATION_DATE_KEY, QFileInfo(job.request.second).lastModified().toString());
+        cache_.insert(job.request.second, cacheImage);
     }
+#endif
+
+    // Results of cancelled requests refer to outdated indices
+    if (job.generation == generation_)
+        emit imageLoaded(job.request.first, image);
+
+    startJobs();
+}
 
-    emit imageLoadingFinished();
+bool AsyncImageLoader::isRunning(const Request& request) const
+{
+    foreach (const Job& job, running_)
+    {
+        if (job.generation == generation_ && job.request == request)
+            return true;
+    }
+    return false;
 }
 
 bool AsyncImageLoader::imageInCache(const QString& filename) const
@@ -42,19 +42,34 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QCache>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QThreadPool>
+#include <QtCore/QFutureWatcher>
 #include <QtGui/QImage>
 
 /**
  * Load image thumbnails for supported content types.
  *
- * The AsyncImageLoader is designed to be moved to a worker thread.
- * It maintain a cache with the 100 latest images for performance.
+ * Thumbnails are generated in parallel by a pool of worker threads. Pending
+ * requests are served by order of priority and can be replaced at any time,
+ * so that only the thumbnails which are still needed get generated.
+ * The AsyncImageLoader maintains a cache with the 100 latest images for
+ * performance, in addition to the persistent ThumbnailCache and
+ * MovieMetadataCache shared by all processes, which also make sure that
+ * concurrent workers never open the same file twice. It must be used from
+ * the thread in which it was created.
  */
 class AsyncImageLoader : public QObject
 {
     Q_OBJECT
 
 public:
+    /** A thumbnail request: a user-defined index and the content file. */
+    typedef QPair<int, QString> Request;
+    typedef QList<Request> Requests;
+
     /**
      * Constructor.
      *
@@ -62,34 +77,58 @@ public:
      */
     AsyncImageLoader(const QSize &defaultSize);
 
-public slots:
+    /** Destructor. Waits for the running requests to complete. */
+    ~AsyncImageLoader();
+
     /**
-     * Load an image thumbnail.
+     * Replace the pending requests.
      *
-     * This method is blocking; it designed to be call via a QSignal after the
-     * AsyncImageLoader has been moved to a worker thread.
-     * @param filename The path to the content file.
-     * @param index A user-defined index that will be passed back with imageLoaded().
-     *        Used by DockPixelStreamer.
+     * Requests are processed in the given order, the first one having the
+     * highest priority. Previous requests which have not started yet are
+     * dropped, those already running are completed.
+     * @param requests The new requests. Used by DockPixelStreamer.
      */
-    void loadImage( const QString& filename, const int index );
+    void load(const Requests& requests);
+
+    /**
+     * Cancel all requests.
+     *
+     * Pending requests are dropped and the results of the running ones are
+     * discarded. To be called when the indices become invalid.
+     */
+    void cancel();
 
 signals:
     /**
-     * Emitted when an image could be successfully loaded by loadImage().
+     * Emitted when a request has been processed.
      *
-     * @param index The user-defined index passed in loadImage().
-     * @param image The thumbnail image.
+     * @param index The user-defined index of the request.
+     * @param image The thumbnail image, null if it could not be generated.
      */
     void imageLoaded(int index, QImage image);
 
-    /** Emitted whenever loadImage() has finished (successful or not). */
-    void imageLoadingFinished();
+private slots:
+    void jobFinished();
 
 private:
+    typedef QFutureWatcher<QImage> Watcher;
+
+    struct Job
+    {
+        Request request;
+        unsigned int generation;
+    };
+
     QSize defaultSize_;
     QCache<QString, QImage> cache_;
 
+    QThreadPool threadPool_;
+    Requests pending_;
+    QHash<Watcher*, Job> running_;
+    unsigned int generation_;
+
+    void startJobs();
+    bool isRunning(const Request& request) const;
     bool imageInCache(const QString& filename) const;
 };
 
@@ -43,11 +43,15 @@
 #include <boost/program_options.hpp>
 #include <QStringList>
 
+#define DEFAULT_COMPRESSION_QUALITY 75
+
 CommandLineOptions::CommandLineOptions()
     : getHelp_(false)
     , streamerType_(PS_UNKNOWN)
     , width_(0)
     , height_(0)
+    , compressionMode_(COMPRESSION_AUTO)
+    , compressionQuality_(DEFAULT_COMPRESSION_QUALITY)
     , desc_("Allowed options")
 {
     initDesc();
@@ -58,12 +62,31 @@ CommandLineOptions::CommandLineOptions(int &argc, char **argv)
     , streamerType_(PS_UNKNOWN)
     , width_(0)
     , height_(0)
+    , compressionMode_(COMPRESSION_AUTO)
+    , compressionQuality_(DEFAULT_COMPRESSION_QUALITY)
     , desc_("Allowed options")
 {
     initDesc();
     parseCommandLineArguments(argc, argv);
 }
 
+CommandLineOptions::CommandLineOptions(const QStringList& arguments)
+    : getHelp_(false)
+    , streamerType_(PS_UNKNOWN)
+    , width_(0)
+    , height_(0)
+    , compressionMode_(COMPRESSION_AUTO)
+    , compressionQuality_(DEFAULT_COMPRESSION_QUALITY)
+    , desc_("Allowed options")
+{
+    initDesc();
+
+    std::vector<std::string> args;
+    foreach (const QString& argument, arguments)
+        args.push_back(argument.toStdString());
+    parseCommandLineArguments(args);
+}
+
 void CommandLineOptions::initDesc()
 {
     desc_.add_options()
@@ -78,6 +101,14 @@ void CommandLineOptions::initDesc()
                  "height of the stream in pixel")
         ("url", boost::program_options::value<std::string>()->default_value(""), "webkit only: url")
         ("rootdir", boost::program_options::value<std::string>()->default_value(""), "dock only: root directory")
+        ("compression", boost::program_options::value<std::string>()->default_value("auto"),
+                 "segment compression [auto | on | off]")
+        ("quality", boost::program_options::value<unsigned int>()->default_value(DEFAULT_COMPRESSION_QUALITY),
+                 "JPEG quality of compressed segments [1-100]")
+        ("host", boost::program_options::value<std::string>()->default_value(""),
+                 "run the streamers requested by the launcher listening on this local server")
+        ("localserver", boost::program_options::value<std::string>()->default_value(""),
+                 "stream through shared memory to the master listening on this local server")
     ;
 }
 
@@ -116,6 +147,26 @@ unsigned int CommandLineOptions::getHeight() const
     return height_;
 }
 
+CompressionMode CommandLineOptions::getCompressionMode() const
+{
+    return compressionMode_;
+}
+
+unsigned int CommandLineOptions::getCompressionQuality() const
+{
+    return compressionQuality_;
+}
+
+const QString& CommandLineOptions::getHostServer() const
+{
+    return hostServer_;
+}
+
+const QString& CommandLineOptions::getLocalServer() const
+{
+    return localServer_;
+}
+
 void CommandLineOptions::setHelp(const bool set)
 {
     getHelp_ = set;
@@ -151,6 +202,26 @@ void CommandLineOptions::setHeight(const unsigned int height)
     height_ = height;
 }
 
+void CommandLineOptions::setCompressionMode(const CompressionMode mode)
+{
+    compressionMode_ = mode;
+}
+
+void CommandLineOptions::setCompressionQuality(const unsigned int quality)
+{
+    compressionQuality_ = quality;
+}
+
+void CommandLineOptions::setHostServer(const QString& serverName)
+{
+    hostServer_ = serverName;
+}
+
+void CommandLineOptions::setLocalServer(const QString& serverName)
+{
+    localServer_ = serverName;
+}
+
 QString CommandLineOptions::getCommandLine() const
 {
     return getCommandLineArguments().join(" ");
@@ -181,15 +252,37 @@ QStringList CommandLineOptions::getCommandLineArguments() const
     if (!rootDir_.isEmpty())
         arguments << "--rootdir" << rootDir_;
 
+    if (compressionMode_ != COMPRESSION_AUTO)
+        arguments << "--compression" << getCompressionModeString(compressionMode_);
+
+    if (compressionQuality_ != DEFAULT_COMPRESSION_QUALITY)
+        arguments << "--quality" << QString::number(compressionQuality_);
+
+    if (!hostServer_.isEmpty())
+        arguments << "--host" << hostServer_;
+
+    if (!localServer_.isEmpty())
+        arguments << "--localserver" << localServer_;
+
     return arguments;
 }
 
 void CommandLineOptions::parseCommandLineArguments(int &argc, char **argv)
+{
+    // Skip the program name
+    std::vector<std::string> arguments;
+    for (int i = 1; i < argc; ++i)
+        arguments.push_back(argv[i]);
+    parseCommandLineArguments(arguments);
+}
+
+void CommandLineOptions::parseCommandLineArguments(const std::vector<std::string>& arguments)
 {
     boost::program_options::variables_map vm;
     try
     {
-        boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc_), vm);
+        boost::program_options::store(boost::program_options::command_line_parser(arguments)
+                                      .options(desc_).run(), vm);
         boost::program_options::notify(vm);
     }
     catch (const std::exception& e)
@@ -205,6 +298,10 @@ void CommandLineOptions::parseCommandLineArguments(int &argc, char **argv)
     width_ = vm["width"].as<unsigned int>();
     height_ = vm["height"].as<unsigned int>();
     rootDir_ = vm["rootdir"].as<std::string>().c_str();
+    compressionMode_ = ::getCompressionMode(vm["compression"].as<std::string>().c_str());
+    compressionQuality_ = vm["quality"].as<unsigned int>();
+    hostServer_ = vm["host"].as<std::string>().c_str();
+    localServer_ = vm["localserver"].as<std::string>().c_str();
 }
 
 void CommandLineOptions::showSyntax() const
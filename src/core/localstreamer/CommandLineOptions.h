@@ -41,9 +41,14 @@
 #define COMMANDLINEOPTIONS_H
 
 #include <QString>
+#include <QStringList>
 #include <boost/program_options/options_description.hpp>
 
+#include <string>
+#include <vector>
+
 #include "PixelStreamerType.h"
+#include "SegmentCompressionPolicy.h"
 
 /**
  * Command line options to pass startup parameters to a localstreamer application.
@@ -57,6 +62,9 @@ public:
     /** Construct from command line parameters */
     CommandLineOptions(int &argc, char **argv);
 
+    /** Construct from command line arguments, without the program name */
+    explicit CommandLineOptions(const QStringList& arguments);
+
     /** Print syntax to std::out */
     void showSyntax() const;
 
@@ -69,6 +77,10 @@ public:
     const QString& getName() const;
     unsigned int getWidth() const;
     unsigned int getHeight() const;
+    CompressionMode getCompressionMode() const;
+    unsigned int getCompressionQuality() const;
+    const QString& getHostServer() const;
+    const QString& getLocalServer() const;
     //@}
 
     /** Get the command line arguments corresponding to this object */
@@ -86,11 +98,16 @@ public:
     void setName(const QString& name);
     void setWidth(const unsigned int width);
     void setHeight(const unsigned int height);
+    void setCompressionMode(const CompressionMode mode);
+    void setCompressionQuality(const unsigned int quality);
+    void setHostServer(const QString& serverName);
+    void setLocalServer(const QString& serverName);
     //@}
 
 private:
     void initDesc();
     void parseCommandLineArguments(int &argc, char **argv);
+    void parseCommandLineArguments(const std::vector<std::string>& arguments);
 
     bool getHelp_;
     PixelStreamerType streamerType_;
@@ -98,6 +115,10 @@ private:
     QString rootDir_;
     QString name_;
     unsigned int width_, height_;
+    CompressionMode compressionMode_;
+    unsigned int compressionQuality_;
+    QString hostServer_;
+    QString localServer_;
 
     boost::program_options::options_description desc_;
 };
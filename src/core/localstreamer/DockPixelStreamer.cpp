@@ -40,15 +40,17 @@
 #include "DockPixelStreamer.h"
 
 #include "Pictureflow.h"
-#include "AsyncImageLoader.h"
 #include "DockToolbar.h"
 
 #include "ContentFactory.h"
 #include "thumbnail/ThumbnailGeneratorFactory.h"
+#include "thumbnail/ThumbnailGenerator.h"
 #include "thumbnail/FolderThumbnailGenerator.h"
 
 #include <deflect/Command.h>
 
+#include <QtConcurrentRun>
+
 #define DOCK_ASPECT_RATIO        0.45
 #define SLIDE_REL_HEIGHT_FACTOR  0.55
 
@@ -57,6 +59,9 @@
 
 #define COVERFLOW_SPEED_FACTOR   0.1
 
+// Number of thumbnails loaded on each side of the center slide
+#define THUMBNAILS_LOAD_RANGE    8
+
 #define WEBBROWSER_ICON ":/img/browser-icon.png"
 #define CLEARALL_ICON ":/img/clearall-icon.png"
 
@@ -82,7 +87,10 @@ DockPixelStreamer::DockPixelStreamer(const QSize& desiredDockSize, const QString
     createToolbar(dockSize.width(), dockSize.height()*0.15);
     createImageLoader();
 
-    loadThread_.start();
+    filePlaceholder_ = ThumbnailGeneratorFactory::getDefaultGenerator(flow_->slideSize())->generate(QString());
+    folderPlaceholder_ = ThumbnailGeneratorFactory::getFolderGenerator(flow_->slideSize())->generatePlaceholderImage(QDir());
+
+    connect( &listingWatcher_, SIGNAL(finished()), this, SLOT(directoryListed()));
 
     if (rootDir.isEmpty() || !setRootDir(rootDir))
         setRootDir(QDir::homePath());
@@ -90,8 +98,7 @@ DockPixelStreamer::DockPixelStreamer(const QSize& desiredDockSize, const QString
 
 DockPixelStreamer::~DockPixelStreamer()
 {
-    loadThread_.quit();
-    loadThread_.wait();
+    listingWatcher_.waitForFinished();
     delete flow_;
     delete loader_;
     delete toolbar_;
@@ -163,17 +170,19 @@ bool DockPixelStreamer::setRootDir(const QString& dir)
 
 void DockPixelStreamer::onItem()
 {
-    const QImage& image = flow_->slide( flow_->centerIndex( ));
-    const QString& source = image.text( "source" );
+    const int index = flow_->centerIndex();
+    if( index < 0 || index >= slides_.size( ))
+        return;
 
-    if( image.text( "dir" ).isEmpty( ))
+    const Slide& slide = slides_[index];
+    if( slide.isDir )
     {
-        deflect::Command command(deflect::COMMAND_TYPE_FILE, source);
-        emit sendCommand(command.getCommand());
+        changeDirectory( slide.source );
     }
     else
     {
-        changeDirectory( source );
+        deflect::Command command(deflect::COMMAND_TYPE_FILE, slide.source);
+        emit sendCommand(command.getCommand());
     }
 }
 
@@ -195,32 +204,33 @@ void DockPixelStreamer::update(const QImage& image)
 
 void DockPixelStreamer::loadThumbnails(int newCenterIndex)
 {
-    const int nbThumbnails = 2;
-
-    slideImagesToLoad_.clear();
-
-    int imin = std::max(newCenterIndex-nbThumbnails, 0);
-    int imax = std::min(newCenterIndex+nbThumbnails, slideImagesLoaded_.size()-1);
-    for (int i=imin; i<=imax; i++)
+    // Start from the center slide and move outwards, the loader drops the
+    // previous requests which are now out of range
+    AsyncImageLoader::Requests requests;
+    appendRequest(newCenterIndex, requests);
+    for (int offset = 1; offset <= THUMBNAILS_LOAD_RANGE; ++offset)
     {
-        slideImagesToLoad_.append(i);
+        appendRequest(newCenterIndex + offset, requests);
+        appendRequest(newCenterIndex - offset, requests);
     }
-    loadNextThumbnailInList();
+    loader_->load(requests);
 }
 
-void DockPixelStreamer::loadNextThumbnailInList()
+void DockPixelStreamer::appendRequest(const int index, AsyncImageLoader::Requests& requests) const
 {
-    while(!slideImagesToLoad_.empty())
-    {
-        int i = slideImagesToLoad_.front();
-        slideImagesToLoad_.pop_front();
-        if (!slideImagesLoaded_[i].first)
-        {
-            slideImagesLoaded_[i].first = true;
-            emit renderPreview( slideImagesLoaded_[i].second, i );
-            return;
-        }
-    }
+    if (index >= 0 && index < slides_.size() && !slides_[index].loaded)
+        requests.append(qMakePair(index, slides_[index].source));
+}
+
+void DockPixelStreamer::thumbnailLoaded(int index, QImage image)
+{
+    if (index < 0 || index >= slides_.size())
+        return;
+
+    // Keep the placeholder if the thumbnail could not be generated
+    slides_[index].loaded = true;
+    if (!image.isNull())
+        flow_->setSlide(index, image);
 }
 
 void DockPixelStreamer::createFlow(const QSize& dockSize)
@@ -250,33 +260,64 @@ void DockPixelStreamer::createToolbar(const unsigned int width, const unsigned i
 void DockPixelStreamer::createImageLoader()
 {
     loader_ = new AsyncImageLoader(flow_->slideSize());
-    loader_->moveToThread( &loadThread_ );
     connect( loader_, SIGNAL(imageLoaded(int, QImage)),
-             flow_, SLOT(setSlide( int, QImage )));
-    connect( this, SIGNAL(renderPreview( const QString&, const int )),
-             loader_, SLOT(loadImage( const QString&, const int )));
-    connect( loader_, SIGNAL(imageLoadingFinished()),
-             this, SLOT(loadNextThumbnailInList()));
+             this, SLOT(thumbnailLoaded(int, QImage)));
 }
 
 void DockPixelStreamer::changeDirectory( const QString& dir )
 {
-    slideIndex_[currentDir_.path()] = flow_->centerIndex();
+    // Only remember the position in a folder which has been listed
+    if( listingWatcher_.isFinished( ))
+        slideIndex_[currentDir_.path()] = flow_->centerIndex();
 
+    loader_->cancel();
     flow_->clear();
-    slideImagesToLoad_.clear();
-    slideImagesLoaded_.clear();
+    slides_.clear();
 
     currentDir_ = QDir(dir);
     if (dir != rootDir_)
     {
         addRootDirToFlow();
     }
-    addFilesToFlow();
-    addFoldersToFlow();
+
+    // Listing large folders can be slow, do it in a worker thread
+    listingWatcher_.setFuture( QtConcurrent::run( &DockPixelStreamer::listDirectory,
+                                                  currentDir_ ));
+}
+
+void DockPixelStreamer::directoryListed()
+{
+    const DirectoryListing& listing = listingWatcher_.result();
+    if( listing.path != currentDir_.path( ))
+        return;
+
+    addFilesToFlow( listing.files );
+    addFoldersToFlow( listing.folders );
 
     flow_->setCenterIndex( slideIndex_[currentDir_.path()] );
-    loadThumbnails( slideIndex_[currentDir_.path()] );
+    loadThumbnails( flow_->centerIndex( ));
+}
+
+DockPixelStreamer::DirectoryListing DockPixelStreamer::listDirectory( QDir dir )
+{
+    DirectoryListing listing;
+    listing.path = dir.path();
+
+    dir.setFilter( QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot );
+    QStringList filters = ContentFactory::getSupportedFilesFilter();
+    filters.append( "*.dcx" );
+    filters.append( "*.dcxb" );
+    dir.setNameFilters( filters );
+    listing.files = dir.entryInfoList();
+
+    dir.setFilter( QDir::Dirs | QDir::NoDotAndDotDot );
+    dir.setNameFilters( QStringList( ));
+    foreach( const QFileInfo& fileInfo, dir.entryInfoList( ))
+    {
+        if( !fileInfo.fileName().endsWith( ".pyramid" ))
+            listing.folders.append( fileInfo );
+    }
+    return listing;
 }
 
 void DockPixelStreamer::addRootDirToFlow()
@@ -289,52 +330,41 @@ void DockPixelStreamer::addRootDirToFlow()
         FolderThumbnailGeneratorPtr folderGenerator = ThumbnailGeneratorFactory::getFolderGenerator(flow_->slideSize());
 
         QImage img = folderGenerator->generateUpFolderImage(rootDir);
-        flow_->addSlide( img, "UP: " + rootDir.path() );
-        slideImagesLoaded_.append(qMakePair(true, QString()));
+        addSlide( img, "UP: " + rootDir.path(), rootDir.path(), true, true );
     }
 }
 
-void DockPixelStreamer::addFilesToFlow()
+void DockPixelStreamer::addFilesToFlow( const QFileInfoList& fileList )
 {
-    currentDir_.setFilter( QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot );
-    QStringList filters = ContentFactory::getSupportedFilesFilter();
-    filters.append( "*.dcx" );
-    currentDir_.setNameFilters( filters );
-    const QFileInfoList& fileList = currentDir_.entryInfoList();
-
-    ThumbnailGeneratorPtr defaultGenerator = ThumbnailGeneratorFactory::getDefaultGenerator(flow_->slideSize());
-
     for( int i = 0; i < fileList.size(); ++i )
     {
         const QFileInfo& fileInfo = fileList.at( i );
         const QString& fileName = currentDir_.absoluteFilePath( fileInfo.fileName( ));
-        QImage img = defaultGenerator->generate(fileName);
-        flow_->addSlide( img, fileInfo.fileName( ));
-        slideImagesLoaded_.append(qMakePair(false, fileName));
+        addSlide( filePlaceholder_, fileInfo.fileName(), fileName, false, false );
     }
 }
 
-void DockPixelStreamer::addFoldersToFlow()
+void DockPixelStreamer::addFoldersToFlow( const QFileInfoList& dirList )
 {
-    currentDir_.setFilter( QDir::Dirs | QDir::NoDotAndDotDot );
-    currentDir_.setNameFilters( QStringList( ));
-    const QFileInfoList& dirList = currentDir_.entryInfoList();
-
-    FolderThumbnailGeneratorPtr folderGenerator = ThumbnailGeneratorFactory::getFolderGenerator(flow_->slideSize());
-
     for( int i = 0; i < dirList.size(); ++i )
     {
         const QFileInfo& fileInfo = dirList.at( i );
         const QString& fileName = currentDir_.absoluteFilePath( fileInfo.fileName( ));
-        if( !fileName.endsWith( ".pyramid" ))
-        {
-            QImage img = folderGenerator->generatePlaceholderImage(QDir(fileName));
-            flow_->addSlide( img, fileInfo.fileName( ));
-            slideImagesLoaded_.append(qMakePair(false, fileName));
-        }
+        addSlide( folderPlaceholder_, fileInfo.fileName(), fileName, true, false );
     }
 }
 
+void DockPixelStreamer::addSlide( const QImage& image, const QString& caption,
+                                  const QString& source, const bool isDir,
+                                  const bool loaded )
+{
+    // The placeholder images share their pixel data between slides
+    flow_->addSlide( image, caption );
+
+    const Slide slide = { source, isDir, loaded };
+    slides_.append( slide );
+}
+
 QSize DockPixelStreamer::getMinSize()
 {
     const float dockHeight = SLIDE_MIN_SIZE / SLIDE_REL_HEIGHT_FACTOR;
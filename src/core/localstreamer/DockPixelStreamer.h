@@ -41,17 +41,16 @@
 #define DOCKPIXELSTREAMER_H
 
 #include "PixelStreamer.h"
+#include "AsyncImageLoader.h"
 
 #include <QtCore/QDir>
 #include <QtCore/QObject>
-#include <QtCore/QThread>
 #include <QtCore/QHash>
 #include <QtCore/QVector>
-#include <QtCore/QLinkedList>
+#include <QtCore/QFutureWatcher>
 #include <QtGui/QImage>
 
 class PictureFlow;
-class AsyncImageLoader;
 class DockToolbar;
 
 class DockPixelStreamer : public PixelStreamer
@@ -77,25 +76,38 @@ public slots:
 private slots:
     void update(const QImage &image);
     void loadThumbnails(int newCenterIndex);
-    void loadNextThumbnailInList();
-
-signals:
-    void renderPreview( const QString& fileName, const int index );
+    void thumbnailLoaded(int index, QImage image);
+    void directoryListed();
 
 private:
+    struct Slide
+    {
+        QString source;
+        bool isDir;
+        bool loaded;
+    };
+
+    struct DirectoryListing
+    {
+        QString path;
+        QFileInfoList files;
+        QFileInfoList folders;
+    };
+
     PictureFlow* flow_;
     AsyncImageLoader* loader_;
     DockToolbar* toolbar_;
 
-    QThread loadThread_;
-
     QString rootDir_;
     QDir currentDir_;
     QHash< QString, int > slideIndex_;
 
-    typedef QPair<bool, QString> SlideImageLoadingStatus;
-    QVector<SlideImageLoadingStatus> slideImagesLoaded_;
-    QLinkedList<int> slideImagesToLoad_;
+    QVector<Slide> slides_;
+    QFutureWatcher<DirectoryListing> listingWatcher_;
+
+    // Shared by all the slides until their thumbnail is loaded
+    QImage filePlaceholder_;
+    QImage folderPlaceholder_;
 
     void createFlow(const QSize& dockSize);
     void createToolbar(const unsigned int width, const unsigned int height);
@@ -105,8 +117,13 @@ private:
     void onItem();
     void changeDirectory( const QString& dir );
     void addRootDirToFlow();
-    void addFilesToFlow();
-    void addFoldersToFlow();
+    void addFilesToFlow(const QFileInfoList& fileList);
+    void addFoldersToFlow(const QFileInfoList& dirList);
+    void addSlide(const QImage& image, const QString& caption,
+                  const QString& source, bool isDir, bool loaded);
+    void appendRequest(int index, AsyncImageLoader::Requests& requests) const;
+
+    static DirectoryListing listDirectory(QDir dir);
 
     static QSize getMinSize();
     static QSize getMaxSize();
@@ -0,0 +1,339 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "LocalStream.h"
+
+#include "LocalStreamChannel.h"
+#include "SegmentCompressionPolicy.h"
+#include "SharedMemoryRingBuffer.h"
+
+#include "log.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QImageWriter>
+#include <QLocalSocket>
+
+#include <cstring>
+
+#define CONNECTION_TIMEOUT_MS 1000
+#define MASTER_REPLY_TIMEOUT_MS 5000
+#define REPLY_PENDING -1
+
+namespace
+{
+/** Copy a region of a Format_RGB32 image as RGBA pixels, as expected by the walls. */
+void copyRgbaPixels( const QImage& image, const QRect& rect, uchar* dest )
+{
+    quint32* out = reinterpret_cast<quint32*>( dest );
+    for( int y = rect.top(); y <= rect.bottom(); ++y )
+    {
+        const quint32* in =
+            reinterpret_cast<const quint32*>( image.constScanLine( y )) + rect.left();
+        for( int x = 0; x < rect.width(); ++x )
+        {
+            const quint32 pixel = in[x];
+            *out++ = ( pixel & 0xff00ff00 ) | (( pixel & 0xff ) << 16 ) |
+                     (( pixel >> 16 ) & 0xff );
+        }
+    }
+}
+
+/** Encode an image as JPEG, @return an empty array on error. */
+QByteArray compressJpeg( const QImage& image, const unsigned int quality )
+{
+    QByteArray jpeg;
+    QBuffer buffer( &jpeg );
+    buffer.open( QIODevice::WriteOnly );
+
+    QImageWriter writer( &buffer, "JPEG" );
+    writer.setQuality( quality );
+    if( !writer.write( image ))
+        return QByteArray();
+    return jpeg;
+}
+}
+
+LocalStream::LocalStream( const QString& name, const QString& serverName )
+    : channel_( 0 )
+    , serverName_( serverName )
+    , bufferGeneration_( 0 )
+    , eventRegistrationReply_( REPLY_PENDING )
+{
+    QLocalSocket* socket = new QLocalSocket;
+    socket->connectToServer( serverName );
+    if( !socket->waitForConnected( CONNECTION_TIMEOUT_MS ))
+    {
+        delete socket;
+        return;
+    }
+
+    channel_ = new LocalStreamChannel( socket, this );
+    connect( channel_, SIGNAL( messageReceived( int, QByteArray )),
+             this, SLOT( processMessage( int, QByteArray )));
+    connect( channel_, SIGNAL( disconnected( )), this, SIGNAL( disconnected( )));
+
+    QByteArray payload;
+    QDataStream stream( &payload, QIODevice::WriteOnly );
+    stream << name;
+    channel_->send( MESSAGE_OPEN, payload );
+}
+
+LocalStream::~LocalStream()
+{
+}
+
+bool LocalStream::isConnected() const
+{
+    return channel_ && channel_->isConnected();
+}
+
+bool LocalStream::sendFrame( const QImage& image,
+                             const QVector<QRect>& segments,
+                             SegmentCompressionPolicy& compressionPolicy )
+{
+    if( !isConnected( ))
+        return false;
+
+    if( image.isNull( ))
+        return true;
+
+    QImage frame = image;
+    if( frame.format() != QImage::Format_RGB32 &&
+        frame.format() != QImage::Format_ARGB32 &&
+        frame.format() != QImage::Format_ARGB32_Premultiplied )
+    {
+        frame = frame.convertToFormat( QImage::Format_RGB32 );
+    }
+
+    const unsigned int frameSize = frame.width() * frame.height() *
+                                   LOCALSTREAM_BYTES_PER_PIXEL;
+    if( !reserveBuffer( frameSize ))
+        return false;
+
+    QVector<QRect> rects;
+    rects.reserve( segments.size( ));
+    for( int i = 0; i < segments.size(); ++i )
+    {
+        const QRect rect = segments[i] & frame.rect();
+        if( !rect.isEmpty( ))
+            rects.append( rect );
+    }
+
+    const int slot = acquireSlot();
+    if( slot < 0 )
+        return false;
+
+    uchar* data = buffer_->getSlot( slot );
+
+    QByteArray payload;
+    QDataStream stream( &payload, QIODevice::WriteOnly );
+    stream << quint32( slot ) << quint32( rects.size( ));
+
+    // The segments of a frame never overlap and are only compressed if it
+    // makes them smaller, so they fit in a frame-sized slot
+    const qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+    quint32 offset = 0;
+    for( int i = 0; i < rects.size(); ++i )
+    {
+        const QRect& rect = rects[i];
+        const quint32 rawSize = rect.width() * rect.height() *
+                                LOCALSTREAM_BYTES_PER_PIXEL;
+
+        QByteArray jpeg;
+        const QImage segment = frame.copy( rect );
+        if( compressionPolicy.shouldCompress( segment, rect.topLeft(), timestamp ))
+            jpeg = compressJpeg( segment, compressionPolicy.getQuality( ));
+
+        const bool compressed = !jpeg.isEmpty() &&
+                                quint32( jpeg.size( )) < rawSize;
+        quint32 size = rawSize;
+        if( compressed )
+        {
+            size = jpeg.size();
+            memcpy( data + offset, jpeg.constData(), size );
+        }
+        else
+            copyRgbaPixels( frame, rect, data + offset );
+
+        stream << qint32( rect.x( )) << qint32( rect.y( ))
+               << qint32( rect.width( )) << qint32( rect.height( ))
+               << offset << size << compressed;
+        offset += size;
+    }
+
+    return channel_->send( MESSAGE_FRAME, payload );
+}
+
+bool LocalStream::registerForEvents( const bool exclusive )
+{
+    if( !isConnected( ))
+        return false;
+
+    QByteArray payload;
+    QDataStream stream( &payload, QIODevice::WriteOnly );
+    stream << exclusive;
+
+    eventRegistrationReply_ = REPLY_PENDING;
+    if( !channel_->send( MESSAGE_REGISTER_EVENTS, payload ))
+        return false;
+
+    while( eventRegistrationReply_ == REPLY_PENDING )
+    {
+        if( !waitForMaster( ))
+            return false;
+    }
+    return eventRegistrationReply_ != 0;
+}
+
+bool LocalStream::hasEvent() const
+{
+    return !events_.isEmpty();
+}
+
+deflect::Event LocalStream::getEvent()
+{
+    return events_.dequeue();
+}
+
+bool LocalStream::sendCommand( const QString& command )
+{
+    if( !isConnected( ))
+        return false;
+
+    QByteArray payload;
+    QDataStream stream( &payload, QIODevice::WriteOnly );
+    stream << command;
+    return channel_->send( MESSAGE_COMMAND, payload );
+}
+
+void LocalStream::processMessage( const int type, QByteArray payload )
+{
+    QDataStream stream( payload );
+    switch( type )
+    {
+    case MESSAGE_RELEASE:
+    {
+        quint32 slot = 0;
+        stream >> slot;
+        if( buffer_ )
+            buffer_->releaseSlot( slot );
+        break;
+    }
+    case MESSAGE_EVENT_REGISTRATION_REPLY:
+    {
+        bool success = false;
+        stream >> success;
+        eventRegistrationReply_ = success;
+        break;
+    }
+    case MESSAGE_EVENT:
+    {
+        if( payload.size() != sizeof( deflect::Event ))
+            break;
+        deflect::Event event;
+        stream.readRawData( reinterpret_cast<char*>( &event ),
+                            sizeof( deflect::Event ));
+        events_.enqueue( event );
+        emit eventReceived();
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+bool LocalStream::reserveBuffer( const unsigned int size )
+{
+    if( buffer_ && buffer_->getSlotSize() >= size )
+        return true;
+
+    // The master may still be reading the previous frames
+    while( buffer_ && buffer_->hasAcquiredSlots( ))
+    {
+        if( !waitForMaster( ))
+            return false;
+    }
+
+    // Each buffer gets a new key, the master attaches to it on MESSAGE_BUFFER
+    const QString key = QString( "%1-%2-%3" ).arg( serverName_ )
+                                             .arg( QCoreApplication::applicationPid( ))
+                                             .arg( ++bufferGeneration_ );
+    buffer_.reset( new SharedMemoryRingBuffer( key ));
+    if( !buffer_->create( size, LOCALSTREAM_RING_SLOTS ))
+    {
+        buffer_.reset();
+        return false;
+    }
+
+    QByteArray payload;
+    QDataStream stream( &payload, QIODevice::WriteOnly );
+    stream << key << quint32( size ) << quint32( LOCALSTREAM_RING_SLOTS );
+    return channel_->send( MESSAGE_BUFFER, payload );
+}
+
+int LocalStream::acquireSlot()
+{
+    int slot = buffer_->acquireSlot();
+    while( slot < 0 )
+    {
+        // Wait for the master to release a previous frame
+        if( !waitForMaster( ))
+            return -1;
+        slot = buffer_->acquireSlot();
+    }
+    return slot;
+}
+
+bool LocalStream::waitForMaster()
+{
+    if( channel_->waitForMessages( MASTER_REPLY_TIMEOUT_MS ))
+        return true;
+
+    // A master which stopped answering would otherwise block the streamer
+    // forever; closing the channel ends the stream through disconnected()
+    if( channel_->isConnected( ))
+    {
+        put_flog( LOG_WARN, "No reply from the master after %d ms, closing "
+                  "the stream", MASTER_REPLY_TIMEOUT_MS );
+        channel_->close();
+    }
+    return false;
+}
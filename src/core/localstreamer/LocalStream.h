@@ -0,0 +1,145 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef LOCALSTREAM_H
+#define LOCALSTREAM_H
+
+#include "LocalStreamProtocol.h"
+
+#include <deflect/Event.h>
+
+#include <QObject>
+#include <QImage>
+#include <QQueue>
+#include <QRect>
+#include <QVector>
+
+#include <boost/scoped_ptr.hpp>
+
+class LocalStreamChannel;
+class SegmentCompressionPolicy;
+class SharedMemoryRingBuffer;
+
+/**
+ * Stream pixels to a master application running on the same host.
+ *
+ * This is an alternative to deflect::Stream for the local streamers. Frames
+ * are written uncompressed to a SharedMemoryRingBuffer and only their
+ * description goes through the control socket, which avoids copying the
+ * pixels through the network stack and encoding/decoding them as JPEG.
+ *
+ * The segments chosen by the SegmentCompressionPolicy of the stream are
+ * written as JPEG instead, so that the master does not have to forward them
+ * to the walls uncompressed.
+ */
+class LocalStream : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Connect to the master application and open a stream.
+     * @param name The unique name of the stream (its uri).
+     * @param serverName The name of the master's local server, which also
+     *        prefixes the keys of the shared memory buffers.
+     */
+    LocalStream( const QString& name, const QString& serverName );
+
+    /** Destructor. */
+    ~LocalStream();
+
+    /** Check if the stream is connected to the master. */
+    bool isConnected() const;
+
+    /**
+     * Send a frame.
+     *
+     * This call blocks while all the slots of the ring buffer are used by
+     * previous frames which have not been processed by the master yet.
+     * @param image The full image of the stream.
+     * @param segments The regions of the image to send.
+     * @param compressionPolicy Decides which segments are sent as JPEG.
+     * @return true on success, false if the connection was lost.
+     */
+    bool sendFrame( const QImage& image, const QVector<QRect>& segments,
+                    SegmentCompressionPolicy& compressionPolicy );
+
+    /**
+     * Register to receive the events of the stream's window.
+     * @param exclusive Only one source of the stream can receive events.
+     * @return true if the registration was accepted.
+     */
+    bool registerForEvents( bool exclusive = false );
+
+    /** Check if an event is waiting in the queue. */
+    bool hasEvent() const;
+
+    /** Get the next event in the queue. */
+    deflect::Event getEvent();
+
+    /**
+     * Send a command to the master application.
+     * @param command The command string, see deflect::Command.
+     * @return true on success.
+     */
+    bool sendCommand( const QString& command );
+
+signals:
+    /** Emitted when new events have been queued. */
+    void eventReceived();
+
+    /** Emitted when the connection to the master is closed. */
+    void disconnected();
+
+private slots:
+    void processMessage( int type, QByteArray payload );
+
+private:
+    LocalStreamChannel* channel_;
+    const QString serverName_;
+    boost::scoped_ptr<SharedMemoryRingBuffer> buffer_;
+    unsigned int bufferGeneration_;
+    QQueue<deflect::Event> events_;
+    int eventRegistrationReply_;
+
+    bool reserveBuffer( unsigned int size );
+    int acquireSlot();
+    bool waitForMaster();
+};
+
+#endif // LOCALSTREAM_H
@@ -0,0 +1,126 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "LocalStreamChannel.h"
+
+#include <QDataStream>
+#include <QLocalSocket>
+
+namespace
+{
+const qint64 HEADER_SIZE = 2 * sizeof( quint32 );
+}
+
+LocalStreamChannel::LocalStreamChannel( QLocalSocket* socket, QObject* parent_ )
+    : QObject( parent_ )
+    , socket_( socket )
+{
+    socket_->setParent( this );
+    connect( socket_, SIGNAL( readyRead( )), this, SLOT( processMessages( )));
+    connect( socket_, SIGNAL( disconnected( )), this, SIGNAL( disconnected( )));
+}
+
+bool LocalStreamChannel::isConnected() const
+{
+    return socket_->state() == QLocalSocket::ConnectedState;
+}
+
+quintptr LocalStreamChannel::getDescriptor() const
+{
+    return socket_->socketDescriptor();
+}
+
+bool LocalStreamChannel::send( const LocalStreamMessageType type,
+                               const QByteArray& payload )
+{
+    if( !isConnected( ))
+        return false;
+
+    QByteArray header;
+    QDataStream stream( &header, QIODevice::WriteOnly );
+    stream << quint32( type ) << quint32( payload.size( ));
+
+    if( socket_->write( header ) != HEADER_SIZE ||
+        socket_->write( payload ) != payload.size( ))
+    {
+        return false;
+    }
+    socket_->flush();
+    return true;
+}
+
+bool LocalStreamChannel::waitForMessages( const int msecs )
+{
+    if( !socket_->waitForReadyRead( msecs ))
+        return false;
+
+    // Depending on the platform, readyRead may not be emitted while waiting
+    processMessages();
+    return isConnected();
+}
+
+void LocalStreamChannel::close()
+{
+    socket_->disconnectFromServer();
+}
+
+void LocalStreamChannel::processMessages()
+{
+    quint32 type = 0;
+    QByteArray payload;
+    while( readMessage( type, payload ))
+        emit messageReceived( type, payload );
+}
+
+bool LocalStreamChannel::readMessage( quint32& type, QByteArray& payload )
+{
+    if( socket_->bytesAvailable() < HEADER_SIZE )
+        return false;
+
+    const QByteArray header = socket_->peek( HEADER_SIZE );
+    QDataStream stream( header );
+    quint32 payloadSize = 0;
+    stream >> type >> payloadSize;
+
+    if( socket_->bytesAvailable() < HEADER_SIZE + payloadSize )
+        return false;
+
+    socket_->read( HEADER_SIZE );
+    payload = socket_->read( payloadSize );
+    return true;
+}
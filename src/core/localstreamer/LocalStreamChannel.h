@@ -0,0 +1,105 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef LOCALSTREAMCHANNEL_H
+#define LOCALSTREAMCHANNEL_H
+
+#include "LocalStreamProtocol.h"
+
+#include <QObject>
+#include <QByteArray>
+
+class QLocalSocket;
+
+/**
+ * Exchange LocalStreamMessageType messages over a local socket.
+ */
+class LocalStreamChannel : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Constructor.
+     * @param socket The connected socket. The channel takes ownership of it.
+     * @param parent The parent QObject.
+     */
+    LocalStreamChannel( QLocalSocket* socket, QObject* parent = 0 );
+
+    /** Check if the socket is still connected. */
+    bool isConnected() const;
+
+    /** Get the native descriptor of the socket. */
+    quintptr getDescriptor() const;
+
+    /**
+     * Send a message.
+     * @param type The type of the message.
+     * @param payload The content of the message.
+     * @return true if the message could be written to the socket.
+     */
+    bool send( LocalStreamMessageType type,
+               const QByteArray& payload = QByteArray( ));
+
+    /**
+     * Block until new data is available and process the received messages.
+     * @param msecs The maximum time to wait, -1 for no timeout.
+     * @return false if the socket was disconnected or the wait timed out.
+     */
+    bool waitForMessages( int msecs );
+
+    /** Close the connection. */
+    void close();
+
+signals:
+    /** Emitted for each complete message received. */
+    void messageReceived( int type, QByteArray payload );
+
+    /** Emitted when the connection is closed. */
+    void disconnected();
+
+private slots:
+    void processMessages();
+
+private:
+    QLocalSocket* socket_;
+
+    bool readMessage( quint32& type, QByteArray& payload );
+};
+
+#endif // LOCALSTREAMCHANNEL_H
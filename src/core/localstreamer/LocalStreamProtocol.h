@@ -0,0 +1,91 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef LOCALSTREAMPROTOCOL_H
+#define LOCALSTREAMPROTOCOL_H
+
+/**
+ * The prefix of the local server opened by each master application, followed
+ * by its pid. The shared memory keys of the streams start with the server name.
+ */
+#define LOCALSTREAM_SERVER_PREFIX "displaycluster-localstream"
+
+/** The number of frames which can be in flight between a streamer and the master. */
+#define LOCALSTREAM_RING_SLOTS 3
+
+/** Pixels are exchanged as 32 bits RGBA values. */
+#define LOCALSTREAM_BYTES_PER_PIXEL 4
+
+/**
+ * The messages exchanged on the control socket of a LocalStream, and between
+ * the PixelStreamerLauncher and the localstreamer processes hosting streamers.
+ *
+ * Each message is a header of two quint32 (type, payload size) followed by a
+ * payload written with a QDataStream.
+ */
+enum LocalStreamMessageType
+{
+    /** Streamer -> master. Payload: QString uri. */
+    MESSAGE_OPEN,
+    /** Streamer -> master. Payload: QString key, quint32 slotSize, quint32 slotCount. */
+    MESSAGE_BUFFER,
+    /**
+     * Streamer -> master. Payload: quint32 slot, quint32 segmentCount, then
+     * for each segment qint32 x, y, width, height, quint32 offset and size
+     * in the slot, and bool compressed (JPEG data instead of RGBA pixels).
+     */
+    MESSAGE_FRAME,
+    /** Master -> streamer. Payload: quint32 slot. */
+    MESSAGE_RELEASE,
+    /** Streamer -> master. Payload: bool exclusive. */
+    MESSAGE_REGISTER_EVENTS,
+    /** Master -> streamer. Payload: bool success. */
+    MESSAGE_EVENT_REGISTRATION_REPLY,
+    /** Master -> streamer. Payload: a raw deflect::Event. */
+    MESSAGE_EVENT,
+    /** Streamer -> master. Payload: QString command. */
+    MESSAGE_COMMAND,
+    /** Launcher -> streamer host. Payload: QStringList command line arguments. */
+    MESSAGE_START_STREAMER,
+    /** Streamer host -> launcher. Payload: QString uri. */
+    MESSAGE_STREAMER_CLOSED,
+    /** Streamer host -> launcher, the streamer could not be started. Payload: QString uri. */
+    MESSAGE_STREAMER_FAILED
+};
+
+#endif // LOCALSTREAMPROTOCOL_H
@@ -51,6 +51,18 @@
 #include <QVector>
 #include <QWidget>
 #include <QGLWidget>
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
+#endif
+
+// SIMD paths for the reflection blur, with a scalar fallback
+#if defined(__SSE2__)
+#define PICTUREFLOW_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define PICTUREFLOW_NEON
+#include <arm_neon.h>
 #endif
 
 #ifdef PICTUREFLOW_QT3
@@ -108,6 +120,21 @@ typedef long PFreal;
 #define IANGLE_MAX 1024
 #define IANGLE_MASK 1023
 
+// interval of the animation timer, about one frame at 60 Hz
+#define ANIMATION_INTERVAL_MS 16
+
+// the animation speeds below were tuned for this interval
+#define ANIMATION_REFERENCE_INTERVAL_MS 30
+
+// number of prepared surfaces kept in memory
+#define SURFACE_CACHE_SIZE 64
+
+// size of the tiles used to transpose the slide images
+#define TRANSPOSE_TILE 32
+
+// minimum number of columns rendered by each thread
+#define MIN_BAND_WIDTH 64
+
 inline PFreal fmul(PFreal a, PFreal b)
 {
   return ((long long)(a))*((long long)(b)) >> PFREAL_SHIFT;
@@ -236,6 +263,20 @@ public:
 
   virtual void init() = 0;
   virtual void paint() = 0;
+
+  // renders if needed and returns the offscreen buffer
+  virtual const QImage& image() = 0;
+};
+
+// the columns of the buffer covered by a slide
+struct SlideColumns
+{
+  const SlideInfo* slide;
+  // a shallow copy, which keeps the surface alive for the whole render even
+  // if preparing the surfaces of the next slides evicts it from the cache
+  QImage surface;
+  int col1;
+  int col2;
 };
 
 class PictureFlowSoftwareRenderer: public PictureFlowAbstractRenderer
@@ -246,17 +287,21 @@ public:
 
   void init() override;
   void paint() override;
+  const QImage& image() override;
 
 private:
   QSize size;
   QRgb bgcolor;
   int effect;
+  QSize slideSize;
   QImage buffer;
+  uchar* bufferBits;
   QVector<PFreal> rays;
   QImage* blankSurface;
 #ifdef PICTUREFLOW_QT4
-  QCache<int,QImage> surfaceCache;
-  QHash<int,QImage*> imageHash;
+  // keyed by QImage::cacheKey(), to share the surfaces of identical images
+  QCache<qint64,QImage> surfaceCache;
+  QVector<SlideColumns> slideColumns;
 #endif
 #ifdef PICTUREFLOW_QT3
   QCache<QImage> surfaceCache;
@@ -270,7 +315,12 @@ private:
   void render();
   void renderSlides();
   void renderCaption();
-  QRect renderSlide(const SlideInfo &slide, int col1 = -1, int col2 = -1);
+  QRect renderSlide(const SlideInfo &slide, const QImage* src, int col1 = -1, int col2 = -1,
+                    bool draw = true);
+#ifdef PICTUREFLOW_QT4
+  QRect addSlideColumns(const SlideInfo &slide, int col1, int col2);
+  void renderColumns(int first, int last);
+#endif
   QImage* surface(int slideIndex);
 };
 
@@ -353,7 +403,7 @@ void PictureFlowAnimator::start(int slide)
   if(!animateTimer.isActive() && state)
   {
     step = (target < state->centerSlide.slideIndex) ? -1 : 1;
-    animateTimer.start(30);
+    animateTimer.start(ANIMATION_INTERVAL_MS);
   }
 }
 
@@ -390,6 +440,9 @@ void PictureFlowAnimator::update()
   speed = 4096 + 16384 * (PFREAL_ONE+fsin(ia))/PFREAL_ONE;
 #endif
 
+  // same animation duration whatever the timer interval
+  speed = speed * ANIMATION_INTERVAL_MS / ANIMATION_REFERENCE_INTERVAL_MS;
+
   frame += speed*step;
 
   int index = frame >> 16;
@@ -493,11 +546,14 @@ void PictureFlowAnimator::update()
 // ------------- PictureFlowSoftwareRenderer ---------------------------------------
 
 PictureFlowSoftwareRenderer::PictureFlowSoftwareRenderer():
-PictureFlowAbstractRenderer(), size(0,0), bgcolor(0), effect(-1), blankSurface(0)
+PictureFlowAbstractRenderer(), size(0,0), bgcolor(0), effect(-1), bufferBits(0), blankSurface(0)
 {
 #ifdef PICTUREFLOW_QT3
   surfaceCache.setAutoDelete(true);
 #endif
+#ifdef PICTUREFLOW_QT4
+  surfaceCache.setMaxCost(SURFACE_CACHE_SIZE);
+#endif
 }
 
 PictureFlowSoftwareRenderer::~PictureFlowSoftwareRenderer()
@@ -512,6 +568,15 @@ void PictureFlowSoftwareRenderer::paint()
   if(!widget)
     return;
 
+  QPainter painter(widget);
+  painter.drawImage(QPoint(0,0), image());
+}
+
+const QImage& PictureFlowSoftwareRenderer::image()
+{
+  if(!widget)
+    return buffer;
+
   if(widget->size() != size)
     init();
 
@@ -519,19 +584,31 @@ void PictureFlowSoftwareRenderer::paint()
   {
     bgcolor = state->backgroundColor;
     surfaceCache.clear();
+    delete blankSurface;
+    blankSurface = 0;
   }
 
   if((int)(state->reflectionEffect) != effect)
   {
     effect = (int)state->reflectionEffect;
     surfaceCache.clear();
+    delete blankSurface;
+    blankSurface = 0;
+  }
+
+  QSize newSlideSize(state->slideWidth, state->slideHeight);
+  if(newSlideSize != slideSize)
+  {
+    slideSize = newSlideSize;
+    surfaceCache.clear();
+    delete blankSurface;
+    blankSurface = 0;
   }
 
   if(dirty)
     render();
 
-  QPainter painter(widget);
-  painter.drawImage(QPoint(0,0), buffer);
+  return buffer;
 }
 
 void PictureFlowSoftwareRenderer::init()
@@ -540,6 +617,7 @@ void PictureFlowSoftwareRenderer::init()
     return;
 
   surfaceCache.clear();
+  delete blankSurface;
   blankSurface = 0;
 
   size = widget->size();
@@ -567,15 +645,103 @@ void PictureFlowSoftwareRenderer::init()
   dirty = true;
 }
 
-// TODO: optimize this with lookup tables
-static QRgb blendColor(QRgb c1, QRgb c2, int blend)
+// blends the red and blue channels in one multiplication, then the green one
+static inline QRgb blendColor(QRgb c1, QRgb c2, int blend)
+{
+  unsigned int rb = ((c1 & 0xff00ff) * blend + (c2 & 0xff00ff) * (256-blend)) >> 8;
+  unsigned int g = ((c1 & 0x00ff00) * blend + (c2 & 0x00ff00) * (256-blend)) >> 8;
+  return 0xff000000 | (rb & 0xff00ff) | (g & 0x00ff00);
+}
+
+// One step of the exponential blur (acc += ((p<<4) - acc) >> 1; p = acc >> 4)
+// applied to all the channels of a pixel at once
+#if defined(PICTUREFLOW_SSE2)
+typedef __m128i BlurAccumulator;
+
+static inline __m128i loadPixel(const unsigned char* p)
+{
+  return _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)p), _mm_setzero_si128());
+}
+
+static inline BlurAccumulator blurStart(const unsigned char* p)
 {
-  int r = qRed(c1) * blend/256 + qRed(c2)*(256-blend)/256;
-  int g = qGreen(c1) * blend/256 + qGreen(c2)*(256-blend)/256;
-  int b = qBlue(c1) * blend/256 + qBlue(c2)*(256-blend)/256;
-  return qRgb(r, g, b);
+  return _mm_slli_epi16(loadPixel(p), 4);
 }
 
+static inline void blurStep(BlurAccumulator& acc, unsigned char* p)
+{
+  __m128i pixel = _mm_slli_epi16(loadPixel(p), 4);
+  acc = _mm_add_epi16(acc, _mm_srai_epi16(_mm_sub_epi16(pixel, acc), 1));
+  __m128i result = _mm_packus_epi16(_mm_srai_epi16(acc, 4), _mm_setzero_si128());
+  *(int*)p = _mm_cvtsi128_si32(result);
+}
+#elif defined(PICTUREFLOW_NEON)
+typedef int16x4_t BlurAccumulator;
+
+static inline int16x4_t loadPixel(const unsigned char* p)
+{
+  uint8x8_t bytes = vreinterpret_u8_u32(vdup_n_u32(*(const uint32_t*)p));
+  return vreinterpret_s16_u16(vget_low_u16(vmovl_u8(bytes)));
+}
+
+static inline BlurAccumulator blurStart(const unsigned char* p)
+{
+  return vshl_n_s16(loadPixel(p), 4);
+}
+
+static inline void blurStep(BlurAccumulator& acc, unsigned char* p)
+{
+  int16x4_t pixel = vshl_n_s16(loadPixel(p), 4);
+  acc = vadd_s16(acc, vshr_n_s16(vsub_s16(pixel, acc), 1));
+  uint8x8_t result = vqmovun_s16(vcombine_s16(vshr_n_s16(acc, 4), vdup_n_s16(0)));
+  *(uint32_t*)p = vget_lane_u32(vreinterpret_u32_u8(result), 0);
+}
+#else
+struct BlurAccumulator
+{
+  int rgba[3];
+};
+
+static inline BlurAccumulator blurStart(const unsigned char* p)
+{
+  BlurAccumulator acc;
+  for(int i = 0; i < 3; i++)
+    acc.rgba[i] = p[i] << 4;
+  return acc;
+}
+
+static inline void blurStep(BlurAccumulator& acc, unsigned char* p)
+{
+  for(int i = 0; i < 3; i++)
+    p[i] = (acc.rgba[i] += (((p[i]<<4)-acc.rgba[i])) >> 1) >> 4;
+}
+#endif
+
+#ifdef PICTUREFLOW_QT4
+// Copies the rows [y1,y2[ of img transposed into result, starting at column
+// hofs. Works on tiles to keep both the source and destination in cache.
+static void transposeRows(const QImage& img, int y1, int y2, QImage* result, int hofs)
+{
+  const uchar* bits = img.constBits();
+  const int bpl = img.bytesPerLine();
+  const int w = img.width();
+
+  for(int ty = y1; ty < y2; ty += TRANSPOSE_TILE)
+  {
+    const int tyEnd = qMin(ty + TRANSPOSE_TILE, y2);
+    for(int tx = 0; tx < w; tx += TRANSPOSE_TILE)
+    {
+      const int txEnd = qMin(tx + TRANSPOSE_TILE, w);
+      for(int x = tx; x < txEnd; x++)
+      {
+        QRgb* dst = (QRgb*)result->scanLine(x) + hofs;
+        for(int y = ty; y < tyEnd; y++)
+          dst[y] = ((const QRgb*)(bits + y * bpl))[x] | 0xff000000;
+      }
+    }
+  }
+}
+#endif
 
 static QImage* prepareSurface(const QImage* slideImage, int w, int h, QRgb bgcolor,
 PictureFlow::ReflectionEffect reflectionEffect)
@@ -583,6 +749,8 @@ PictureFlow::ReflectionEffect reflectionEffect)
 #ifdef PICTUREFLOW_QT4
   Qt::TransformationMode mode = Qt::SmoothTransformation;
   QImage img = slideImage->scaled(w, h, Qt::IgnoreAspectRatio, mode);
+  if(img.format() != QImage::Format_RGB32 && img.format() != QImage::Format_ARGB32)
+    img = img.convertToFormat(QImage::Format_RGB32);
 #endif
 #if defined(PICTUREFLOW_QT3) || defined(PICTUREFLOW_QT2)
   QImage img = slideImage->smoothScale(w, h);
@@ -605,21 +773,41 @@ PictureFlow::ReflectionEffect reflectionEffect)
   // transpose the image, this is to speed-up the rendering
   // because we process one column at a time
   // (and much better and faster to work row-wise, i.e in one scanline)
+#ifdef PICTUREFLOW_QT4
+  transposeRows(img, 0, h, result, hofs);
+#else
   for(int x = 0; x < w; x++)
     for(int y = 0; y < h; y++)
       result->setPixel(hofs + y, x, img.pixel(x, y));
+#endif
 
   if(reflectionEffect != PictureFlow::NoReflection)
   {
     // create the reflection
     int ht = hs - h - hofs;
     int hte = ht;
+#ifdef PICTUREFLOW_QT4
+    QVector<int> fade(ht);
+    for(int y = 0; y < ht; y++)
+      fade[y] = 128*(hte-y)/hte;
+
+    const uchar* imgBits = img.constBits();
+    const int imgBpl = img.bytesPerLine();
+    for(int x = 0; x < w; x++)
+    {
+      QRgb* dst = (QRgb*)result->scanLine(x) + h + hofs;
+      const uchar* src = imgBits + (img.height()-1) * imgBpl + x * 4;
+      for(int y = 0; y < ht; y++, src -= imgBpl)
+        dst[y] = blendColor(*(const QRgb*)src, bgcolor, fade[y]);
+    }
+#else
     for(int x = 0; x < w; x++)
       for(int y = 0; y < ht; y++)
       {
         QRgb color = img.pixel(x, img.height()-y-1);
         result->setPixel(h+hofs+y, x, blendColor(color,bgcolor,128*(hte-y)/hte));
       }
+#endif
 
     if(reflectionEffect == PictureFlow::BlurredReflection)
     {
@@ -634,7 +822,6 @@ PictureFlow::ReflectionEffect reflectionEffect)
       int c2 = rect.right();
 
       int bpl = result->bytesPerLine();
-      int rgba[4];
       unsigned char* p;
 
       // how many times blur is applied?
@@ -644,56 +831,53 @@ PictureFlow::ReflectionEffect reflectionEffect)
         for(int col = c1; col <= c2; col++)
         {
           p = result->scanLine(r1) + col*4;
-          for(int i = 0; i < 3; i++)
-            rgba[i] = p[i] << 4;
+          BlurAccumulator acc = blurStart(p);
 
           p += bpl;
           for(int j = r1; j < r2; j++, p += bpl)
-            for(int i = 0; i < 3; i++)
-              p[i] = (rgba[i] += (((p[i]<<4)-rgba[i])) >> 1) >> 4;
+            blurStep(acc, p);
         }
 
         for(int row = r1; row <= r2; row++)
         {
           p = result->scanLine(row) + c1*4;
-          for(int i = 0; i < 3; i++)
-            rgba[i] = p[i] << 4;
+          BlurAccumulator acc = blurStart(p);
 
           p += 4;
           for(int j = c1; j < c2; j++, p+=4)
-            for(int i = 0; i < 3; i++)
-              p[i] = (rgba[i] += (((p[i]<<4)-rgba[i])) >> 1) >> 4;
+            blurStep(acc, p);
         }
 
         for(int col = c1; col <= c2; col++)
         {
           p = result->scanLine(r2) + col*4;
-          for(int i = 0; i < 3; i++)
-            rgba[i] = p[i] << 4;
+          BlurAccumulator acc = blurStart(p);
 
           p -= bpl;
           for(int j = r1; j < r2; j++, p -= bpl)
-            for(int i = 0; i < 3; i++)
-              p[i] = (rgba[i] += (((p[i]<<4)-rgba[i])) >> 1) >> 4;
+            blurStep(acc, p);
         }
 
         for(int row = r1; row <= r2; row++)
         {
           p = result->scanLine(row) + c2*4;
-          for(int i = 0; i < 3; i++)
-            rgba[i] = p[i] << 4;
+          BlurAccumulator acc = blurStart(p);
 
           p -= 4;
           for(int j = c1; j < c2; j++, p-=4)
-            for(int i = 0; i < 3; i++)
-              p[i] = (rgba[i] += (((p[i]<<4)-rgba[i])) >> 1) >> 4;
+            blurStep(acc, p);
         }
       }
 
       // overdraw to leave only the reflection blurred (but not the actual image)
+#ifdef PICTUREFLOW_QT4
+      // only the bottom of the image overlaps with the blurred area
+      transposeRows(img, qMax(0, c1 - hofs), h, result, hofs);
+#else
       for(int x = 0; x < w; x++)
         for(int y = 0; y < h; y++)
           result->setPixel(hofs + y, x, img.pixel(x, y));
+#endif
     }
   }
 
@@ -709,9 +893,6 @@ QImage* PictureFlowSoftwareRenderer::surface(int slideIndex)
   if(slideIndex >= (int)state->slideImages.count())
     return 0;
 
-#ifdef PICTUREFLOW_QT4
-  int key = slideIndex;
-#endif
 #if defined(PICTUREFLOW_QT3) || defined(PICTUREFLOW_QT2)
   QString key = QString::number(slideIndex);
 #endif
@@ -720,8 +901,10 @@ QImage* PictureFlowSoftwareRenderer::surface(int slideIndex)
   bool empty = img ? img->isNull() : true;
   if(empty)
   {
+#if defined(PICTUREFLOW_QT3) || defined(PICTUREFLOW_QT2)
     surfaceCache.remove(key);
     imageHash.remove(slideIndex);
+#endif
     if(!blankSurface)
     {
       int sw = state->slideWidth;
@@ -759,9 +942,13 @@ QImage* PictureFlowSoftwareRenderer::surface(int slideIndex)
   }
 
 #ifdef PICTUREFLOW_QT4
-  bool exist = imageHash.contains(slideIndex);
-  if(exist)
-  if(img == imageHash.find(slideIndex).value())
+  // the surfaces only depend on the image content, so that slides sharing
+  // the same image (placeholders) and the slides of a folder which is opened
+  // again reuse them
+  qint64 key = img->cacheKey();
+  QImage* cached = surfaceCache.object(key);
+  if(cached)
+    return cached;
 #endif
 #ifdef PICTUREFLOW_QT3
   bool exist = imageHash.find(slideIndex) != imageHash.end();
@@ -776,20 +963,39 @@ QImage* PictureFlowSoftwareRenderer::surface(int slideIndex)
 
   QImage* sr = prepareSurface(img, state->slideWidth, state->slideHeight, bgcolor, state->reflectionEffect);
   surfaceCache.insert(key, sr);
+#if defined(PICTUREFLOW_QT3) || defined(PICTUREFLOW_QT2)
   imageHash.insert(slideIndex, img);
+#endif
 
   return sr;
 }
 
+// Sorts and clamps the columns limits to the buffer width
+static void clampColumns(int& col1, int& col2, int w)
+{
+  if(col1 > col2)
+  {
+    int c = col2;
+    col2 = col1;
+    col1 = c;
+  }
+
+  col1 = (col1 >= 0) ? col1 : 0;
+  col2 = (col2 >= 0) ? col2 : w-1;
+  col1 = qMin(col1, w-1);
+  col2 = qMin(col2, w-1);
+}
+
 // Renders a slide to offscreen buffer. Returns a rect of the rendered area.
 // col1 and col2 limit the column for rendering.
-QRect PictureFlowSoftwareRenderer::renderSlide(const SlideInfo &slide, int col1, int col2)
+// If draw is false, only the rendered area is computed.
+QRect PictureFlowSoftwareRenderer::renderSlide(const SlideInfo &slide, const QImage* src,
+                                               int col1, int col2, bool draw)
 {
   int blend = slide.blend;
   if(!blend)
     return QRect();
 
-  QImage* src = surface(slide.slideIndex);
   if(!src)
     return QRect();
 
@@ -799,18 +1005,9 @@ QRect PictureFlowSoftwareRenderer::renderSlide(const SlideInfo &slide, int col1,
   int sh = src->width();
   int h = buffer.height();
   int w = buffer.width();
+  int bpl = buffer.bytesPerLine();
 
-  if(col1 > col2)
-  {
-    int c = col2;
-    col2 = col1;
-    col1 = c;
-  }
-
-  col1 = (col1 >= 0) ? col1 : 0;
-  col2 = (col2 >= 0) ? col2 : w-1;
-  col1 = qMin(col1, w-1);
-  col2 = qMin(col2, w-1);
+  clampColumns(col1, col2, w);
 
   int zoom = 100;
   int distance = h * 100 / zoom;
@@ -855,10 +1052,14 @@ QRect PictureFlowSoftwareRenderer::renderSlide(const SlideInfo &slide, int col1,
       rect.setLeft(x);
     flag = true;
 
+    if(!draw)
+      continue;
+
     int y1 = h/2;
     int y2 = y1+ 1;
-    QRgb* pixel1 = (QRgb*)(buffer.scanLine(y1)) + x;
-    QRgb* pixel2 = (QRgb*)(buffer.scanLine(y2)) + x;
+    // bufferBits is used instead of scanLine(), which is not thread-safe
+    QRgb* pixel1 = (QRgb*)(bufferBits + y1 * bpl) + x;
+    QRgb* pixel2 = (QRgb*)(bufferBits + y2 * bpl) + x;
     QRgb pixelstep = pixel2 - pixel1;
 
     int center = (sh/2);
@@ -900,28 +1101,111 @@ QRect PictureFlowSoftwareRenderer::renderSlide(const SlideInfo &slide, int col1,
    return rect;
 }
 
+#ifdef PICTUREFLOW_QT4
+// Finds the area covered by a slide and queues it for rendering.
+QRect PictureFlowSoftwareRenderer::addSlideColumns(const SlideInfo &slide, int col1, int col2)
+{
+  if(!slide.blend)
+    return QRect();
+
+  const QImage* src = surface(slide.slideIndex);
+  if(!src)
+    return QRect();
+
+  SlideColumns columns;
+  columns.slide = &slide;
+  columns.surface = *src;
+  columns.col1 = col1;
+  columns.col2 = col2;
+  clampColumns(columns.col1, columns.col2, buffer.width());
+  slideColumns.append(columns);
+
+  return renderSlide(slide, &columns.surface, col1, col2, false);
+}
+
+// Renders the queued slides in the columns [first,last].
+void PictureFlowSoftwareRenderer::renderColumns(int first, int last)
+{
+  for(int i = 0; i < slideColumns.count(); i++)
+  {
+    const SlideColumns& columns = slideColumns.at(i);
+    int col1 = qMax(columns.col1, first);
+    int col2 = qMin(columns.col2, last);
+    if(col1 <= col2)
+      renderSlide(*columns.slide, &columns.surface, col1, col2);
+  }
+}
+
 void PictureFlowSoftwareRenderer::renderSlides()
 {
   int nleft = state->leftSlides.count();
   int nright = state->rightSlides.count();
 
-  QRect r = renderSlide(state->centerSlide);
+  // find the columns of each slide first, the slides in front hide the ones
+  // behind them, then render the columns in parallel. The surfaces are
+  // prepared on this thread because the cache is not thread-safe.
+  slideColumns.clear();
+
+  QRect r = addSlideColumns(state->centerSlide, -1, -1);
   int c1 = r.left();
   int c2 = r.right();
 
   for(int index = 0; index < nleft; index++)
   {
-    QRect rs = renderSlide(state->leftSlides[index], 0, c1-1);
+    QRect rs = addSlideColumns(state->leftSlides[index], 0, c1-1);
     if(!rs.isEmpty())
       c1 = rs.left();
   }
   for(int index = 0; index < nright; index++)
   {
-    QRect rs = renderSlide(state->rightSlides[index], c2+1, buffer.width());
+    QRect rs = addSlideColumns(state->rightSlides[index], c2+1, buffer.width());
     if(!rs.isEmpty())
       c2 = rs.right();
   }
+
+  int w = buffer.width();
+  int bands = qBound(1, w / MIN_BAND_WIDTH, QThread::idealThreadCount());
+  int bandWidth = (w + bands - 1) / bands;
+
+  QList< QFuture<void> > futures;
+  for(int band = 1; band < bands; band++)
+  {
+    int first = band * bandWidth;
+    int last = qMin(first + bandWidth, w) - 1;
+    futures.append(QtConcurrent::run(this, &PictureFlowSoftwareRenderer::renderColumns,
+                                     first, last));
+  }
+  renderColumns(0, qMin(bandWidth, w) - 1);
+
+  for(int i = 0; i < futures.count(); i++)
+    futures[i].waitForFinished();
 }
+#else
+void PictureFlowSoftwareRenderer::renderSlides()
+{
+  int nleft = state->leftSlides.count();
+  int nright = state->rightSlides.count();
+
+  QRect r = renderSlide(state->centerSlide, surface(state->centerSlide.slideIndex));
+  int c1 = r.left();
+  int c2 = r.right();
+
+  for(int index = 0; index < nleft; index++)
+  {
+    const SlideInfo& slide = state->leftSlides[index];
+    QRect rs = renderSlide(slide, surface(slide.slideIndex), 0, c1-1);
+    if(!rs.isEmpty())
+      c1 = rs.left();
+  }
+  for(int index = 0; index < nright; index++)
+  {
+    const SlideInfo& slide = state->rightSlides[index];
+    QRect rs = renderSlide(slide, surface(slide.slideIndex), c2+1, buffer.width());
+    if(!rs.isEmpty())
+      c2 = rs.right();
+  }
+}
+#endif
 
 void PictureFlowSoftwareRenderer::renderCaption()
 {
@@ -945,6 +1229,7 @@ void PictureFlowSoftwareRenderer::renderCaption()
 void PictureFlowSoftwareRenderer::render()
 {
   buffer.fill(state->backgroundColor);
+  bufferBits = buffer.bits();
   renderSlides();
   renderCaption();
   dirty = false;
@@ -1115,12 +1400,9 @@ void PictureFlow::render()
 {
   d->renderer->dirty = true;
   update();
-  QImage image( geometry().width(), geometry().height(), QImage::Format_ARGB32);
-  QPainter painter( &image );
-  QWidget::render( &painter );
-  painter.end();
 
-  emit imageUpdated( image );
+  // take the buffer of the renderer directly, the widget is usually not visible
+  emit imageUpdated( d->renderer->image( ));
 }
 
 void PictureFlow::triggerRender()
@@ -46,6 +46,7 @@
 #include <QObject>
 #include <QSize>
 #include <QImage>
+#include <QRegion>
 
 /**
  * Interface for Pixel Streamers.
@@ -72,6 +73,12 @@ signals:
     /** Emit this signal after a new image has been generated. */
     void imageUpdated(QImage image);
 
+    /**
+     * Emit this signal after a part of the image has been updated.
+     * Only the segments of the image which intersect the region are sent.
+     */
+    void imageRegionUpdated(QImage image, QRegion region);
+
     /** Emit this signal to send a command to the receiver. */
     void sendCommand(QString uri);
 };
@@ -41,13 +41,18 @@
 
 #include "DockPixelStreamer.h"
 #include "CommandLineOptions.h"
+#include "LocalStreamChannel.h"
 
 #include "log.h"
 #include "PixelStreamWindowManager.h"
 #include "configuration/MasterConfiguration.h"
 
 #include <QCoreApplication>
+#include <QDataStream>
+#include <QLocalServer>
+#include <QLocalSocket>
 #include <QProcess>
+#include <QTimer>
 
 #define DOCK_WIDTH_RELATIVE_TO_WALL   0.175
 
@@ -58,15 +63,47 @@
 #endif
 
 #define WEBBROWSER_DEFAULT_SIZE QSize( 1280, 1024 )
+#define WEBBROWSERS_PER_HOST 8
+
+// Detached processes give no feedback, so a host which does not connect back
+// within this time is considered dead and another one may be started
+#define HOST_START_TIMEOUT_MS 30000
 
 PixelStreamerLauncher::PixelStreamerLauncher( PixelStreamWindowManager& windowManager,
                                               const MasterConfiguration& config )
-    : windowManager_( windowManager )
+    : hostServer_( new QLocalServer( this ))
+    , hostStartTimer_( new QTimer( this ))
+    , hostStarting_( false )
+    , windowManager_( windowManager )
     , config_( config )
 {
     connect( &windowManager_, SIGNAL( pixelStreamWindowClosed( QString )),
              this, SLOT( dereferenceLocalStreamer( QString )),
              Qt::QueuedConnection );
+
+    connect( hostServer_, SIGNAL( newConnection( )),
+             this, SLOT( onHostConnected( )));
+
+    hostStartTimer_->setSingleShot( true );
+    hostStartTimer_->setInterval( HOST_START_TIMEOUT_MS );
+    connect( hostStartTimer_, SIGNAL( timeout( )),
+             this, SLOT( onHostStartTimeout( )));
+
+    const QString serverName = QString( "displaycluster-launcher-%1" )
+                                  .arg( QCoreApplication::applicationPid( ));
+    QLocalServer::removeServer( serverName );
+    if( !hostServer_->listen( serverName ))
+    {
+        put_flog( LOG_WARN, "Could not listen for browser hosts: %s",
+                  hostServer_->errorString().toLocal8Bit().constData( ));
+        return;
+    }
+    ensureSpareHost();
+}
+
+void PixelStreamerLauncher::setLocalServerName( const QString& name )
+{
+    localServerName_ = name;
 }
 
 void PixelStreamerLauncher::openWebBrowser( const QPointF pos, const QSize size,
@@ -84,12 +121,28 @@ void PixelStreamerLauncher::openWebBrowser( const QPointF pos, const QSize size,
     options.setUrl( url );
     options.setWidth( viewportSize.width( ));
     options.setHeight( viewportSize.height( ));
+    options.setLocalServer( localServerName_ );
 
-    processes_[uri] = new QProcess( this );
-    if( !processes_[uri]->startDetached( getLocalStreamerBin(),
-                                         options.getCommandLineArguments(),
-                                         QDir::currentPath( )))
-        put_flog( LOG_ERROR, "Browser process could not be started!" );
+    LocalStreamChannel* host = findAvailableHost();
+    if( host )
+    {
+        QByteArray payload;
+        QDataStream stream( &payload, QIODevice::WriteOnly );
+        stream << options.getCommandLineArguments();
+        if( host->send( MESSAGE_START_STREAMER, payload ))
+        {
+            ++browserHosts_[host];
+            const HostedBrowser browser = { host,
+                                            options.getCommandLineArguments() };
+            hostedBrowsers_[uri] = browser;
+            ensureSpareHost();
+            return;
+        }
+    }
+
+    startBrowserProcess( uri, options.getCommandLineArguments( ));
+
+    ensureSpareHost();
 }
 
 void PixelStreamerLauncher::openDock( const QPointF pos )
@@ -128,6 +181,83 @@ void PixelStreamerLauncher::dereferenceLocalStreamer( const QString uri )
     processes_.erase( uri );
 }
 
+void PixelStreamerLauncher::onHostConnected()
+{
+    while( QLocalSocket* socket = hostServer_->nextPendingConnection( ))
+    {
+        LocalStreamChannel* host = new LocalStreamChannel( socket, this );
+        connect( host, SIGNAL( messageReceived( int, QByteArray )),
+                 this, SLOT( onHostMessage( int, QByteArray )));
+        connect( host, SIGNAL( disconnected( )),
+                 this, SLOT( onHostDisconnected( )));
+        browserHosts_[host] = 0;
+    }
+    hostStarting_ = false;
+    hostStartTimer_->stop();
+}
+
+void PixelStreamerLauncher::onHostMessage( int type, QByteArray payload )
+{
+    if( type != MESSAGE_STREAMER_CLOSED && type != MESSAGE_STREAMER_FAILED )
+        return;
+
+    LocalStreamChannel* host = static_cast<LocalStreamChannel*>( sender( ));
+    BrowserHosts::iterator it = browserHosts_.find( host );
+    if( it != browserHosts_.end() && it->second > 0 )
+        --it->second;
+
+    QString uri;
+    QDataStream stream( payload );
+    stream >> uri;
+
+    HostedBrowsers::iterator browser = hostedBrowsers_.find( uri );
+    if( browser == hostedBrowsers_.end( ))
+        return;
+    const QStringList arguments = browser->second.arguments;
+    hostedBrowsers_.erase( browser );
+
+    if( type == MESSAGE_STREAMER_FAILED )
+    {
+        put_flog( LOG_WARN, "A browser host could not start '%s', starting "
+                  "it in its own process", uri.toLocal8Bit().constData( ));
+        startBrowserProcess( uri, arguments );
+        ensureSpareHost();
+    }
+}
+
+void PixelStreamerLauncher::onHostDisconnected()
+{
+    LocalStreamChannel* host = static_cast<LocalStreamChannel*>( sender( ));
+    BrowserHosts::iterator it = browserHosts_.find( host );
+    if( it != browserHosts_.end( ))
+    {
+        if( it->second > 0 )
+            put_flog( LOG_WARN, "A browser host exited with %d open browsers",
+                      it->second );
+        browserHosts_.erase( it );
+    }
+
+    HostedBrowsers::iterator browser = hostedBrowsers_.begin();
+    while( browser != hostedBrowsers_.end( ))
+    {
+        if( browser->second.host == host )
+            hostedBrowsers_.erase( browser++ );
+        else
+            ++browser;
+    }
+    host->deleteLater();
+}
+
+void PixelStreamerLauncher::onHostStartTimeout()
+{
+    if( !hostStarting_ )
+        return;
+
+    put_flog( LOG_WARN, "Browser host did not connect within %d ms",
+              HOST_START_TIMEOUT_MS );
+    hostStarting_ = false;
+}
+
 bool PixelStreamerLauncher::createDock( const QSize& size,
                                         const QString& rootDir )
 {
@@ -141,6 +271,7 @@ bool PixelStreamerLauncher::createDock( const QSize& size,
     options.setRootDir( rootDir );
     options.setWidth( size.width( ));
     options.setHeight( size.height( ));
+    options.setLocalServer( localServerName_ );
 
     processes_[uri] = new QProcess( this );
     return processes_[uri]->startDetached( getLocalStreamerBin(),
@@ -153,3 +284,61 @@ QString PixelStreamerLauncher::getLocalStreamerBin() const
     const QString& appDir = QCoreApplication::applicationDirPath();
     return QString( "%1/%2" ).arg( appDir, LOCALSTREAMER_BIN );
 }
+
+void PixelStreamerLauncher::startBrowserProcess( const QString& uri,
+                                                 const QStringList& arguments )
+{
+    processes_[uri] = new QProcess( this );
+    if( !processes_[uri]->startDetached( getLocalStreamerBin(), arguments,
+                                         QDir::currentPath( )))
+        put_flog( LOG_ERROR, "Browser process could not be started!" );
+}
+
+LocalStreamChannel* PixelStreamerLauncher::findAvailableHost() const
+{
+    // Fill the busiest host first so that idle hosts stay available
+    LocalStreamChannel* host = 0;
+    unsigned int hostLoad = 0;
+    for( BrowserHosts::const_iterator it = browserHosts_.begin();
+         it != browserHosts_.end(); ++it )
+    {
+        if( it->second >= WEBBROWSERS_PER_HOST || !it->first->isConnected( ))
+            continue;
+        if( !host || it->second > hostLoad )
+        {
+            host = it->first;
+            hostLoad = it->second;
+        }
+    }
+    return host;
+}
+
+void PixelStreamerLauncher::ensureSpareHost()
+{
+    if( hostStarting_ || !hostServer_->isListening( ))
+        return;
+
+    for( BrowserHosts::const_iterator it = browserHosts_.begin();
+         it != browserHosts_.end(); ++it )
+    {
+        if( it->second < WEBBROWSERS_PER_HOST )
+            return;
+    }
+
+    hostStarting_ = startBrowserHost();
+    if( hostStarting_ )
+        hostStartTimer_->start();
+    else
+        put_flog( LOG_WARN, "Browser host process could not be started" );
+}
+
+bool PixelStreamerLauncher::startBrowserHost()
+{
+    CommandLineOptions options;
+    options.setPixelStreamerType( PS_WEBKIT );
+    options.setHostServer( hostServer_->fullServerName( ));
+
+    return QProcess::startDetached( getLocalStreamerBin(),
+                                    options.getCommandLineArguments(),
+                                    QDir::currentPath( ));
+}
@@ -44,9 +44,14 @@
 
 #include <QObject>
 #include <QPointF>
+#include <QString>
+#include <QStringList>
 #include <QSize>
 
+class QLocalServer;
 class QProcess;
+class QTimer;
+class LocalStreamChannel;
 class PixelStreamWindowManager;
 class MasterConfiguration;
 
@@ -63,6 +68,15 @@ class MasterConfiguration;
  * In practice, this doesn't seem to happen; our processes exit when the
  * deflect::Stream is closed in any case.
  *
+ * WebBrowsers are preferably run by "host" localstreamer processes which are
+ * started in advance and connect back to the launcher on a local socket. A
+ * host runs several browsers, saving the startup and WebKit initialization
+ * cost of a new process for each of them. The number of browsers per host is
+ * capped so that a crashing page only takes a limited number of others down
+ * with it. When no host has spare capacity, the browser is started in its own
+ * process as before and a new host is launched for the next requests. The
+ * same happens when a host reports that it could not start a browser.
+ *
  * (*) MPI captures the SIGCHLD that QProcess relies on to detect that the
  * process has finished. Thus, the call to waitForFinished() blocks forever in
  * QProcess destructor...
@@ -81,6 +95,15 @@ public:
     PixelStreamerLauncher( PixelStreamWindowManager& windowManager,
                            const MasterConfiguration& config );
 
+    /**
+     * Set the local server used by the streamers to send their frames through
+     * shared memory.
+     *
+     * @param name The name of the LocalStreamServer, or an empty string to
+     *        stream through deflect only.
+     */
+    void setLocalServerName( const QString& name );
+
 public slots:
     /**
      * Open a WebBrowser.
@@ -119,15 +142,43 @@ public slots:
 private slots:
     void dereferenceLocalStreamer( const QString uri );
 
+    void onHostConnected();
+    void onHostMessage( int type, QByteArray payload );
+    void onHostDisconnected();
+    void onHostStartTimeout();
+
 private:
     typedef std::map< QString, QProcess* > Streamers;
     Streamers processes_;
 
+    /** The browser hosts and the number of browsers each one runs. */
+    typedef std::map< LocalStreamChannel*, unsigned int > BrowserHosts;
+    BrowserHosts browserHosts_;
+    /** The browsers run by hosts and their command line, by uri. */
+    struct HostedBrowser
+    {
+        LocalStreamChannel* host;
+        QStringList arguments;
+    };
+    typedef std::map< QString, HostedBrowser > HostedBrowsers;
+    HostedBrowsers hostedBrowsers_;
+
+    QLocalServer* hostServer_;
+    QTimer* hostStartTimer_;
+    bool hostStarting_;
+    QString localServerName_;
+
     PixelStreamWindowManager& windowManager_;
     const MasterConfiguration& config_;
 
     bool createDock( const QSize& size, const QString& rootDir );
     QString getLocalStreamerBin() const;
+    void startBrowserProcess( const QString& uri,
+                              const QStringList& arguments );
+
+    LocalStreamChannel* findAvailableHost() const;
+    void ensureSpareHost();
+    bool startBrowserHost();
 };
 
 #endif // PIXELSTREAMERLAUNCHER_H
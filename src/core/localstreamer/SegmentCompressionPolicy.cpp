@@ -0,0 +1,172 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "SegmentCompressionPolicy.h"
+
+#include <boost/bimap.hpp>
+#include <boost/assign/list_of.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+// Segments changing more often than this [Hz] are always compressed
+#define MIN_CHANGE_RATE_FOR_COMPRESSION  2.0
+// Other changed segments with a higher entropy [bits/pixel] are compressed
+#define MIN_ENTROPY_FOR_COMPRESSION      6.0
+// Weight of the latest change in the moving average of the change rate
+#define CHANGE_RATE_SMOOTHING            0.5
+// Only one pixel out of ENTROPY_SAMPLING_STEP^2 is used to compute entropy
+#define ENTROPY_SAMPLING_STEP            4
+
+typedef boost::bimap< CompressionMode, QString > ModeMap;
+static ModeMap modemap = boost::assign::list_of< ModeMap::relation >
+        (COMPRESSION_AUTO, QString("auto"))
+        (COMPRESSION_ALWAYS, QString("on"))
+        (COMPRESSION_NEVER, QString("off"));
+
+QString getCompressionModeString( const CompressionMode mode )
+{
+    return modemap.left.find( mode )->second;
+}
+
+CompressionMode getCompressionMode( const QString& modeString )
+{
+    if( modemap.right.count( modeString ))
+        return modemap.right.find( modeString )->second;
+
+    return COMPRESSION_AUTO;
+}
+
+SegmentCompressionPolicy::SegmentCompressionPolicy( const CompressionMode mode,
+                                                    const unsigned int quality )
+    : mode_( mode )
+    , quality_( std::max( 1u, std::min( quality, 100u )))
+{
+}
+
+unsigned int SegmentCompressionPolicy::getQuality() const
+{
+    return quality_;
+}
+
+bool SegmentCompressionPolicy::shouldCompress( const QImage& segment,
+                                               const QPoint& position,
+                                               const qint64 timestamp )
+{
+    switch( mode_ )
+    {
+    case COMPRESSION_ALWAYS:
+        return true;
+    case COMPRESSION_NEVER:
+        return false;
+    case COMPRESSION_AUTO:
+    default:
+        break;
+    }
+
+    const QByteArray pixels = QByteArray::fromRawData(
+                (const char*)segment.constBits(), segment.byteCount( ));
+
+    bool changed = false;
+    const double rate = changeRate( position, qHash( pixels ), timestamp,
+                                    changed );
+    if( !changed )
+        return false;
+
+    if( rate >= MIN_CHANGE_RATE_FOR_COMPRESSION )
+        return true;
+
+    return computeEntropy( segment ) >= MIN_ENTROPY_FOR_COMPRESSION;
+}
+
+double SegmentCompressionPolicy::changeRate( const QPoint& position,
+                                             const uint contentHash,
+                                             const qint64 timestamp,
+                                             bool& changed )
+{
+    const Position key( position.x(), position.y( ));
+    if( !history_.contains( key ))
+    {
+        const SegmentHistory history = { timestamp, 0.0, contentHash };
+        history_.insert( key, history );
+        changed = true;
+        return 0.0;
+    }
+
+    SegmentHistory& history = history_[key];
+    const qint64 interval = std::max( timestamp - history.lastChange, qint64(1) );
+    const double rate = 1000.0 / (double)interval;
+
+    changed = contentHash != history.contentHash;
+    if( !changed )
+    {
+        // The rate decays while the content stays the same
+        return std::min( history.changeRate, rate );
+    }
+
+    history.changeRate = CHANGE_RATE_SMOOTHING * rate +
+                         (1.0 - CHANGE_RATE_SMOOTHING) * history.changeRate;
+    history.lastChange = timestamp;
+    history.contentHash = contentHash;
+    return history.changeRate;
+}
+
+double SegmentCompressionPolicy::computeEntropy( const QImage& image )
+{
+    unsigned int histogram[256] = { 0 };
+    unsigned int count = 0;
+
+    for( int y = 0; y < image.height(); y += ENTROPY_SAMPLING_STEP )
+    {
+        for( int x = 0; x < image.width(); x += ENTROPY_SAMPLING_STEP )
+        {
+            ++histogram[qGray( image.pixel( x, y ))];
+            ++count;
+        }
+    }
+
+    double entropy = 0.0;
+    for( int i = 0; i < 256; ++i )
+    {
+        if( histogram[i] == 0 )
+            continue;
+        const double p = (double)histogram[i] / (double)count;
+        entropy -= p * std::log( p ) / std::log( 2.0 );
+    }
+    return entropy;
+}
@@ -0,0 +1,124 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef SEGMENTCOMPRESSIONPOLICY_H
+#define SEGMENTCOMPRESSIONPOLICY_H
+
+#include <QHash>
+#include <QImage>
+#include <QPair>
+#include <QPoint>
+#include <QString>
+
+/** The compression modes of the local streamers. */
+enum CompressionMode
+{
+    COMPRESSION_AUTO,   /**< Choose for each segment */
+    COMPRESSION_ALWAYS, /**< Compress all segments */
+    COMPRESSION_NEVER   /**< Send all segments uncompressed */
+};
+
+/** Get the String representation for a CompressionMode. */
+QString getCompressionModeString( const CompressionMode mode );
+
+/** Get the CompressionMode from its String representation. */
+CompressionMode getCompressionMode( const QString& modeString );
+
+/**
+ * Choose between JPEG and raw pixels for each segment of a stream.
+ *
+ * Raw segments are expensive to transmit but free to decode and preserve
+ * sharp text, while JPEG segments need to be decoded by the walls. In auto
+ * mode, segments whose content changes frequently (animations, videos,
+ * scrolling) are compressed, because bandwidth is the limiting factor for
+ * them. Other changed segments are only compressed if their content looks
+ * like a photograph, which JPEG reduces many times without visible artifacts.
+ * Segments resent with unchanged content, like the periodic full refresh of
+ * an idle stream, are sent lossless to replace any compressed version.
+ */
+class SegmentCompressionPolicy
+{
+public:
+    /**
+     * Constructor.
+     * @param mode The compression mode.
+     * @param quality The JPEG quality of compressed segments [1-100].
+     */
+    SegmentCompressionPolicy( CompressionMode mode = COMPRESSION_AUTO,
+                              unsigned int quality = 75 );
+
+    /** @return The JPEG quality of compressed segments. */
+    unsigned int getQuality() const;
+
+    /**
+     * Decide if a segment should be compressed. Must be called once for each
+     * segment sent, as it also records how often the content of the segment
+     * changes.
+     * @param segment The image of the segment.
+     * @param position The position of the segment in the stream.
+     * @param timestamp The current time in milliseconds.
+     * @return true if the segment should be compressed.
+     */
+    bool shouldCompress( const QImage& segment, const QPoint& position,
+                         qint64 timestamp );
+
+    /**
+     * Estimate the entropy of the luminance of an image from a subset of its
+     * pixels.
+     * @return The entropy in bits per pixel [0-8].
+     */
+    static double computeEntropy( const QImage& image );
+
+private:
+    struct SegmentHistory
+    {
+        qint64 lastChange;
+        double changeRate;
+        uint contentHash;
+    };
+    typedef QPair<int, int> Position;
+
+    CompressionMode mode_;
+    unsigned int quality_;
+    QHash<Position, SegmentHistory> history_;
+
+    double changeRate( const QPoint& position, uint contentHash,
+                       qint64 timestamp, bool& changed );
+};
+
+#endif // SEGMENTCOMPRESSIONPOLICY_H
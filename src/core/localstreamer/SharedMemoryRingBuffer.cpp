@@ -0,0 +1,196 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "SharedMemoryRingBuffer.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QStringList>
+
+#ifdef Q_OS_UNIX
+#  include <errno.h>
+#  include <signal.h>
+#  include <sys/ipc.h>
+#  include <sys/shm.h>
+#endif
+
+// Key files without a segment may belong to a segment being created
+#define MIN_ORPHANED_KEY_FILE_AGE_SECS 60
+
+SharedMemoryRingBuffer::SharedMemoryRingBuffer( const QString& key )
+    : memory_( key )
+    , slotSize_( 0 )
+    , nextSlot_( 0 )
+{
+}
+
+bool SharedMemoryRingBuffer::create( const unsigned int slotSize,
+                                     const unsigned int slotCount )
+{
+    if( slotSize == 0 || slotCount == 0 )
+        return false;
+
+    if( !memory_.create( slotSize * slotCount ))
+        return false;
+
+    slotSize_ = slotSize;
+    acquired_ = QVector<bool>( slotCount, false );
+    nextSlot_ = 0;
+    return true;
+}
+
+bool SharedMemoryRingBuffer::attach( const unsigned int slotSize,
+                                     const unsigned int slotCount )
+{
+    if( !memory_.attach( QSharedMemory::ReadOnly ))
+        return false;
+
+    if( (unsigned int)memory_.size() < slotSize * slotCount )
+    {
+        memory_.detach();
+        return false;
+    }
+
+    slotSize_ = slotSize;
+    acquired_ = QVector<bool>( slotCount, false );
+    nextSlot_ = 0;
+    return true;
+}
+
+QString SharedMemoryRingBuffer::getKey() const
+{
+    return memory_.key();
+}
+
+unsigned int SharedMemoryRingBuffer::getSlotSize() const
+{
+    return slotSize_;
+}
+
+unsigned int SharedMemoryRingBuffer::getSlotCount() const
+{
+    return acquired_.size();
+}
+
+int SharedMemoryRingBuffer::acquireSlot()
+{
+    const unsigned int slotCount = getSlotCount();
+    for( unsigned int i = 0; i < slotCount; ++i )
+    {
+        const unsigned int slot = ( nextSlot_ + i ) % slotCount;
+        if( !acquired_[slot] )
+        {
+            acquired_[slot] = true;
+            nextSlot_ = ( slot + 1 ) % slotCount;
+            return slot;
+        }
+    }
+    return -1;
+}
+
+void SharedMemoryRingBuffer::releaseSlot( const unsigned int slot )
+{
+    if( slot < getSlotCount( ))
+        acquired_[slot] = false;
+}
+
+bool SharedMemoryRingBuffer::hasAcquiredSlots() const
+{
+    return acquired_.contains( true );
+}
+
+uchar* SharedMemoryRingBuffer::getSlot( const unsigned int slot )
+{
+    if( slot >= getSlotCount() || !memory_.isAttached( ))
+        return 0;
+    return static_cast<uchar*>( memory_.data( )) + slot * slotSize_;
+}
+
+const uchar* SharedMemoryRingBuffer::getSlot( const unsigned int slot ) const
+{
+    if( slot >= getSlotCount() || !memory_.isAttached( ))
+        return 0;
+    return static_cast<const uchar*>( memory_.constData( )) + slot * slotSize_;
+}
+
+int SharedMemoryRingBuffer::removeOrphans( const QString& keyPrefix )
+{
+#ifdef Q_OS_UNIX
+    // QSharedMemory derives its System V key from a file in the temporary
+    // folder, named after the letters of the key followed by its hash
+    QString filter = keyPrefix;
+    filter.remove( QRegExp( "[^A-Za-z]" ));
+    const QFileInfoList files = QDir( QDir::tempPath( )).entryInfoList(
+        QStringList( "qipc_sharedmemory_" + filter + "*" ), QDir::Files );
+
+    const QDateTime oldestAllowed =
+        QDateTime::currentDateTime().addSecs( -MIN_ORPHANED_KEY_FILE_AGE_SECS );
+
+    int removed = 0;
+    foreach( const QFileInfo& file, files )
+    {
+        const QByteArray path = QFile::encodeName( file.absoluteFilePath( ));
+        const key_t key = ftok( path.constData(), 'Q' );
+        const int id = key == -1 ? -1 : shmget( key, 0, 0 );
+        if( id == -1 )
+        {
+            if( file.lastModified() < oldestAllowed )
+                QFile::remove( file.absoluteFilePath( ));
+            continue;
+        }
+
+        struct shmid_ds info;
+        if( shmctl( id, IPC_STAT, &info ) != 0 || info.shm_nattch > 0 )
+            continue;
+        if( kill( info.shm_cpid, 0 ) == 0 || errno != ESRCH )
+            continue;
+
+        if( shmctl( id, IPC_RMID, 0 ) == 0 )
+        {
+            QFile::remove( file.absoluteFilePath( ));
+            ++removed;
+        }
+    }
+    return removed;
+#else
+    Q_UNUSED( keyPrefix );
+    return 0;
+#endif
+}
@@ -0,0 +1,124 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef SHAREDMEMORYRINGBUFFER_H
+#define SHAREDMEMORYRINGBUFFER_H
+
+#include <QSharedMemory>
+#include <QString>
+#include <QVector>
+
+/**
+ * A fixed number of equally sized slots in a shared memory segment.
+ *
+ * The writer creates the segment and acquires the slots in a round-robin
+ * fashion, the reader attaches to it and tells the writer when a slot can be
+ * reused. The slots themselves are not protected by a lock; the ownership of
+ * each slot must be transferred with messages between the two processes.
+ */
+class SharedMemoryRingBuffer
+{
+public:
+    /**
+     * Constructor.
+     * @param key The system-wide key of the shared memory segment.
+     */
+    explicit SharedMemoryRingBuffer( const QString& key );
+
+    /**
+     * Create the shared memory segment (writer side).
+     * @param slotSize The size of each slot in bytes.
+     * @param slotCount The number of slots.
+     * @return true on success.
+     */
+    bool create( unsigned int slotSize, unsigned int slotCount );
+
+    /**
+     * Attach to an existing shared memory segment (reader side).
+     * @param slotSize The size of each slot in bytes.
+     * @param slotCount The number of slots.
+     * @return true on success, false if the segment does not exist or is
+     *         too small.
+     */
+    bool attach( unsigned int slotSize, unsigned int slotCount );
+
+    /** Get the system-wide key of the shared memory segment. */
+    QString getKey() const;
+
+    /** Get the size of each slot in bytes. */
+    unsigned int getSlotSize() const;
+
+    /** Get the number of slots. */
+    unsigned int getSlotCount() const;
+
+    /**
+     * Acquire the next free slot for writing.
+     * @return the index of the slot, or -1 if all slots are in use.
+     */
+    int acquireSlot();
+
+    /** Make a slot available again after the reader is done with it. */
+    void releaseSlot( unsigned int slot );
+
+    /** Check if some slots have been acquired and not released yet. */
+    bool hasAcquiredSlots() const;
+
+    /** Get the data of a slot, or 0 if the index is invalid. */
+    uchar* getSlot( unsigned int slot );
+
+    /** @copydoc getSlot */
+    const uchar* getSlot( unsigned int slot ) const;
+
+    /**
+     * Remove the segments left behind by processes which crashed.
+     *
+     * A segment is orphaned when nobody is attached to it anymore and its
+     * creator is not running. Only implemented for System V shared memory.
+     * @param keyPrefix The prefix of the keys of the segments to check.
+     * @return The number of segments removed.
+     */
+    static int removeOrphans( const QString& keyPrefix );
+
+private:
+    QSharedMemory memory_;
+    unsigned int slotSize_;
+    QVector<bool> acquired_;
+    unsigned int nextSlot_;
+};
+
+#endif // SHAREDMEMORYRINGBUFFER_H
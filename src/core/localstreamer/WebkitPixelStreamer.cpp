@@ -45,6 +45,7 @@
 #include <QKeyEvent>
 
 #include <QTimer>
+#include <QDateTime>
 
 #include "log.h"
 #include "WebkitAuthenticationHelper.h"
@@ -55,6 +56,15 @@
 
 #define WEBPAGE_DEFAULT_ZOOM   2.0
 
+// Minimum interval between two frames, repaint requests are merged meanwhile
+#define FRAME_INTERVAL_MS      30
+
+// The receiver only displays the latest frame it gets, so regions are sent
+// again in the following frames for this duration in case a frame is skipped
+#define REGION_RESEND_TIME_MS  1000
+// Delay after the last update before sending a complete frame
+#define REFRESH_DELAY_MS       1000
+
 WebkitPixelStreamer::WebkitPixelStreamer(const QSize& webpageSize, const QString& url)
     : PixelStreamer()
     , authenticationHelper_(new WebkitAuthenticationHelper(webView_))
@@ -74,15 +84,30 @@ WebkitPixelStreamer::WebkitPixelStreamer(const QSize& webpageSize, const QString
     settings->setAttribute( QWebSettings::WebGLEnabled, true );
 #endif
 
+    // Repaint requests can be emitted while processing events or rendering
+    QWebPage* page = webView_.page();
+    connect(page, SIGNAL(repaintRequested(QRect)),
+            this, SLOT(addDirtyRect(QRect)), Qt::QueuedConnection);
+    connect(page, SIGNAL(scrollRequested(int, int, QRect)),
+            this, SLOT(addScrolledRect(int, int, QRect)), Qt::QueuedConnection);
+
     setUrl(url);
 
+    timer_.setSingleShot(true);
+    timer_.setInterval(FRAME_INTERVAL_MS);
     connect(&timer_, SIGNAL(timeout()), this, SLOT(update()));
-    timer_.start(30);
+
+    refreshTimer_.setSingleShot(true);
+    refreshTimer_.setInterval(REFRESH_DELAY_MS);
+    connect(&refreshTimer_, SIGNAL(timeout()), this, SLOT(sendRefreshFrame()));
+
+    scheduleUpdate();
 }
 
 WebkitPixelStreamer::~WebkitPixelStreamer()
 {
     timer_.stop();
+    refreshTimer_.stop();
 }
 
 void WebkitPixelStreamer::setUrl(const QString& url)
@@ -136,6 +161,10 @@ void WebkitPixelStreamer::processEvent(deflect::Event dcEvent)
     default:
         break;
     }
+
+    // WebGL content is composited without emitting repaint requests
+    if (interactionModeActive_)
+        scheduleUpdate();
 }
 
 void WebkitPixelStreamer::processClickEvent(const deflect::Event &clickEvent)
@@ -266,6 +295,8 @@ void WebkitPixelStreamer::setSize(const QSize& webpageSize)
 void WebkitPixelStreamer::recomputeZoomFactor()
 {
     webView_.setZoomFactor( qreal(size().width()) / qreal(initialWidth_) );
+    dirtyRegion_ = QRegion( QRect( QPoint(), size( )));
+    scheduleUpdate();
 }
 
 QSize WebkitPixelStreamer::size() const
@@ -278,17 +309,84 @@ void WebkitPixelStreamer::update()
     QMutexLocker locker(&mutex_);
 
     QWebPage* page = webView_.page();
-    if( !page->viewportSize().isEmpty())
+    if( page->viewportSize().isEmpty())
+        return;
+
+    if (image_.size() != page->viewportSize())
     {
-        if (image_.size() != page->viewportSize())
-            image_ = QImage( page->viewportSize(), QImage::Format_ARGB32 );
+        image_ = QImage( page->viewportSize(), QImage::Format_ARGB32 );
+        dirtyRegion_ = QRegion( image_.rect( ));
+        sentRegions_.clear();
+    }
+
+    // WebGL content is composited without emitting repaint requests, keep
+    // repainting the whole page while the user interacts with it
+    if (interactionModeActive_)
+    {
+        dirtyRegion_ = QRegion( image_.rect( ));
+        scheduleUpdate();
+    }
+
+    dirtyRegion_ &= image_.rect();
+    if (dirtyRegion_.isEmpty())
+        return;
+
+    QPainter painter( &image_ );
+    page->mainFrame()->render( &painter, dirtyRegion_ );
+    painter.end();
+
+    const QRegion region = getRegionToSend( QDateTime::currentMSecsSinceEpoch( ));
+    dirtyRegion_ = QRegion();
+
+    // Once the page is idle, send a complete frame to make sure that the
+    // receiver has not missed any update
+    refreshTimer_.start();
+
+    emit imageRegionUpdated(image_, region);
+}
+
+void WebkitPixelStreamer::sendRefreshFrame()
+{
+    QMutexLocker locker(&mutex_);
+
+    if (image_.isNull())
+        return;
+
+    sentRegions_.clear();
+    emit imageUpdated(image_);
+}
 
-        QPainter painter( &image_ );
-        page->mainFrame()->render( &painter );
-        painter.end();
+void WebkitPixelStreamer::scheduleUpdate()
+{
+    if (!timer_.isActive())
+        timer_.start();
+}
 
-        emit imageUpdated(image_);
+QRegion WebkitPixelStreamer::getRegionToSend(const qint64 now)
+{
+    while (!sentRegions_.empty() &&
+           now - sentRegions_.front().first > REGION_RESEND_TIME_MS)
+    {
+        sentRegions_.pop_front();
     }
+    sentRegions_.append( qMakePair( now, dirtyRegion_ ));
+
+    QRegion region;
+    for (int i = 0; i < sentRegions_.size(); ++i)
+        region += sentRegions_[i].second;
+    return region;
+}
+
+void WebkitPixelStreamer::addDirtyRect(const QRect& rect)
+{
+    dirtyRegion_ += rect;
+    scheduleUpdate();
+}
+
+void WebkitPixelStreamer::addScrolledRect(int, int, const QRect& rectToScroll)
+{
+    dirtyRegion_ += rectToScroll;
+    scheduleUpdate();
 }
 
 QWebHitTestResult WebkitPixelStreamer::performHitTest(const deflect::Event &dcEvent) const
@@ -44,6 +44,7 @@
 
 #include <QString>
 #include <QImage>
+#include <QRegion>
 #include <QTimer>
 #include <QWebView>
 #include <QMutex>
@@ -96,16 +97,25 @@ public slots:
 
 private slots:
     void update();
+    void sendRefreshFrame();
+    void addDirtyRect(const QRect& rect);
+    void addScrolledRect(int dx, int dy, const QRect& rectToScroll);
 
 private:
     QWebView webView_;
     boost::scoped_ptr<WebkitAuthenticationHelper> authenticationHelper_;
     boost::scoped_ptr<WebkitHtmlSelectReplacer> selectReplacer_;
     QTimer timer_;
+    QTimer refreshTimer_;
     QMutex mutex_;
 
     QImage image_;
 
+    // Regions of image_ which need to be repainted
+    QRegion dirtyRegion_;
+    // Recently sent regions, with their timestamp
+    QList< QPair< qint64, QRegion > > sentRegions_;
+
     bool interactionModeActive_;
 
     unsigned int initialWidth_;
@@ -124,6 +134,8 @@ private:
     bool isWebGLElement(const QWebElement &element) const;
     void setSize(const QSize& webpageSize);
     void recomputeZoomFactor();
+    void scheduleUpdate();
+    QRegion getRegionToSend(qint64 now);
 };
 
 #endif // WEBKITPIXELSTREAMER_H
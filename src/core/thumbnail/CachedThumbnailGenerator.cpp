@@ -0,0 +1,84 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "CachedThumbnailGenerator.h"
+
+#include <QMutex>
+#include <QSet>
+#include <QWaitCondition>
+
+namespace
+{
+QMutex inProgressMutex;
+QWaitCondition inProgressChanged;
+QSet<QString> inProgress;
+}
+
+CachedThumbnailGenerator::CachedThumbnailGenerator(ThumbnailGeneratorPtr generator,
+                                                   const QSize& size)
+    : ThumbnailGenerator(size)
+    , generator_(generator)
+{
+}
+
+QImage CachedThumbnailGenerator::generate(const QString& filename) const
+{
+    const QString key = cache_.getKey(filename, size_);
+    if (key.isEmpty())
+        return generator_->generate(filename);
+
+    QMutexLocker locker(&inProgressMutex);
+    while (inProgress.contains(key))
+        inProgressChanged.wait(&inProgressMutex);
+    inProgress.insert(key);
+    locker.unlock();
+
+    QImage image = cache_.load(key);
+    if (image.isNull())
+    {
+        image = generator_->generate(filename);
+        if (!image.isNull())
+            cache_.save(key, image);
+    }
+
+    locker.relock();
+    inProgress.remove(key);
+    inProgressChanged.wakeAll();
+
+    return image;
+}
@@ -160,6 +160,7 @@ QFileInfoList FolderThumbnailGenerator::getSupportedFilesInDir(QDir dir) const
     dir.setFilter( QDir::Files | QDir::NoDotAndDotDot );
     QStringList filters = ContentFactory::getSupportedFilesFilter();
     filters.append( "*.dcx" );
+    filters.append( "*.dcxb" );
     dir.setNameFilters( filters );
     return dir.entryInfoList();
 }
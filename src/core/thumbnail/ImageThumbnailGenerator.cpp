@@ -39,8 +39,9 @@
 
 #include "ImageThumbnailGenerator.h"
 
+#include "ThumbnailReader.h"
+
 #include <QFileInfo>
-#include <QImageReader>
 
 #include "log.h"
 
@@ -56,17 +57,20 @@ QImage ImageThumbnailGenerator::generate(const QString &filename) const
 {
     QImage img;
 
-    QImageReader reader( filename );
+    ThumbnailReader reader( filename, size_, aspectRatioMode_ );
     if( reader.canRead( ))
     {
-        if (QFileInfo(filename).size() < MAX_IMAGE_FILE_SIZE)
+        // Large files are only decoded if it can be done at a reduced size
+        if (QFileInfo(filename).size() < MAX_IMAGE_FILE_SIZE ||
+                reader.supportsScaledDecoding())
         {
             img = reader.read();
-            img = img.scaled(size_, aspectRatioMode_);
         }
         else
         {
-            img = createLargeImagePlaceholder();
+            img = reader.readEmbeddedThumbnail();
+            if( img.isNull( ))
+                img = createLargeImagePlaceholder();
         }
         addMetadataToImage(img, filename);
         return img;
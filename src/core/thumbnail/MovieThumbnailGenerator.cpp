@@ -39,9 +39,7 @@
 
 #include "MovieThumbnailGenerator.h"
 
-#include "FFMPEGMovie.h"
-
-#define PREVIEW_RELATIVE_POSITION  0.5
+#include "MovieMetadataCache.h"
 
 MovieThumbnailGenerator::MovieThumbnailGenerator(const QSize &size)
     : ThumbnailGenerator(size)
@@ -50,17 +48,11 @@ MovieThumbnailGenerator::MovieThumbnailGenerator(const QSize &size)
 
 QImage MovieThumbnailGenerator::generate(const QString &filename) const
 {
-    FFMPEGMovie movie(filename);
-
-    if( !movie.isValid() )
-        return createErrorImage("movie");
-
-    if ( !movie.jumpTo( PREVIEW_RELATIVE_POSITION * movie.getDuration( )))
+    MovieMetadata metadata;
+    if( !MovieMetadataCache::get( filename, metadata ) || metadata.thumbnail.isNull( ))
         return createErrorImage("movie");
 
-    QImage image( (uchar*)movie.getData(), movie.getWidth(), movie.getHeight(), QImage::Format_ARGB32 );
-    image = image.scaled(size_, aspectRatioMode_);
-    image = image.rgbSwapped();
+    QImage image = metadata.thumbnail.scaled(size_, aspectRatioMode_);
     addMetadataToImage(image, filename);
     return image;
 }
@@ -39,7 +39,7 @@
 
 #include "PDFThumbnailGenerator.h"
 
-#include "PDF.h"
+#include "PDFDocument.h"
 #include "log.h"
 
 PDFThumbnailGenerator::PDFThumbnailGenerator(const QSize &size)
@@ -49,8 +49,17 @@ PDFThumbnailGenerator::PDFThumbnailGenerator(const QSize &size)
 
 QImage PDFThumbnailGenerator::generate(const QString &filename) const
 {
-    PDF pdf(filename);
-    QImage image = pdf.renderToImage();
+    QImage image;
+
+    const PDFDocumentPtr document = PDFDocument::get(filename);
+    const QSizeF pageSize = document ? document->getPageSize(0) : QSizeF();
+    if (!pageSize.isEmpty())
+    {
+        // Rasterize the first page directly at the thumbnail resolution
+        const QSizeF thumbnailSize = pageSize.scaled(size_, aspectRatioMode_);
+        const double resolution = 72.0 * thumbnailSize.width() / pageSize.width();
+        image = document->renderPage(0, resolution);
+    }
 
     if (image.isNull())
     {
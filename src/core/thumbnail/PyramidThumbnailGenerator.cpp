@@ -39,7 +39,7 @@
 
 #include "PyramidThumbnailGenerator.h"
 
-#include <QImageReader>
+#include "ThumbnailReader.h"
 
 #include "log.h"
 
@@ -50,11 +50,10 @@ PyramidThumbnailGenerator::PyramidThumbnailGenerator(const QSize &size)
 
 QImage PyramidThumbnailGenerator::generate(const QString &filename) const
 {
-    QImageReader reader( filename + "amid/0.jpg" );
+    ThumbnailReader reader( filename + "amid/0.jpg", size_, aspectRatioMode_ );
     if (reader.canRead())
     {
         QImage image = reader.read();
-        image = image.scaled(size_, aspectRatioMode_);
         addMetadataToImage(image, filename);
         return image;
     }
@@ -0,0 +1,153 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "ThumbnailCache.h"
+
+#include "CacheDirectory.h"
+#include "log.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSet>
+#include <QTemporaryFile>
+
+#include <cstdio>
+
+#define CACHE_SUBFOLDER "/displaycluster/thumbnails"
+
+// Thumbnails are a few tens of kB each
+#define MAX_CACHE_SIZE_BYTES (100 * 1024 * 1024)
+#define MAX_CACHE_AGE_DAYS 60
+
+namespace
+{
+QMutex prunedMutex;
+QSet<QString> prunedDirectories;
+
+QString getDefaultDirectory()
+{
+    return CacheDirectory::getUserCacheHome() + CACHE_SUBFOLDER;
+}
+
+bool shouldPrune(const QString& directory)
+{
+    QMutexLocker locker(&prunedMutex);
+    if (prunedDirectories.contains(directory))
+        return false;
+    prunedDirectories.insert(directory);
+    return true;
+}
+}
+
+ThumbnailCache::ThumbnailCache()
+    : directory_(getDefaultDirectory())
+{
+    QDir().mkpath(directory_);
+}
+
+ThumbnailCache::ThumbnailCache(const QString& directory)
+    : directory_(directory)
+{
+    QDir().mkpath(directory_);
+}
+
+const QString& ThumbnailCache::getDirectory() const
+{
+    return directory_;
+}
+
+QString ThumbnailCache::getKey(const QString& filename, const QSize& size) const
+{
+    const QFileInfo info(filename);
+    if (!info.exists())
+        return QString();
+
+    const QString id = QString("%1|%2|%3|%4x%5")
+            .arg(info.absoluteFilePath())
+            .arg(info.size())
+            .arg(info.lastModified().toMSecsSinceEpoch())
+            .arg(size.width()).arg(size.height());
+
+    return QCryptographicHash::hash(id.toUtf8(),
+                                    QCryptographicHash::Sha1).toHex();
+}
+
+QImage ThumbnailCache::load(const QString& key) const
+{
+    const QString path = getPath(key);
+    if (!QFileInfo(path).exists())
+        return QImage();
+
+    return QImage(path, "PNG");
+}
+
+bool ThumbnailCache::save(const QString& key, const QImage& image) const
+{
+    // Write to a temporary file first, the rename makes the thumbnail visible
+    // to other threads and processes only once it is complete
+    QTemporaryFile file(getPath(key) + ".XXXXXX");
+    file.setAutoRemove(false);
+    if (!file.open() || !image.save(&file, "PNG"))
+    {
+        put_flog(LOG_WARN, "Could not write thumbnail cache file in: %s",
+                 directory_.toLocal8Bit().constData());
+        file.remove();
+        return false;
+    }
+    file.close();
+
+    if (std::rename(QFile::encodeName(file.fileName()).constData(),
+                    QFile::encodeName(getPath(key)).constData()) != 0)
+    {
+        file.remove();
+        return false;
+    }
+
+    if (shouldPrune(directory_))
+        CacheDirectory::prune(directory_, "*.png*", MAX_CACHE_SIZE_BYTES,
+                              MAX_CACHE_AGE_DAYS);
+    return true;
+}
+
+QString ThumbnailCache::getPath(const QString& key) const
+{
+    return directory_ + "/" + key + ".png";
+}
@@ -0,0 +1,99 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QString>
+#include <QSize>
+#include <QImage>
+
+/**
+ * A persistent, content-addressed thumbnail cache on disk.
+ *
+ * The thumbnails are stored as PNG files named after a hash of the source
+ * path, file size, modification time and thumbnail size, so that modified
+ * files get new entries and stale ones are never returned. Files are written
+ * atomically, which allows several processes to share the same cache folder.
+ * The folder is pruned once per process, on the first write.
+ *
+ * Movies are not stored here, their thumbnail is part of the
+ * MovieMetadataCache.
+ */
+class ThumbnailCache
+{
+public:
+    /**
+     * Construct a cache in the default folder,
+     * $XDG_CACHE_HOME/displaycluster/thumbnails or ~/.cache/...
+     */
+    ThumbnailCache();
+
+    /**
+     * Construct a cache in a given folder.
+     * @param directory The folder, created if it does not exist.
+     */
+    explicit ThumbnailCache(const QString& directory);
+
+    /** @return The folder in which the thumbnails are stored. */
+    const QString& getDirectory() const;
+
+    /**
+     * Get the key of a thumbnail.
+     * @param filename The source file of the thumbnail.
+     * @param size The size of the thumbnail.
+     * @return The key, or an empty string if the file does not exist.
+     */
+    QString getKey(const QString& filename, const QSize& size) const;
+
+    /** @return The cached thumbnail, or a null image if there is none. */
+    QImage load(const QString& key) const;
+
+    /**
+     * Store a thumbnail.
+     * @return false if the thumbnail could not be written.
+     */
+    bool save(const QString& key, const QImage& image) const;
+
+private:
+    QString directory_;
+
+    QString getPath(const QString& key) const;
+};
+
+#endif // THUMBNAILCACHE_H
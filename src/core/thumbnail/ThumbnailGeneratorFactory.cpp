@@ -45,6 +45,7 @@
 #  include "../PDFContent.h"
 #endif
 
+#include "CachedThumbnailGenerator.h"
 #include "DefaultThumbnailGenerator.h"
 #include "FolderThumbnailGenerator.h"
 #include "ImageThumbnailGenerator.h"
@@ -59,6 +60,17 @@
 #include <QImageReader>
 #include <QDir>
 
+namespace
+{
+// Folders, states and unsupported files have cheap thumbnails which do not
+// depend only on the modification time of the file, they are not cached.
+// Movie thumbnails are already persisted by the MovieMetadataCache.
+ThumbnailGeneratorPtr cached(ThumbnailGeneratorPtr generator, const QSize& size)
+{
+    return ThumbnailGeneratorPtr(new CachedThumbnailGenerator(generator, size));
+}
+}
+
 ThumbnailGeneratorFactory::ThumbnailGeneratorFactory()
 {
 }
@@ -72,7 +84,7 @@ ThumbnailGeneratorPtr ThumbnailGeneratorFactory::getGenerator(const QString &fil
         return ThumbnailGeneratorPtr(new FolderThumbnailGenerator(size));
     }
 
-    if( extension == "dcx" )
+    if( extension == "dcx" || extension == "dcxb" )
     {
         return ThumbnailGeneratorPtr(new StateThumbnailGenerator(size));
     }
@@ -84,18 +96,18 @@ ThumbnailGeneratorPtr ThumbnailGeneratorFactory::getGenerator(const QString &fil
 
     if( TextureContent::getSupportedExtensions().contains( extension ))
     {
-        return ThumbnailGeneratorPtr(new ImageThumbnailGenerator(size));
+        return cached(ThumbnailGeneratorPtr(new ImageThumbnailGenerator(size)), size);
     }
 
     if( DynamicTextureContent::getSupportedExtensions().contains( extension ))
     {
-        return ThumbnailGeneratorPtr(new PyramidThumbnailGenerator(size));
+        return cached(ThumbnailGeneratorPtr(new PyramidThumbnailGenerator(size)), size);
     }
 
 #if ENABLE_PDF_SUPPORT
     if( PDFContent::getSupportedExtensions().contains( extension ))
     {
-        return ThumbnailGeneratorPtr(new PDFThumbnailGenerator(size));
+        return cached(ThumbnailGeneratorPtr(new PDFThumbnailGenerator(size)), size);
     }
 #endif
 
@@ -0,0 +1,240 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "ThumbnailReader.h"
+
+#include <QFile>
+
+#include <cmath>
+
+// The EXIF segment has to fit in a JPEG APP1 segment (64 KB), and is
+// preceded at most by a few small segments such as the JFIF header
+#define EXIF_SEARCH_SIZE (128*1024)
+
+#define JPEG_MARKER_SOI  0xD8
+#define JPEG_MARKER_EOI  0xD9
+#define JPEG_MARKER_SOS  0xDA
+#define JPEG_MARKER_APP1 0xE1
+
+#define TIFF_TAG_JPEG_OFFSET 0x0201
+#define TIFF_TAG_JPEG_LENGTH 0x0202
+#define TIFF_IFD_ENTRY_SIZE  12
+
+#define MAX_ASPECT_RATIO_DIFFERENCE 0.02
+
+namespace
+{
+/** Minimal reader for the TIFF structure of the EXIF data. */
+class TiffData
+{
+public:
+    TiffData(const QByteArray& data)
+        : data_(data)
+        , littleEndian_(data.startsWith("II"))
+    {}
+
+    bool isValid() const
+    {
+        return (data_.startsWith("II") || data_.startsWith("MM")) &&
+                readUInt16(2) == 42;
+    }
+
+    quint16 readUInt16(const int pos) const
+    {
+        if (pos < 0 || pos + 2 > data_.size())
+            return 0;
+        const uchar* p = reinterpret_cast<const uchar*>(data_.constData()) + pos;
+        return littleEndian_ ? p[0] | (p[1] << 8) : (p[0] << 8) | p[1];
+    }
+
+    quint32 readUInt32(const int pos) const
+    {
+        if (pos < 0 || pos + 4 > data_.size())
+            return 0;
+        const quint32 a = readUInt16(pos);
+        const quint32 b = readUInt16(pos + 2);
+        return littleEndian_ ? a | (b << 16) : (a << 16) | b;
+    }
+
+    /** @return The offset of the IFD following the one at the given offset. */
+    quint32 getNextIfd(const quint32 ifd) const
+    {
+        const quint16 entries = readUInt16(ifd);
+        return readUInt32(ifd + 2 + entries * TIFF_IFD_ENTRY_SIZE);
+    }
+
+    /** @return The value of a tag in the IFD at the given offset, or 0. */
+    quint32 getTagValue(const quint32 ifd, const quint16 tag) const
+    {
+        const quint16 entries = readUInt16(ifd);
+        for (quint16 i = 0; i < entries; ++i)
+        {
+            const quint32 entry = ifd + 2 + i * TIFF_IFD_ENTRY_SIZE;
+            if (readUInt16(entry) == tag)
+                return readUInt32(entry + 8);
+        }
+        return 0;
+    }
+
+    /** @return The JPEG thumbnail stored in IFD1, or an empty array. */
+    QByteArray getThumbnailData() const
+    {
+        const quint32 ifd1 = getNextIfd(readUInt32(4));
+        if (ifd1 == 0)
+            return QByteArray();
+
+        const quint32 offset = getTagValue(ifd1, TIFF_TAG_JPEG_OFFSET);
+        const quint32 length = getTagValue(ifd1, TIFF_TAG_JPEG_LENGTH);
+        if (offset == 0 || length == 0 || offset + length > (quint32)data_.size())
+            return QByteArray();
+
+        return data_.mid(offset, length);
+    }
+
+private:
+    const QByteArray data_;
+    const bool littleEndian_;
+};
+
+QByteArray findExifThumbnail(const QByteArray& jpeg)
+{
+    const uchar* data = reinterpret_cast<const uchar*>(jpeg.constData());
+    if (jpeg.size() < 4 || data[0] != 0xFF || data[1] != JPEG_MARKER_SOI)
+        return QByteArray();
+
+    int pos = 2;
+    while (pos + 4 <= jpeg.size() && data[pos] == 0xFF)
+    {
+        const uchar marker = data[pos + 1];
+        if (marker == JPEG_MARKER_SOS || marker == JPEG_MARKER_EOI)
+            break;
+
+        const int length = (data[pos + 2] << 8) | data[pos + 3];
+        if (marker == JPEG_MARKER_APP1 && jpeg.mid(pos + 4, 6) == QByteArray("Exif\0\0", 6))
+        {
+            const TiffData tiff(jpeg.mid(pos + 10, length - 8));
+            return tiff.isValid() ? tiff.getThumbnailData() : QByteArray();
+        }
+        pos += 2 + length;
+    }
+    return QByteArray();
+}
+
+double getAspectRatio(const QSize& size)
+{
+    return (double)size.width() / (double)size.height();
+}
+}
+
+ThumbnailReader::ThumbnailReader(const QString& filename, const QSize& size,
+                                 const Qt::AspectRatioMode aspectRatioMode)
+    : filename_(filename)
+    , size_(size)
+    , aspectRatioMode_(aspectRatioMode)
+    , reader_(filename)
+{
+}
+
+bool ThumbnailReader::canRead() const
+{
+    return reader_.canRead();
+}
+
+bool ThumbnailReader::supportsScaledDecoding() const
+{
+    return reader_.supportsOption(QImageIOHandler::ScaledSize);
+}
+
+QImage ThumbnailReader::read()
+{
+    QImage image = readEmbeddedThumbnail();
+
+    if (image.isNull())
+    {
+        const QSize targetSize = getTargetSize();
+        if (supportsScaledDecoding() && targetSize.isValid())
+            reader_.setScaledSize(targetSize);
+        image = reader_.read();
+    }
+
+    if (image.isNull() || image.size() == getTargetSize())
+        return image;
+
+    return image.scaled(size_, aspectRatioMode_);
+}
+
+QImage ThumbnailReader::readEmbeddedThumbnail()
+{
+    if (reader_.format() != "jpeg" && reader_.format() != "jpg")
+        return QImage();
+
+    QFile file(filename_);
+    if (!file.open(QIODevice::ReadOnly))
+        return QImage();
+
+    const QByteArray data = findExifThumbnail(file.read(EXIF_SEARCH_SIZE));
+    if (data.isEmpty())
+        return QImage();
+
+    QImage thumbnail = QImage::fromData(data, "JPEG");
+    if (thumbnail.isNull())
+        return QImage();
+
+    // Reject thumbnails which would have to be upscaled or which are padded
+    // to a different aspect ratio than the image
+    const QSize imageSize = reader_.size();
+    const QSize targetSize = getTargetSize();
+    if (!imageSize.isValid() || thumbnail.width() < targetSize.width() ||
+            thumbnail.height() < targetSize.height() ||
+            std::abs(getAspectRatio(thumbnail.size()) - getAspectRatio(imageSize))
+            > MAX_ASPECT_RATIO_DIFFERENCE * getAspectRatio(imageSize))
+        return QImage();
+
+    return thumbnail.scaled(size_, aspectRatioMode_);
+}
+
+QSize ThumbnailReader::getTargetSize() const
+{
+    const QSize imageSize = reader_.size();
+    if (!imageSize.isValid())
+        return QSize();
+
+    QSize targetSize = imageSize;
+    targetSize.scale(size_, aspectRatioMode_);
+    return targetSize;
+}
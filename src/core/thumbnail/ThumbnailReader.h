@@ -0,0 +1,95 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef THUMBNAILREADER_H
+#define THUMBNAILREADER_H
+
+#include <QString>
+#include <QSize>
+#include <QImage>
+#include <QImageReader>
+
+/**
+ * Read images at thumbnail size without decoding them at full resolution
+ * whenever possible.
+ *
+ * The reader tries, in order: the thumbnail embedded in the EXIF metadata of
+ * JPEG files, the scaled decoding of the image format (DCT downscaling for
+ * JPEG), then a full decode followed by a downscale.
+ */
+class ThumbnailReader
+{
+public:
+    /**
+     * Constructor.
+     * @param filename The image file.
+     * @param size The size of the thumbnail.
+     * @param aspectRatioMode How the image is fitted in the thumbnail size.
+     */
+    ThumbnailReader(const QString& filename, const QSize& size,
+                    Qt::AspectRatioMode aspectRatioMode);
+
+    /** @return true if the file is an image in a supported format. */
+    bool canRead() const;
+
+    /** @return true if the image format supports decoding at reduced size. */
+    bool supportsScaledDecoding() const;
+
+    /**
+     * Read the thumbnail using the fastest available method.
+     * @return The thumbnail, or a null image if the file could not be read.
+     */
+    QImage read();
+
+    /**
+     * Read the EXIF thumbnail embedded in a JPEG file.
+     * @return The thumbnail, or a null image if the file has none or if it is
+     *         too small or has a different aspect ratio than the image.
+     */
+    QImage readEmbeddedThumbnail();
+
+private:
+    QString filename_;
+    QSize size_;
+    Qt::AspectRatioMode aspectRatioMode_;
+    QImageReader reader_;
+
+    QSize getTargetSize() const;
+};
+
+#endif // THUMBNAILREADER_H
@@ -50,6 +50,7 @@ class ContentWindow;
 class DisplayGroup;
 class DisplayGroupAdapter;
 class DisplayGroupRenderer;
+class DisplayGroupStateTracker;
 class DynamicTexture;
 class Factories;
 class FactoryObject;
@@ -57,11 +58,13 @@ class GLWindow;
 class MarkerRenderer;
 class Markers;
 class MasterConfiguration;
+class Movie;
 class MPIChannel;
 class Options;
 class PixelStreamWindowManager;
 class Renderable;
 class RenderContext;
+class SessionPreload;
 class TestPattern;
 class WallWindow;
 class WallConfiguration;
@@ -71,19 +74,24 @@ typedef boost::shared_ptr< ContentWindow > ContentWindowPtr;
 typedef boost::shared_ptr< DisplayGroupAdapter > DisplayGroupAdapterPtr;
 typedef boost::shared_ptr< DisplayGroup > DisplayGroupPtr;
 typedef boost::shared_ptr< DisplayGroupRenderer > DisplayGroupRendererPtr;
+typedef boost::shared_ptr< DisplayGroupStateTracker > DisplayGroupStateTrackerPtr;
 typedef boost::shared_ptr< DynamicTexture > DynamicTexturePtr;
 typedef boost::shared_ptr< Factories > FactoriesPtr;
 typedef boost::shared_ptr< FactoryObject > FactoryObjectPtr;
 typedef boost::shared_ptr< WallWindow > WallWindowPtr;
 typedef boost::shared_ptr< MarkerRenderer > MarkerRendererPtr;
 typedef boost::shared_ptr< Markers > MarkersPtr;
+typedef boost::shared_ptr< Movie > MoviePtr;
 typedef boost::shared_ptr< MPIChannel > MPIChannelPtr;
 typedef boost::shared_ptr< Options > OptionsPtr;
 typedef boost::shared_ptr< Renderable > RenderablePtr;
 typedef boost::shared_ptr< RenderContext > RenderContextPtr;
+typedef boost::shared_ptr< SessionPreload > SessionPreloadPtr;
 typedef boost::shared_ptr< TestPattern > TestPatternPtr;
 
+typedef std::vector< ContentPtr > ContentPtrs;
 typedef std::vector< ContentWindowPtr > ContentWindowPtrs;
+typedef std::vector< MoviePtr > MoviePtrs;
 typedef std::vector< WallWindowPtr > WallWindowPtrs;
 
 #endif
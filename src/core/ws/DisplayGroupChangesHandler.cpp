@@ -0,0 +1,105 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "DisplayGroupChangesHandler.h"
+
+#include "ws/DisplayGroupStateTracker.h"
+#include "dcWebservice/Response.h"
+#include "dcWebservice/Request.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#define DEFAULT_TIMEOUT_MS 20000
+#define MAX_TIMEOUT_MS     60000
+
+namespace
+{
+unsigned long getParameter(const dcWebservice::Request& request,
+                           const std::string& name,
+                           const unsigned long defaultValue)
+{
+    std::map<std::string, std::string>::const_iterator it =
+            request.parameters.find(name);
+    if (it == request.parameters.end() || it->second.empty())
+        return defaultValue;
+    return strtoul(it->second.c_str(), 0, 10);
+}
+}
+
+DisplayGroupChangesHandler::DisplayGroupChangesHandler(DisplayGroupStateTrackerPtr tracker)
+    : tracker_(tracker)
+{
+}
+
+dcWebservice::ConstResponsePtr DisplayGroupChangesHandler::handle(const dcWebservice::Request& request) const
+{
+    const unsigned int revision = getParameter(request, "since", 0);
+    const unsigned long timeout = std::min(getParameter(request, "timeout",
+                                                        DEFAULT_TIMEOUT_MS),
+                                           (unsigned long)MAX_TIMEOUT_MS);
+
+    dcWebservice::ResponsePtr response(new dcWebservice::Response());
+
+    DisplayGroupStateTracker::Changes changes;
+    if (!tracker_->waitForChanges(revision, timeout, changes))
+    {
+        // Keep the remaining server threads available for other requests
+        response->statusCode = 503;
+        response->statusMsg = "Service Unavailable";
+        response->httpHeaders["Retry-After"] = "1";
+        response->body = "{\"code\":\"503\", \"msg\":\"Too many pending requests\"}";
+        return response;
+    }
+
+    QStringList removed;
+    foreach (const QString& id, changes.removed)
+        removed.append(QString("\"%1\"").arg(id));
+
+    const QString body = QString("{\"revision\":%1,\"reset\":%2,\"windows\":[%3],\"removed\":[%4]}")
+            .arg(QString::number(changes.revision),
+                 changes.reset ? "true" : "false",
+                 changes.windows.join(","), removed.join(","));
+
+    response->statusCode = 200;
+    response->statusMsg = "OK";
+    response->httpHeaders["Content-Type"] = "application/json";
+    response->httpHeaders["Cache-Control"] = "no-cache";
+    response->body = body.toUtf8().constData();
+    return response;
+}
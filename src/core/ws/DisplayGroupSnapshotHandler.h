@@ -0,0 +1,73 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef DISPLAYGROUPSNAPSHOTHANDLER_H
+#define DISPLAYGROUPSNAPSHOTHANDLER_H
+
+#include <dcWebservice/Handler.h>
+
+#include "types.h"
+
+/**
+ * Handle "/displaygroup" requests for the WebService.
+ *
+ * Return the revision and the state of all the windows of the DisplayGroup
+ * as a JSON object. The revision can then be used to follow the changes with
+ * the DisplayGroupChangesHandler.
+ */
+class DisplayGroupSnapshotHandler : public dcWebservice::Handler
+{
+public:
+    /**
+     * Constructor.
+     * @param tracker The tracker which holds the state of the DisplayGroup.
+     */
+    DisplayGroupSnapshotHandler(DisplayGroupStateTrackerPtr tracker);
+
+    /**
+     * Handle a request.
+     * @param request A valid dcWebservice::Request object.
+     * @return A valid Response object.
+     */
+    dcWebservice::ConstResponsePtr handle(const dcWebservice::Request& request) const override;
+
+private:
+    DisplayGroupStateTrackerPtr tracker_;
+};
+
+#endif // DISPLAYGROUPSNAPSHOTHANDLER_H
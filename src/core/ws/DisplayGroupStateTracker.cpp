@@ -0,0 +1,256 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include "DisplayGroupStateTracker.h"
+
+#include "ContentWindow.h"
+#include "DisplayGroup.h"
+
+#include <QMetaEnum>
+#include <QTime>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+
+// Above this many removals, the oldest ones are forgotten and the clients
+// which have not seen them must start over from a complete list of windows.
+#define MAX_REMOVED_WINDOWS 256
+
+namespace
+{
+QString quote( const QString& string )
+{
+    QString quoted( "\"" );
+    foreach( const QChar& c, string )
+    {
+        if( c == '"' || c == '\\' )
+            quoted += QString( "\\%1" ).arg( c );
+        else if( c.unicode() < 0x20 )
+            quoted += QString( "\\u%1" ).arg( c.unicode(), 4, 16, QChar( '0' ));
+        else
+            quoted += c;
+    }
+    return quoted + "\"";
+}
+
+QString getStateName( const ContentWindow::WindowState state )
+{
+    const QMetaObject& metaObject = ContentWindow::staticMetaObject;
+    const int index = metaObject.indexOfEnumerator( "WindowState" );
+    return QString( metaObject.enumerator( index ).valueToKey( state )).toLower();
+}
+
+QString serialize( ContentWindow& window, const int z )
+{
+    const QRectF& coords = window.getCoordinates();
+    ContentPtr content = window.getContent();
+
+    return QString( "{\"id\":%1,\"uri\":%2,\"type\":%3,\"x\":%4,\"y\":%5,"
+                    "\"width\":%6,\"height\":%7,\"z\":%8,\"state\":%9}" )
+            .arg( quote( window.getID().toString( )),
+                  quote( content->getURI( )),
+                  quote( getContentTypeString( content->getType( ))),
+                  QString::number( coords.x( )),
+                  QString::number( coords.y( )),
+                  QString::number( coords.width( )),
+                  QString::number( coords.height( )),
+                  QString::number( z ),
+                  quote( getStateName( window.getState( ))));
+}
+}
+
+DisplayGroupStateTracker::DisplayGroupStateTracker( DisplayGroupPtr displayGroup,
+                                                    const unsigned int maxWaiters,
+                                                    QObject* parentObject )
+    : QObject( parentObject )
+    , waiters_( 0 )
+    , maxWaiters_( maxWaiters )
+    , released_( false )
+    , revision_( 0 )
+    , oldestKnownRevision_( 0 )
+{
+    update( displayGroup );
+}
+
+DisplayGroupStateTracker::Snapshot DisplayGroupStateTracker::getSnapshot() const
+{
+    QMutexLocker lock( &mutex_ );
+
+    Snapshot snapshot;
+    snapshot.revision = revision_;
+    snapshot.background = background_;
+    foreach( const QString& id, windowsOrder_ )
+        snapshot.windows.append( windows_[id].json );
+    return snapshot;
+}
+
+bool DisplayGroupStateTracker::waitForChanges( const unsigned int revision,
+                                               const unsigned long timeoutMs,
+                                               Changes& changes ) const
+{
+    QMutexLocker lock( &mutex_ );
+
+    if( revision == revision_ && !released_ )
+    {
+        if( waiters_ >= maxWaiters_ )
+            return false;
+
+        ++waiters_;
+        QTime timer;
+        timer.start();
+        // Guard against spurious wake-ups
+        while( revision == revision_ && !released_ &&
+               (unsigned long)timer.elapsed() < timeoutMs )
+        {
+            changed_.wait( &mutex_, timeoutMs - timer.elapsed( ));
+        }
+        --waiters_;
+    }
+
+    getChanges( revision, changes );
+    return true;
+}
+
+void DisplayGroupStateTracker::releaseWaiters()
+{
+    QMutexLocker lock( &mutex_ );
+    released_ = true;
+    changed_.wakeAll();
+}
+
+void DisplayGroupStateTracker::update( DisplayGroupPtr displayGroup )
+{
+    // Serialize before locking, the web service threads only need the result
+    QStringList order;
+    QMap< QString, QString > states;
+    int z = 0;
+    BOOST_FOREACH( ContentWindowPtr window, displayGroup->getContentWindows( ))
+    {
+        const QString& id = window->getID().toString();
+        order.append( id );
+        states[id] = serialize( *window, z++ );
+    }
+    ContentPtr backgroundContent = displayGroup->getBackgroundContent();
+    const QString background = backgroundContent ?
+                                   quote( backgroundContent->getURI( )) :
+                                   QString( "null" );
+
+    QMutexLocker lock( &mutex_ );
+
+    const unsigned int nextRevision = revision_ + 1;
+    bool modified = background != background_ || order != windowsOrder_;
+
+    for( QMap< QString, QString >::const_iterator it = states.begin();
+         it != states.end(); ++it )
+    {
+        WindowStates::const_iterator previous = windows_.find( it.key( ));
+        if( previous != windows_.end() && previous->json == it.value( ))
+            continue;
+
+        WindowState& state = windows_[it.key()];
+        state.json = it.value();
+        state.revision = nextRevision;
+        removedWindows_.remove( it.key( ));
+        modified = true;
+    }
+
+    for( WindowStates::iterator it = windows_.begin(); it != windows_.end(); )
+    {
+        if( states.contains( it.key( )))
+        {
+            ++it;
+            continue;
+        }
+        removedWindows_[it.key()] = nextRevision;
+        it = windows_.erase( it );
+        modified = true;
+    }
+
+    if( !modified )
+        return;
+
+    revision_ = nextRevision;
+    background_ = background;
+    windowsOrder_ = order;
+    pruneRemovedWindows();
+
+    changed_.wakeAll();
+}
+
+void DisplayGroupStateTracker::getChanges( const unsigned int revision,
+                                           Changes& changes ) const
+{
+    changes.revision = revision_;
+    changes.reset = revision < oldestKnownRevision_ || revision > revision_;
+    changes.windows.clear();
+    changes.removed.clear();
+
+    foreach( const QString& id, windowsOrder_ )
+    {
+        const WindowState& state = windows_[id];
+        if( changes.reset || state.revision > revision )
+            changes.windows.append( state.json );
+    }
+
+    if( changes.reset )
+        return;
+
+    for( RemovedWindows::const_iterator it = removedWindows_.begin();
+         it != removedWindows_.end(); ++it )
+    {
+        if( it.value() > revision )
+            changes.removed.append( it.key( ));
+    }
+}
+
+void DisplayGroupStateTracker::pruneRemovedWindows()
+{
+    while( removedWindows_.size() > MAX_REMOVED_WINDOWS )
+    {
+        RemovedWindows::iterator oldest = removedWindows_.begin();
+        for( RemovedWindows::iterator it = removedWindows_.begin();
+             it != removedWindows_.end(); ++it )
+        {
+            if( it.value() < oldest.value( ))
+                oldest = it;
+        }
+        oldestKnownRevision_ = std::max( oldestKnownRevision_, oldest.value( ));
+        removedWindows_.erase( oldest );
+    }
+}
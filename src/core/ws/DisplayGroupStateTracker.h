@@ -0,0 +1,151 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef DISPLAYGROUPSTATETRACKER_H
+#define DISPLAYGROUPSTATETRACKER_H
+
+#include "types.h"
+
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QWaitCondition>
+
+/**
+ * Keep a serialized copy of the DisplayGroup state for the web service.
+ *
+ * The tracker follows the DisplayGroup::modified() notifications in the main
+ * thread, like the MasterToWallChannel, and records for each window the JSON
+ * description of its state and the revision at which it last changed. The
+ * WebServiceServer threads can then read a snapshot or wait for the changes
+ * since a given revision without ever accessing the DisplayGroup.
+ *
+ * The revision only increases when the serialized state actually changes, so
+ * waiting clients are not woken up by notifications without visible effect.
+ */
+class DisplayGroupStateTracker : public QObject
+{
+    Q_OBJECT
+
+public:
+    /** The state of all the windows at a given revision. */
+    struct Snapshot
+    {
+        unsigned int revision;
+        /** The JSON value of the background content uri, or null. */
+        QString background;
+        /** The JSON objects of the windows, from back to front. */
+        QStringList windows;
+    };
+
+    /** The windows changes between two revisions. */
+    struct Changes
+    {
+        unsigned int revision;
+        /** True if the changes are not available anymore. */
+        bool reset;
+        /** The JSON objects of the added or modified windows. */
+        QStringList windows;
+        /** The ids of the removed windows. */
+        QStringList removed;
+    };
+
+    /**
+     * Constructor.
+     * @param displayGroup The DisplayGroup to track. Its current state is
+     *        recorded as revision 1.
+     * @param maxWaiters The maximum number of threads which can wait for
+     *        changes at the same time.
+     * @param parentObject An optional parent QObject
+     */
+    DisplayGroupStateTracker( DisplayGroupPtr displayGroup,
+                              unsigned int maxWaiters,
+                              QObject* parentObject = 0 );
+
+    /** Get the current state. Thread-safe. */
+    Snapshot getSnapshot() const;
+
+    /**
+     * Wait until the state changes after the given revision. Thread-safe.
+     *
+     * @param revision The last revision known by the caller.
+     * @param timeoutMs The maximum time to wait for a change.
+     * @param changes Receives the changes since the given revision. If the
+     *        changes are too old to be known, changes.reset is true and the
+     *        caller should request a new snapshot.
+     * @return false if too many threads are already waiting, true otherwise
+     *         (even if the wait timed out without changes).
+     */
+    bool waitForChanges( unsigned int revision, unsigned long timeoutMs,
+                         Changes& changes ) const;
+
+    /** Wake up all the waiting threads and stop waiting. Thread-safe. */
+    void releaseWaiters();
+
+public slots:
+    /** Record the new state of the DisplayGroup. */
+    void update( DisplayGroupPtr displayGroup );
+
+private:
+    struct WindowState
+    {
+        QString json;
+        unsigned int revision;
+    };
+    typedef QMap< QString, WindowState > WindowStates;
+    typedef QMap< QString, unsigned int > RemovedWindows;
+
+    mutable QMutex mutex_;
+    mutable QWaitCondition changed_;
+    mutable unsigned int waiters_;
+    const unsigned int maxWaiters_;
+    bool released_;
+
+    unsigned int revision_;
+    unsigned int oldestKnownRevision_;
+    QString background_;
+    QStringList windowsOrder_;
+    WindowStates windows_;
+    RemovedWindows removedWindows_;
+
+    void getChanges( unsigned int revision, Changes& changes ) const;
+    void pruneRemovedWindows();
+};
+
+#endif // DISPLAYGROUPSTATETRACKER_H
@@ -52,17 +52,33 @@ TextInputDispatcher::TextInputDispatcher(DisplayGroupPtr displayGroup,
 {
 }
 
-void TextInputDispatcher::sendKeyEventToActiveWindow( const char key ) const
+void TextInputDispatcher::sendTextToActiveWindow( const QString text ) const
 {
     ContentWindowPtr window = displayGroup_->getActiveWindow();
     if ( !window )
         return;
 
-    QKeyEvent pressEvent( QEvent::KeyPress, keyMapper_.getQtKeyCode( key ),
-                          0, QString( key ));
-    QKeyEvent releaseEvent( QEvent::KeyRelease, keyMapper_.getQtKeyCode( key ),
-                            0, QString( key ));
+    ContentInteractionDelegate& delegate = window->getInteractionDelegate();
+    for( int i = 0; i < text.size(); ++i )
+    {
+        // Characters outside of the BMP are a surrogate pair, which must be
+        // sent as a single key event
+        QString character( text[i] );
+        int key = text[i].unicode();
+        if( text[i].isHighSurrogate() && i + 1 < text.size() &&
+            text[i+1].isLowSurrogate( ))
+        {
+            character.append( text[i+1] );
+            key = QChar::surrogateToUcs4( text[i], text[i+1] );
+            ++i;
+        }
+        else if( key < 128 )
+            key = keyMapper_.getQtKeyCode( text[i].toLatin1( ));
 
-    window->getInteractionDelegate().keyPressEvent( &pressEvent );
-    window->getInteractionDelegate().keyReleaseEvent( &releaseEvent );
+        QKeyEvent pressEvent( QEvent::KeyPress, key, 0, character );
+        QKeyEvent releaseEvent( QEvent::KeyRelease, key, 0, character );
+
+        delegate.keyPressEvent( &pressEvent );
+        delegate.keyReleaseEvent( &releaseEvent );
+    }
 }
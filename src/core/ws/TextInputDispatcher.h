@@ -62,10 +62,13 @@ public:
 
 public slots:
     /**
-     * Send the given key event to the active (frontmost) window
-     * @param key The key code to send
+     * Send key events for the given text to the active (frontmost) window.
+     *
+     * Each Unicode code point is one key press, including the characters
+     * stored as a surrogate pair in the QString.
+     * @param text The characters to type, in order
      */
-    void sendKeyEventToActiveWindow(const char key) const;
+    void sendTextToActiveWindow(const QString text) const;
 
 private:
     DisplayGroupPtr displayGroup_;
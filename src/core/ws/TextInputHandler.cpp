@@ -64,10 +64,10 @@ dcWebservice::ConstResponsePtr TextInputHandler::handle(const dcWebservice::Requ
     }
     else if (displayGroupAdapter_->hasWindows())
     {
-    for(std::string::const_iterator it = request.data.begin(); it != request.data.end(); ++it)
-    {
-        emit receivedKeyInput(*it);
-    }
+        // A single signal for the whole string, so that it is dispatched to
+        // the main thread at once instead of one queued event per character.
+        emit receivedTextInput(QString::fromUtf8(request.data.c_str(),
+                                                 request.data.size()));
 
         response->statusCode = 200;
         response->statusMsg = "OK";
@@ -49,9 +49,13 @@
 /**
  * Handle "/textinput" requests for the WebService.
  *
- * When a valid request is received, the receivedText() signal is emitted.
- * This class is typically used in the WebServiceServer thread and communicates
- * with the TextInputDispatcher in the main thread via signals/slots.
+ * The body of a request is a UTF-8 string, which may contain several
+ * characters and control keys such as backspace or return. When a valid
+ * request is received, the receivedTextInput() signal is emitted once with
+ * the whole string.
+ * This class is typically used by the worker threads of the WebServiceServer
+ * and communicates with the TextInputDispatcher in the main thread via queued
+ * signals/slots, which makes concurrent calls to handle() safe.
  */
 class TextInputHandler : public QObject, public dcWebservice::Handler
 {
@@ -78,9 +82,9 @@ public:
 signals:
     /**
      * Emitted whenever a request is successfully handled.
-     * @param key The key code received in the Request.
+     * @param text The text received in the Request.
      */
-    void receivedKeyInput(char key) const;
+    void receivedTextInput(QString text) const;
 
 private:
     DisplayGroupAdapterPtr displayGroupAdapter_;
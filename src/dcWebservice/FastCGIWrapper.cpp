@@ -42,11 +42,20 @@
 
 #include "FastCGIWrapper.h"
 
+namespace
+{
+void freeRequest(FCGX_Request* request)
+{
+    FCGX_Free(request, 0);
+    delete request;
+}
+}
+
 namespace dcWebservice
 {
 
 FastCGIWrapper::FastCGIWrapper()
-    : _request(new FCGX_Request())
+    : _request(&freeRequest)
     , _run(false)
     , _socket(-1)
 {}
@@ -64,7 +73,6 @@ bool FastCGIWrapper::init(const unsigned int port, const unsigned int nbOfConnec
 
     _run = true;
     FCGX_Init(); // FastCGI takes care of not initializing itself more than once
-    FCGX_InitRequest(_request.get(), _socket, 0);
     return true;
 }
 
@@ -78,6 +86,12 @@ bool FastCGIWrapper::accept()
     fd_set read_from;
     struct timeval timeout;
 
+    FCGX_Request* request = getRequest();
+
+    // Only one thread at a time waits for a new connection, the others wait
+    // for it to be accepted and then process their requests concurrently.
+    boost::mutex::scoped_lock lock(_acceptMutex);
+
     while(_run)
     {
         // Timeout must be reset every iteration
@@ -92,22 +106,28 @@ bool FastCGIWrapper::accept()
         if( retval == -1)
             break;
         else if(retval)
-            return FCGX_Accept_r(_request.get()) >= 0;
+            return FCGX_Accept_r(request) >= 0;
     }
     return false;
 }
 
 FCGX_Request* FastCGIWrapper::getRequest()
 {
+    if(!_request.get())
+    {
+        _request.reset(new FCGX_Request());
+        FCGX_InitRequest(_request.get(), _socket, 0);
+    }
     return _request.get();
 }
 
 bool FastCGIWrapper::write(const std::string& msg)
 {
-    FCGX_PutS(msg.c_str(), _request->out);
-    FCGX_FFlush(_request->out);
-    FCGX_FClose(_request->out);
-    FCGX_Finish_r(_request.get());
+    FCGX_Request* request = getRequest();
+    FCGX_PutS(msg.c_str(), request->out);
+    FCGX_FFlush(request->out);
+    FCGX_FClose(request->out);
+    FCGX_Finish_r(request);
     return true;
 }
 
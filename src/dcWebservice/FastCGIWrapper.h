@@ -41,7 +41,8 @@
 #define FASTCGI_WRAPPER_H
 
 #include <string>
-#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
 
 #include <fcgiapp.h>
 
@@ -50,6 +51,10 @@ namespace dcWebservice
 
 /**
  * Wrapper for the FastCGI library. All methods are virtual to facilitate tests.
+ *
+ * Several threads can accept and process requests concurrently. Each thread
+ * has its own FCGX_Request, which accept(), getRequest() and write() operate
+ * on; only the acceptance of new connections is serialized.
  */
 class FastCGIWrapper
 {
@@ -76,21 +81,22 @@ public:
     virtual bool init(const unsigned int port, const unsigned int nbOfConnections = 5);
 
     /**
-     * Blocks until a request arrives.
+     * Blocks until a request arrives for the calling thread.
      *
      * @returns true if a request is received successfully, false otherwise.
      */
     virtual bool accept();
 
     /**
-     * Get the actual FCGX_Request object associated with this wrapper.
+     * Get the FCGX_Request object of the calling thread.
      *
-     * @returns The FCGX_Request object associated with this wrapper.
+     * @returns The FCGX_Request object associated with the calling thread.
      */
     virtual FCGX_Request* getRequest();
 
     /**
-     * Sends the message back to the requester and finalizes the request.
+     * Sends the message back to the requester and finalizes the request of
+     * the calling thread.
      *
      * @param msg A string representing a message that is going to be sent
      * to the initiator of the request. Normally this message should be a
@@ -108,7 +114,8 @@ public:
     virtual bool stop();
 
 private:
-    boost::scoped_ptr<FCGX_Request> _request;
+    boost::thread_specific_ptr<FCGX_Request> _request;
+    boost::mutex _acceptMutex;
     volatile bool _run;
     int _socket;
 };
@@ -63,7 +63,8 @@ public:
     /**
      * Through this method the handling functionality is exposed. This method is
      * called by the server to invoke the web service functionality associated
-     * with a particular Handler.
+     * with a particular Handler. It may be called concurrently from several
+     * threads of the server and must therefore be thread-safe.
      *
      * @param request A valid dcWebservice::Request object.
      */
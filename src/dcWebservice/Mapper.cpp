@@ -43,40 +43,195 @@
 
 #include <boost/regex/pattern_except.hpp>
 
+#include <cctype>
+#include <cstring>
+
+namespace
+{
+const char* REGEX_SPECIAL_CHARS = ".[]{}()*+?|^$";
+const char* REGEX_QUANTIFIERS = "*+?{";
+
+/*
+ * Checks if the pattern contains an alternation outside of any group or
+ * bracket expression, in which case it has no common literal prefix.
+ */
+bool hasTopLevelAlternation(const std::string& pattern)
+{
+    int depth = 0;
+    for(size_t i = 0; i < pattern.size(); ++i)
+    {
+        switch(pattern[i])
+        {
+        case '\\':
+            ++i;
+            break;
+        case '[':
+            // Skip the bracket expression, a leading ']' is a literal
+            if(++i < pattern.size() && pattern[i] == '^')
+                ++i;
+            if(i < pattern.size() && pattern[i] == ']')
+                ++i;
+            while(i < pattern.size() && pattern[i] != ']')
+                i += pattern[i] == '\\' ? 2 : 1;
+            break;
+        case '(':
+            ++depth;
+            break;
+        case ')':
+            --depth;
+            break;
+        case '|':
+            if(depth == 0)
+                return true;
+            break;
+        }
+    }
+    return false;
+}
+
+/*
+ * Extracts the literal characters that every string matching the pattern
+ * starts with.
+ *
+ * @param pattern A regular expression.
+ * @param prefix Receives the literal prefix, with escape sequences resolved.
+ * @returns true if the pattern is made only of this literal string.
+ */
+bool parseLiteralPrefix(const std::string& pattern, std::string& prefix)
+{
+    prefix.clear();
+    if(hasTopLevelAlternation(pattern))
+        return false;
+
+    for(size_t i = 0; i < pattern.size(); ++i)
+    {
+        const char c = pattern[i];
+        if(c == '\\')
+        {
+            // Escaped punctuation is literal, but \d, \w, \Q... are not
+            if(i + 1 == pattern.size() || std::isalnum((unsigned char)pattern[i + 1]))
+                return false;
+            prefix += pattern[++i];
+        }
+        else if(std::strchr(REGEX_SPECIAL_CHARS, c))
+        {
+            // The quantified character is not always part of the match
+            if(std::strchr(REGEX_QUANTIFIERS, c) && !prefix.empty())
+                prefix.erase(prefix.size() - 1);
+            return false;
+        }
+        else
+            prefix += c;
+    }
+    return true;
+}
+}
+
 namespace dcWebservice
 {
 
 Mapper::Mapper()
-    : _defaultHandler(new DefaultHandler())
+    : _nodes(1)
+    , _routesCount(0)
+    , _defaultHandler(new DefaultHandler())
 {}
 
 bool Mapper::addHandler(const std::string& pattern, HandlerPtr handler)
 {
-    try
+    Route route;
+    route.order = _routesCount;
+    route.handler = handler;
+
+    std::string prefix;
+    const bool isLiteral = parseLiteralPrefix(pattern, prefix);
+    if(!isLiteral)
     {
-        MappingPair pair = std::make_pair(RegexPtr(new boost::regex(pattern)), handler);
-        mappings.push_back(pair);
-    }
-    catch (const boost::regex_error&)
-    {
-        return false;
+        try
+        {
+            route.regex.reset(new boost::regex(pattern));
+        }
+        catch (const boost::regex_error&)
+        {
+            return false;
+        }
     }
 
+    RouteNode& node = _nodes[_getOrCreateNode(prefix)];
+    if(!isLiteral)
+        node.regexRoutes.push_back(route);
+    else if(!node.literalRoute.handler)
+        node.literalRoute = route;
+
+    ++_routesCount;
     return true;
 }
 
 const Handler& Mapper::getHandler(const std::string& url) const
 {
-    for(std::list<MappingPair>::const_iterator it = mappings.begin() ;
-        it != mappings.end() ; ++it)
+    const Route* match = _findLiteralRoute(url);
+
+    // Only the regexes registered before the literal match can take precedence
+    // over it, and only those whose prefix is a prefix of the url.
+    size_t nodeIndex = 0;
+    for(size_t i = 0; ; ++i)
     {
-        boost::cmatch matchResults;
-        const boost::regex& re = *it->first;
-        if(boost::regex_match(url.c_str(), matchResults, re))
-            return *it->second;
+        const std::vector<Route>& routes = _nodes[nodeIndex].regexRoutes;
+        for(std::vector<Route>::const_iterator it = routes.begin();
+            it != routes.end(); ++it)
+        {
+            if(match && it->order > match->order)
+                break;
+            if(boost::regex_match(url, *it->regex))
+            {
+                match = &(*it);
+                break;
+            }
+        }
+
+        if(i == url.size())
+            break;
+        std::map<char, size_t>::const_iterator child =
+                _nodes[nodeIndex].children.find(url[i]);
+        if(child == _nodes[nodeIndex].children.end())
+            break;
+        nodeIndex = child->second;
     }
 
-    return *_defaultHandler;
+    return match ? *match->handler : *_defaultHandler;
+}
+
+size_t Mapper::_getOrCreateNode(const std::string& prefix)
+{
+    size_t nodeIndex = 0;
+    for(std::string::const_iterator c = prefix.begin(); c != prefix.end(); ++c)
+    {
+        std::map<char, size_t>::const_iterator child =
+                _nodes[nodeIndex].children.find(*c);
+        if(child != _nodes[nodeIndex].children.end())
+        {
+            nodeIndex = child->second;
+            continue;
+        }
+        _nodes[nodeIndex].children[*c] = _nodes.size();
+        nodeIndex = _nodes.size();
+        _nodes.push_back(RouteNode());
+    }
+    return nodeIndex;
+}
+
+const Mapper::Route* Mapper::_findLiteralRoute(const std::string& url) const
+{
+    size_t nodeIndex = 0;
+    for(std::string::const_iterator c = url.begin(); c != url.end(); ++c)
+    {
+        std::map<char, size_t>::const_iterator child =
+                _nodes[nodeIndex].children.find(*c);
+        if(child == _nodes[nodeIndex].children.end())
+            return 0;
+        nodeIndex = child->second;
+    }
+    const Route& route = _nodes[nodeIndex].literalRoute;
+    return route.handler ? &route : 0;
 }
 
 }
@@ -40,8 +40,9 @@
 #ifndef MAPPER_H
 #define MAPPER_H
 
-#include <utility>
-#include <list>
+#include <map>
+#include <string>
+#include <vector>
 
 #include <boost/regex.hpp>
 
@@ -51,7 +52,6 @@ namespace dcWebservice
 {
 
 typedef boost::shared_ptr<boost::regex> RegexPtr;
-typedef std::pair<RegexPtr, HandlerPtr> MappingPair;
 
 /**
  * Maps regular expressions to Request Handlers.
@@ -62,6 +62,11 @@ typedef std::pair<RegexPtr, HandlerPtr> MappingPair;
  * match is found, therefore attention must be put in the order in which
  * Handlers are registered, since some regexes may define a subset of other
  * regexes.
+ *
+ * The patterns are indexed by their literal prefix in a trie. Patterns
+ * without any special character are matched by walking the trie only, and
+ * the other regexes are only evaluated for the urls which start with their
+ * prefix, so the cost of a lookup does not grow with the number of routes.
  */
 class Mapper
 {
@@ -98,11 +103,30 @@ public:
     const Handler& getHandler(const std::string& url) const;
 
 private:
-    std::list<MappingPair> mappings;
+    struct Route
+    {
+        Route() : order(0) {}
+
+        size_t order;
+        RegexPtr regex;
+        HandlerPtr handler;
+    };
+
+    struct RouteNode
+    {
+        std::map<char, size_t> children;
+        Route literalRoute;
+        std::vector<Route> regexRoutes;
+    };
+
+    std::vector<RouteNode> _nodes;
+    size_t _routesCount;
     HandlerPtr _defaultHandler;
+
+    size_t _getOrCreateNode(const std::string& prefix);
+    const Route* _findLiteralRoute(const std::string& url) const;
 };
 
 }
 
 #endif // MAPPER_H
-
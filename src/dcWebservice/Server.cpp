@@ -42,6 +42,9 @@
 #include "Response.h"
 #include "Request.h"
 
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
 #include <sys/socket.h>
 #include <netdb.h>
 #include <cstdio>
@@ -58,16 +61,26 @@ bool Server::addHandler(const std::string& pattern, HandlerPtr handler)
     return _mapper.addHandler(pattern, handler);
 }
 
-bool Server::run(const unsigned int port)
+bool Server::run(const unsigned int port, const unsigned int nbOfThreads)
 {
     if(!_fcgi->init(port))
         return false;
 
+    boost::thread_group workers;
+    for(unsigned int i = 1; i < nbOfThreads; ++i)
+        workers.create_thread(boost::bind(&Server::_processRequests, this));
+
+    _processRequests();
+    workers.join_all();
+    return true;
+}
+
+void Server::_processRequests()
+{
     while(_fcgi->accept())
     {
         _processRequest();
     }
-    return true;
 }
 
 void Server::_sendResponse(const Response& response)
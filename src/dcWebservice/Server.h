@@ -61,6 +61,9 @@ namespace dcWebservice
  * the URL of the request.
  *
  * The port in which the server listens for incoming requests is configurable.
+ *
+ * Requests are processed concurrently by a pool of threads, therefore the
+ * handlers must be thread-safe.
  */
 class Server
 {
@@ -76,8 +79,10 @@ public:
      * When the URL of an incoming request matches the regular expression
      * the handler is invoked.
      *
+     * Handlers must be registered before calling run().
+     *
      * @param pattern A regular expression.
-     * @param handler A request handler.
+     * @param handler A thread-safe request handler.
      * @returns true if the handler was registered succesfully, false otherwise,
      *   for instance if the regular expression is not valid.
      */
@@ -85,13 +90,15 @@ public:
 
     /**
      * Binds a TCP socket in the port specified and starts listening for
-     * incoming requests. Runs entirely in the same thread in which it is
-     * called. This method blocks until a call to stop() is executed.
+     * incoming requests. The calling thread processes requests together with
+     * nbOfThreads - 1 additional worker threads. This method blocks until a
+     * call to stop() is executed and all the workers have finished.
      *
      * @param port The port used in the creation of the TCP socket.
+     * @param nbOfThreads The number of requests processed concurrently.
      * @returns true upon successful completion, false otherwise.
      */
-    bool run(const unsigned int port);
+    bool run(const unsigned int port, const unsigned int nbOfThreads = 4);
 
     /**
      * Stops the Server request processing loop. If the server is running
@@ -126,6 +133,7 @@ private:
     boost::scoped_ptr<FastCGIWrapper> _fcgi;
 
     void _sendResponse(const Response& response);
+    void _processRequests();
     void _processRequest();
 };
 
@@ -0,0 +1,153 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE CacheDirectoryTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "CacheDirectory.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+
+#include <utime.h>
+
+namespace
+{
+const QString CACHE_DIR = "tmp_cachedirectory";
+const qint64 FILE_SIZE = 1000;
+const qint64 UNLIMITED_SIZE = 1000 * FILE_SIZE;
+const int MAX_AGE_DAYS = 30;
+
+void createFile( const QString& name, const int ageDays = 0 )
+{
+    QFile file( CACHE_DIR + "/" + name );
+    file.open( QIODevice::WriteOnly );
+    file.write( QByteArray( FILE_SIZE, 'x' ));
+    file.close();
+
+    if( ageDays > 0 )
+    {
+        const time_t time =
+                QDateTime::currentDateTime().addDays( -ageDays ).toTime_t();
+        struct utimbuf times;
+        times.actime = time;
+        times.modtime = time;
+        utime( QFile::encodeName( file.fileName( )).constData(), &times );
+    }
+}
+
+bool exists( const QString& name )
+{
+    return QFile::exists( CACHE_DIR + "/" + name );
+}
+
+struct CacheDirFixture
+{
+    CacheDirFixture() { QDir().mkpath( CACHE_DIR ); }
+    ~CacheDirFixture()
+    {
+        QDir dir( CACHE_DIR );
+        foreach( const QString& file, dir.entryList( QDir::Files ))
+            dir.remove( file );
+        QDir().rmdir( CACHE_DIR );
+    }
+};
+}
+
+BOOST_FIXTURE_TEST_CASE( testPruneKeepsFilesWithinLimits, CacheDirFixture )
+{
+    createFile( "a.cache" );
+    createFile( "b.cache" );
+
+    BOOST_CHECK_EQUAL( CacheDirectory::prune( CACHE_DIR, "*.cache",
+                                              UNLIMITED_SIZE, MAX_AGE_DAYS ), 0 );
+    BOOST_CHECK( exists( "a.cache" ));
+    BOOST_CHECK( exists( "b.cache" ));
+}
+
+BOOST_FIXTURE_TEST_CASE( testPruneRemovesOldFiles, CacheDirFixture )
+{
+    createFile( "recent.cache", 1 );
+    createFile( "old.cache", MAX_AGE_DAYS + 1 );
+
+    BOOST_CHECK_EQUAL( CacheDirectory::prune( CACHE_DIR, "*.cache",
+                                              UNLIMITED_SIZE, MAX_AGE_DAYS ), 1 );
+    BOOST_CHECK( exists( "recent.cache" ));
+    BOOST_CHECK( !exists( "old.cache" ));
+}
+
+BOOST_FIXTURE_TEST_CASE( testPruneRemovesLeastRecentlyUsedOverSize, CacheDirFixture )
+{
+    createFile( "newest.cache", 1 );
+    createFile( "middle.cache", 2 );
+    createFile( "oldest.cache", 3 );
+
+    BOOST_CHECK_EQUAL( CacheDirectory::prune( CACHE_DIR, "*.cache",
+                                              2 * FILE_SIZE, MAX_AGE_DAYS ), 1 );
+    BOOST_CHECK( exists( "newest.cache" ));
+    BOOST_CHECK( exists( "middle.cache" ));
+    BOOST_CHECK( !exists( "oldest.cache" ));
+}
+
+BOOST_FIXTURE_TEST_CASE( testPruneIgnoresOtherFiles, CacheDirFixture )
+{
+    createFile( "entry.cache" );
+    createFile( "other.txt", MAX_AGE_DAYS + 1 );
+
+    BOOST_CHECK_EQUAL( CacheDirectory::prune( CACHE_DIR, "*.cache",
+                                              0, MAX_AGE_DAYS ), 1 );
+    BOOST_CHECK( !exists( "entry.cache" ));
+    BOOST_CHECK( exists( "other.txt" ));
+}
+
+BOOST_AUTO_TEST_CASE( testUserCacheHomeFollowsXdgCacheHome )
+{
+    const QByteArray previous = qgetenv( "XDG_CACHE_HOME" );
+
+    qputenv( "XDG_CACHE_HOME", "/tmp/xdgcache" );
+    BOOST_CHECK_EQUAL( CacheDirectory::getUserCacheHome().toStdString(),
+                       "/tmp/xdgcache" );
+
+    qputenv( "XDG_CACHE_HOME", QByteArray( ));
+    BOOST_CHECK_EQUAL( CacheDirectory::getUserCacheHome().toStdString(),
+                       ( QDir::homePath() + "/.cache" ).toStdString( ));
+
+    qputenv( "XDG_CACHE_HOME", previous );
+}
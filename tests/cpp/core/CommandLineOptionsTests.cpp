@@ -61,6 +61,11 @@ BOOST_AUTO_TEST_CASE( testCommandLineDefaults )
     BOOST_CHECK_EQUAL( options.getHeight(), 0 );
     BOOST_CHECK_EQUAL( options.getWidth(), 0 );
 
+    BOOST_CHECK_EQUAL( options.getCompressionMode(), COMPRESSION_AUTO );
+    BOOST_CHECK_EQUAL( options.getCompressionQuality(), 75 );
+    BOOST_CHECK_EQUAL( options.getHostServer().toStdString(), "" );
+    BOOST_CHECK_EQUAL( options.getLocalServer().toStdString(), "" );
+
     BOOST_CHECK_EQUAL( options.getCommandLine().toStdString(), "" );
 }
 
@@ -74,6 +79,10 @@ void setOptionParameters(CommandLineOptions& options)
     options.setUrl( "http://www.perdu.com" );
     options.setHeight( 640 );
     options.setWidth( 480 );
+    options.setCompressionMode( COMPRESSION_NEVER );
+    options.setCompressionQuality( 90 );
+    options.setHostServer( "launcher" );
+    options.setLocalServer( "master" );
 }
 
 void checkOptionParameters(const CommandLineOptions& options)
@@ -85,11 +94,17 @@ void checkOptionParameters(const CommandLineOptions& options)
     BOOST_CHECK_EQUAL( options.getUrl().toStdString(), "http://www.perdu.com" );
     BOOST_CHECK_EQUAL( options.getHeight(), 640 );
     BOOST_CHECK_EQUAL( options.getWidth(), 480 );
+    BOOST_CHECK_EQUAL( options.getCompressionMode(), COMPRESSION_NEVER );
+    BOOST_CHECK_EQUAL( options.getCompressionQuality(), 90 );
+    BOOST_CHECK_EQUAL( options.getHostServer().toStdString(), "launcher" );
+    BOOST_CHECK_EQUAL( options.getLocalServer().toStdString(), "master" );
 
     BOOST_CHECK_EQUAL( options.getCommandLine().toStdString(),
                        "--type webkit --width 480 --height 640 --help "
                        "--name MyStreamer --url http://www.perdu.com "
-                       "--rootdir /home/me/my_folder");
+                       "--rootdir /home/me/my_folder "
+                       "--compression off --quality 90 --host launcher "
+                       "--localserver master");
 }
 
 BOOST_AUTO_TEST_CASE( testCommandLineManualCreation )
@@ -132,3 +147,11 @@ BOOST_AUTO_TEST_CASE( testCommandLineFromCommandLineArguments )
     delete [] argList;
 }
 
+BOOST_AUTO_TEST_CASE( testCommandLineFromStringList )
+{
+    CommandLineOptions options;
+    setOptionParameters(options);
+
+    CommandLineOptions optionsDeserialized( options.getCommandLineArguments( ));
+    checkOptionParameters(optionsDeserialized);
+}
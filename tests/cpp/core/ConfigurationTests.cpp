@@ -60,6 +60,8 @@ namespace ut = boost::unit_test;
 #define CONFIG_EXPECTED_WEBSERVICE_PORT 10000
 #define CONFIG_EXPECTED_URL "http://bbp.epfl.ch"
 #define CONFIG_EXPECTED_DEFAULT_URL "http://www.google.com"
+#define CONFIG_EXPECTED_SESSION_ACTIVATION_TIMEOUT 20000
+#define CONFIG_EXPECTED_DEFAULT_SESSION_ACTIVATION_TIMEOUT 10000
 
 BOOST_GLOBAL_FIXTURE( MinimalGlobalQtApp );
 
@@ -105,6 +107,7 @@ BOOST_AUTO_TEST_CASE( test_master_configuration )
     BOOST_CHECK_EQUAL( config.getDockStartDir().toStdString(), CONFIG_EXPECTED_DOCK_DIR );
     BOOST_CHECK_EQUAL( config.getWebServicePort(), CONFIG_EXPECTED_WEBSERVICE_PORT );
     BOOST_CHECK_EQUAL( config.getWebBrowserDefaultURL().toStdString(), CONFIG_EXPECTED_URL );
+    BOOST_CHECK_EQUAL( config.getSessionActivationTimeout(), CONFIG_EXPECTED_SESSION_ACTIVATION_TIMEOUT );
 
     BOOST_CHECK( config.getBackgroundColor() == QColor( CONFIG_EXPECTED_BACKGROUND_COLOR ));
     BOOST_CHECK_EQUAL( config.getBackgroundUri().toStdString(), CONFIG_EXPECTED_BACKGROUND );
@@ -116,6 +119,7 @@ BOOST_AUTO_TEST_CASE( test_master_configuration_default_values )
 
     BOOST_CHECK_EQUAL( config.getDockStartDir().toStdString(), QDir::homePath().toStdString() );
     BOOST_CHECK_EQUAL( config.getWebBrowserDefaultURL().toStdString(), CONFIG_EXPECTED_DEFAULT_URL );
+    BOOST_CHECK_EQUAL( config.getSessionActivationTimeout(), CONFIG_EXPECTED_DEFAULT_SESSION_ACTIVATION_TIMEOUT );
 }
 
 BOOST_AUTO_TEST_CASE( test_save_configuration )
@@ -0,0 +1,166 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE DisplayGroupStateTrackerTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "ContentWindow.h"
+#include "DisplayGroup.h"
+#include "ws/DisplayGroupStateTracker.h"
+
+#include "MinimalGlobalQtApp.h"
+BOOST_GLOBAL_FIXTURE( MinimalGlobalQtApp )
+
+#include "DummyContent.h"
+
+namespace
+{
+const QSizeF wallSize( 1000, 1000 );
+
+ContentWindowPtr makeWindow( const QString& uri )
+{
+    ContentPtr content( new DummyContent( uri ));
+    content->setDimensions( QSize( 100, 100 ));
+    return ContentWindowPtr( new ContentWindow( content ));
+}
+
+struct Fixture
+{
+    Fixture()
+        : displayGroup( new DisplayGroup( wallSize ))
+        , window( makeWindow( "image.png" ))
+    {
+        displayGroup->addContentWindow( window );
+        tracker.reset( new DisplayGroupStateTracker( displayGroup, 1 ));
+        QObject::connect( displayGroup.get(), SIGNAL( modified( DisplayGroupPtr )),
+                          tracker.get(), SLOT( update( DisplayGroupPtr )));
+    }
+
+    DisplayGroupPtr displayGroup;
+    ContentWindowPtr window;
+    DisplayGroupStateTrackerPtr tracker;
+};
+}
+
+BOOST_FIXTURE_TEST_CASE( testInitialSnapshot, Fixture )
+{
+    const DisplayGroupStateTracker::Snapshot& snapshot = tracker->getSnapshot();
+
+    BOOST_CHECK_EQUAL( snapshot.revision, 1 );
+    BOOST_CHECK( snapshot.background == "null" );
+    BOOST_REQUIRE_EQUAL( snapshot.windows.size(), 1 );
+    BOOST_CHECK( snapshot.windows[0].contains( window->getID().toString( )));
+    BOOST_CHECK( snapshot.windows[0].contains( "\"uri\":\"image.png\"" ));
+    BOOST_CHECK( snapshot.windows[0].contains( "\"z\":0" ));
+}
+
+BOOST_FIXTURE_TEST_CASE( testChangesOnlyContainModifiedWindows, Fixture )
+{
+    ContentWindowPtr otherWindow = makeWindow( "movie.mp4" );
+    displayGroup->addContentWindow( otherWindow );
+    BOOST_REQUIRE_EQUAL( tracker->getSnapshot().revision, 2 );
+
+    window->setCoordinates( QRectF( 10, 20, 100, 100 ));
+
+    DisplayGroupStateTracker::Changes changes;
+    BOOST_REQUIRE( tracker->waitForChanges( 2, 0, changes ));
+    BOOST_CHECK_EQUAL( changes.revision, 3 );
+    BOOST_CHECK( !changes.reset );
+    BOOST_REQUIRE_EQUAL( changes.windows.size(), 1 );
+    BOOST_CHECK( changes.windows[0].contains( window->getID().toString( )));
+    BOOST_CHECK( changes.windows[0].contains( "\"x\":10,\"y\":20" ));
+    BOOST_CHECK( changes.removed.isEmpty( ));
+
+    BOOST_REQUIRE( tracker->waitForChanges( 1, 0, changes ));
+    BOOST_CHECK_EQUAL( changes.windows.size(), 2 );
+}
+
+BOOST_FIXTURE_TEST_CASE( testRemovedWindows, Fixture )
+{
+    displayGroup->removeContentWindow( window );
+
+    DisplayGroupStateTracker::Changes changes;
+    BOOST_REQUIRE( tracker->waitForChanges( 1, 0, changes ));
+    BOOST_CHECK_EQUAL( changes.revision, 2 );
+    BOOST_CHECK( changes.windows.isEmpty( ));
+    BOOST_REQUIRE_EQUAL( changes.removed.size(), 1 );
+    BOOST_CHECK( changes.removed[0] == window->getID().toString( ));
+    BOOST_CHECK( tracker->getSnapshot().windows.isEmpty( ));
+}
+
+BOOST_FIXTURE_TEST_CASE( testRevisionUnchangedWithoutModification, Fixture )
+{
+    tracker->update( displayGroup );
+    BOOST_CHECK_EQUAL( tracker->getSnapshot().revision, 1 );
+
+    DisplayGroupStateTracker::Changes changes;
+    BOOST_REQUIRE( tracker->waitForChanges( 1, 10, changes ));
+    BOOST_CHECK_EQUAL( changes.revision, 1 );
+    BOOST_CHECK( changes.windows.isEmpty( ));
+    BOOST_CHECK( changes.removed.isEmpty( ));
+}
+
+BOOST_FIXTURE_TEST_CASE( testUnknownRevisionResetsClient, Fixture )
+{
+    DisplayGroupStateTracker::Changes changes;
+    BOOST_REQUIRE( tracker->waitForChanges( 42, 0, changes ));
+    BOOST_CHECK( changes.reset );
+    BOOST_CHECK_EQUAL( changes.revision, 1 );
+    BOOST_CHECK_EQUAL( changes.windows.size(), 1 );
+}
+
+BOOST_FIXTURE_TEST_CASE( testReleasedTrackerDoesNotWait, Fixture )
+{
+    tracker->releaseWaiters();
+
+    DisplayGroupStateTracker::Changes changes;
+    BOOST_CHECK( tracker->waitForChanges( 1, 60000, changes ));
+    BOOST_CHECK_EQUAL( changes.revision, 1 );
+}
+
+BOOST_FIXTURE_TEST_CASE( testTooManyWaiters, Fixture )
+{
+    DisplayGroupStateTracker busyTracker( displayGroup, 0 );
+
+    DisplayGroupStateTracker::Changes changes;
+    BOOST_CHECK( !busyTracker.waitForChanges( 1, 10, changes ));
+    // Clients which are late get their changes without waiting
+    BOOST_CHECK( busyTracker.waitForChanges( 0, 10, changes ));
+    BOOST_CHECK_EQUAL( changes.windows.size(), 1 );
+}
@@ -0,0 +1,145 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE FFMPEGKeyframeIndexTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "FFMPEGKeyframeIndex.h"
+
+#include <QDir>
+#include <QFile>
+
+namespace
+{
+const QString CACHE_HOME = "tmp_keyframeindex_cache";
+const QString MOVIE_FILE = "tmp_keyframeindex_movie.mp4";
+
+std::vector<int64_t> makeTimestamps()
+{
+    std::vector<int64_t> timestamps;
+    timestamps.push_back( 300 );
+    timestamps.push_back( 0 );
+    timestamps.push_back( 100 );
+    timestamps.push_back( 200 );
+    timestamps.push_back( 100 );
+    return timestamps;
+}
+
+void writeMovie( const QByteArray& content )
+{
+    QFile file( MOVIE_FILE );
+    file.open( QIODevice::WriteOnly );
+    file.write( content );
+}
+
+struct CacheFixture
+{
+    CacheFixture()
+        : previousCacheHome( qgetenv( "XDG_CACHE_HOME" ))
+    {
+        qputenv( "XDG_CACHE_HOME", QDir( CACHE_HOME ).absolutePath().toLocal8Bit( ));
+        writeMovie( "not really a movie" );
+    }
+    ~CacheFixture()
+    {
+        QFile::remove( MOVIE_FILE );
+        QDir dir( FFMPEGKeyframeIndex::getCacheDirectory( ));
+        foreach( const QString& file, dir.entryList( QDir::Files ))
+            dir.remove( file );
+        QDir().rmpath( CACHE_HOME + "/displaycluster/keyframes" );
+        qputenv( "XDG_CACHE_HOME", previousCacheHome );
+    }
+    const QByteArray previousCacheHome;
+};
+}
+
+BOOST_AUTO_TEST_CASE( testIndexIsSortedWithoutDuplicates )
+{
+    FFMPEGKeyframeIndex index;
+    BOOST_CHECK( index.isEmpty( ));
+    BOOST_CHECK_EQUAL( index.findKeyframe( 100 ), (int64_t)AV_NOPTS_VALUE );
+
+    index.build( makeTimestamps( ));
+    BOOST_REQUIRE_EQUAL( index.getKeyframeCount(), 4u );
+    BOOST_CHECK_EQUAL( index.getTimestamps()[0], 0 );
+    BOOST_CHECK_EQUAL( index.getTimestamps()[3], 300 );
+
+    BOOST_CHECK_EQUAL( index.findKeyframe( -1 ), (int64_t)AV_NOPTS_VALUE );
+    BOOST_CHECK_EQUAL( index.findKeyframe( 0 ), 0 );
+    BOOST_CHECK_EQUAL( index.findKeyframe( 150 ), 100 );
+    BOOST_CHECK_EQUAL( index.findKeyframe( 200 ), 200 );
+    BOOST_CHECK_EQUAL( index.findKeyframe( 1000 ), 300 );
+}
+
+BOOST_FIXTURE_TEST_CASE( testIndexRoundTripThroughUserCache, CacheFixture )
+{
+    FFMPEGKeyframeIndex index;
+    index.build( makeTimestamps( ));
+    BOOST_REQUIRE( index.save( MOVIE_FILE ));
+
+    // Nothing is written next to the movie
+    BOOST_CHECK( !QFile::exists( MOVIE_FILE + ".keyframes" ));
+    BOOST_CHECK( FFMPEGKeyframeIndex::getCacheDirectory().startsWith(
+                     QDir( CACHE_HOME ).absolutePath( )));
+
+    FFMPEGKeyframeIndex loaded;
+    BOOST_REQUIRE( loaded.load( MOVIE_FILE ));
+    BOOST_CHECK( loaded.getTimestamps() == index.getTimestamps( ));
+}
+
+BOOST_FIXTURE_TEST_CASE( testIndexOfModifiedMovieIsNotLoaded, CacheFixture )
+{
+    FFMPEGKeyframeIndex index;
+    index.build( makeTimestamps( ));
+    BOOST_REQUIRE( index.save( MOVIE_FILE ));
+
+    writeMovie( "a different movie with another size" );
+
+    FFMPEGKeyframeIndex loaded;
+    BOOST_CHECK( !loaded.load( MOVIE_FILE ));
+    BOOST_CHECK( loaded.isEmpty( ));
+}
+
+BOOST_FIXTURE_TEST_CASE( testMissingIndexIsNotLoaded, CacheFixture )
+{
+    FFMPEGKeyframeIndex index;
+    BOOST_CHECK( !index.load( MOVIE_FILE ));
+    BOOST_CHECK( !index.load( "no_such_movie.mp4" ));
+    BOOST_CHECK( index.isEmpty( ));
+}
@@ -0,0 +1,164 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE PixelStreamTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "PixelStream.h"
+
+namespace
+{
+deflect::PixelStreamSegment makeSegment( const unsigned int x,
+                                         const unsigned int y,
+                                         const unsigned int width,
+                                         const unsigned int height,
+                                         const char* data )
+{
+    deflect::PixelStreamSegment segment;
+    segment.parameters.x = x;
+    segment.parameters.y = y;
+    segment.parameters.width = width;
+    segment.parameters.height = height;
+    segment.imageData = QByteArray( data );
+    return segment;
+}
+
+// A 2x2 grid of 512x512 segments
+deflect::PixelStreamSegments makeFullFrame( const char* data )
+{
+    deflect::PixelStreamSegments segments;
+    segments.push_back( makeSegment( 0, 0, 512, 512, data ));
+    segments.push_back( makeSegment( 512, 0, 512, 512, data ));
+    segments.push_back( makeSegment( 0, 512, 512, 512, data ));
+    segments.push_back( makeSegment( 512, 512, 512, 512, data ));
+    return segments;
+}
+}
+
+BOOST_AUTO_TEST_CASE( testFullFrameReplacesPreviousFrame )
+{
+    const deflect::PixelStreamSegments previous = makeFullFrame( "old" );
+    deflect::PixelStreamSegments update;
+    update.push_back( makeSegment( 0, 0, 256, 256, "new" ));
+
+    const deflect::PixelStreamSegments merged =
+            PixelStream::mergeSegments( previous, update );
+
+    BOOST_REQUIRE_EQUAL( merged.size(), 1 );
+    BOOST_CHECK( merged[0].imageData == "new" );
+}
+
+BOOST_AUTO_TEST_CASE( testPartialFrameReplacesChangedSegments )
+{
+    const deflect::PixelStreamSegments previous = makeFullFrame( "old" );
+    deflect::PixelStreamSegments update;
+    update.push_back( makeSegment( 512, 0, 512, 512, "new" ));
+    update.push_back( makeSegment( 512, 512, 512, 512, "new" ));
+
+    std::vector<bool> changed;
+    const deflect::PixelStreamSegments merged =
+            PixelStream::mergeSegments( previous, update, &changed );
+
+    BOOST_REQUIRE_EQUAL( merged.size(), 4 );
+    BOOST_CHECK( merged[0].imageData == "old" );
+    BOOST_CHECK( merged[1].imageData == "new" );
+    BOOST_CHECK( merged[2].imageData == "old" );
+    BOOST_CHECK( merged[3].imageData == "new" );
+
+    // Only the renderers of the replaced segments need new textures
+    BOOST_REQUIRE_EQUAL( changed.size(), 4 );
+    BOOST_CHECK( !changed[0] );
+    BOOST_CHECK( changed[1] );
+    BOOST_CHECK( !changed[2] );
+    BOOST_CHECK( changed[3] );
+}
+
+BOOST_AUTO_TEST_CASE( testPartialFrameDropsSegmentsOutsideOfFrame )
+{
+    const deflect::PixelStreamSegments previous = makeFullFrame( "old" );
+    deflect::PixelStreamSegments update;
+    update.push_back( makeSegment( 512, 0, 256, 512, "new" ));
+
+    std::vector<bool> changed;
+    const deflect::PixelStreamSegments merged =
+            PixelStream::mergeSegments( previous, update, &changed );
+
+    BOOST_REQUIRE_EQUAL( merged.size(), 2 );
+    BOOST_CHECK( merged[0].imageData == "old" );
+    BOOST_CHECK_EQUAL( merged[1].parameters.width, 256 );
+    BOOST_CHECK( merged[1].imageData == "new" );
+
+    BOOST_REQUIRE_EQUAL( changed.size(), 2 );
+    BOOST_CHECK( !changed[0] );
+    BOOST_CHECK( changed[1] );
+}
+
+BOOST_AUTO_TEST_CASE( testPartialFrameMarksShiftedSegmentsAsChanged )
+{
+    // The second segment is dropped, the third one takes its renderer
+    deflect::PixelStreamSegments previous;
+    previous.push_back( makeSegment( 0, 0, 512, 512, "old" ));
+    previous.push_back( makeSegment( 512, 0, 512, 512, "old" ));
+    previous.push_back( makeSegment( 0, 512, 512, 512, "old" ));
+    deflect::PixelStreamSegments update;
+    update.push_back( makeSegment( 0, 768, 512, 256, "new" ));
+
+    std::vector<bool> changed;
+    const deflect::PixelStreamSegments merged =
+            PixelStream::mergeSegments( previous, update, &changed );
+
+    BOOST_REQUIRE_EQUAL( merged.size(), 3 );
+    BOOST_CHECK_EQUAL( merged[1].parameters.y, 512 );
+    BOOST_REQUIRE_EQUAL( changed.size(), 3 );
+    BOOST_CHECK( !changed[0] );
+    BOOST_CHECK( changed[1] );
+    BOOST_CHECK( changed[2] );
+}
+
+BOOST_AUTO_TEST_CASE( testFirstFrameIsUsedAsIs )
+{
+    deflect::PixelStreamSegments update;
+    update.push_back( makeSegment( 512, 512, 512, 512, "new" ));
+
+    const deflect::PixelStreamSegments merged =
+            PixelStream::mergeSegments( deflect::PixelStreamSegments(), update );
+
+    BOOST_REQUIRE_EQUAL( merged.size(), 1 );
+    BOOST_CHECK( merged[0].imageData == "new" );
+}
@@ -0,0 +1,164 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE PresentationSchedulerTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "PresentationScheduler.h"
+
+using namespace boost::posix_time;
+
+namespace
+{
+const ptime wallStart( boost::gregorian::date( 2015, 1, 1 ));
+const time_duration vsync = milliseconds( 16 );
+const time_duration movieFrame = milliseconds( 40 ); // 25 fps
+}
+
+BOOST_AUTO_TEST_CASE( testPositionFollowsWallClock )
+{
+    PresentationScheduler scheduler;
+    scheduler.setRefreshInterval( vsync );
+
+    scheduler.update( wallStart );
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), time_duration( ));
+
+    scheduler.update( wallStart + milliseconds( 100 ));
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), milliseconds( 100 ));
+
+    // A late render loop does not slow down the playback
+    scheduler.update( wallStart + milliseconds( 350 ));
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), milliseconds( 350 ));
+    BOOST_CHECK_EQUAL( scheduler.getPresentationTime(), milliseconds( 358 ));
+}
+
+BOOST_AUTO_TEST_CASE( testRepeatedUpdateHasNoEffect )
+{
+    PresentationScheduler scheduler;
+    scheduler.update( wallStart );
+    scheduler.update( wallStart + milliseconds( 50 ));
+    scheduler.update( wallStart + milliseconds( 50 ));
+    scheduler.update( wallStart + milliseconds( 50 ));
+
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), milliseconds( 50 ));
+}
+
+BOOST_AUTO_TEST_CASE( testPresentationTimeIsMiddleOfRefreshInterval )
+{
+    PresentationScheduler scheduler;
+    scheduler.setRefreshInterval( vsync );
+
+    // At 60Hz, 25fps frames are shown for 2 or 3 refresh intervals each,
+    // always the frame covering the middle of the interval.
+    const int expected[] = { 0, 0, 1, 1, 1, 2, 2, 3, 3, 3, 4, 4 };
+    for( int i = 0; i < 12; ++i )
+    {
+        scheduler.update( wallStart + vsync * i );
+        BOOST_CHECK_EQUAL( scheduler.getPresentationTime(), vsync * i + vsync / 2 );
+        BOOST_CHECK_EQUAL( scheduler.getPresentationTime().total_milliseconds() /
+                           movieFrame.total_milliseconds(), expected[i] );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testPauseAndResume )
+{
+    PresentationScheduler scheduler;
+    scheduler.update( wallStart );
+    scheduler.update( wallStart + milliseconds( 100 ));
+
+    scheduler.setPaused( true );
+    scheduler.update( wallStart + milliseconds( 5000 ));
+    BOOST_CHECK( scheduler.isPaused( ));
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), milliseconds( 100 ));
+    BOOST_CHECK_EQUAL( scheduler.getPresentationTime(), milliseconds( 100 ));
+
+    scheduler.setPaused( false );
+    scheduler.update( wallStart + milliseconds( 5040 ));
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), milliseconds( 140 ));
+}
+
+BOOST_AUTO_TEST_CASE( testSetPosition )
+{
+    PresentationScheduler scheduler;
+    scheduler.update( wallStart );
+    scheduler.update( wallStart + milliseconds( 100 ));
+
+    scheduler.setPosition( seconds( 10 ));
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), seconds( 10 ));
+
+    scheduler.update( wallStart + milliseconds( 150 ));
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), milliseconds( 10050 ));
+}
+
+BOOST_AUTO_TEST_CASE( testLoopAndClampAtEnd )
+{
+    PresentationScheduler scheduler;
+    scheduler.setDuration( seconds( 2 ));
+    scheduler.update( wallStart );
+
+    scheduler.update( wallStart + milliseconds( 2500 ));
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), seconds( 2 ));
+
+    scheduler.setLoop( true );
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), milliseconds( 500 ));
+
+    scheduler.update( wallStart + milliseconds( 6100 ));
+    BOOST_CHECK_EQUAL( scheduler.getPosition(), milliseconds( 100 ));
+}
+
+BOOST_AUTO_TEST_CASE( testSharedSchedulerFrameLocksMovies )
+{
+    PresentationSchedulerPtr scheduler( new PresentationScheduler );
+    scheduler->setRefreshInterval( vsync );
+    // Simulate two movies of a group updating the shared scheduler in turn
+    // with an irregular render loop.
+    const int frameTimesMs[] = { 0, 17, 31, 70, 71, 120, 300, 316 };
+    for( size_t i = 0; i < sizeof( frameTimesMs ) / sizeof( int ); ++i )
+    {
+        const ptime frameTime = wallStart + milliseconds( frameTimesMs[i] );
+
+        scheduler->update( frameTime );
+        const time_duration positionA = scheduler->getPresentationTime();
+        scheduler->update( frameTime );
+        const time_duration positionB = scheduler->getPresentationTime();
+
+        BOOST_CHECK_EQUAL( positionA, positionB );
+        BOOST_CHECK_EQUAL( positionA, milliseconds( frameTimesMs[i] + 8 ));
+    }
+}
@@ -0,0 +1,117 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE PyramidTilingTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "PyramidTiling.h"
+
+namespace
+{
+const QSizeF a4Page( 595.0, 842.0 ); // points
+const double maxScale = 1200.0 / 72.0; // 1200 dpi
+}
+
+BOOST_AUTO_TEST_CASE( testLevelZeroFitsInOneTile )
+{
+    const PyramidTiling tiling( a4Page, maxScale );
+
+    BOOST_CHECK_EQUAL( tiling.getImageSize( 0 ).height(), PyramidTiling::tileSize );
+    BOOST_CHECK( tiling.getImageSize( 0 ).width() <= PyramidTiling::tileSize );
+    BOOST_CHECK( tiling.getTileCount( 0 ) == QSize( 1, 1 ));
+}
+
+BOOST_AUTO_TEST_CASE( testEachLevelDoublesTheResolution )
+{
+    const PyramidTiling tiling( a4Page, maxScale );
+
+    BOOST_REQUIRE( tiling.getMaxLevel() >= 2 );
+    BOOST_CHECK_CLOSE( tiling.getScale( 1 ), 2.0 * tiling.getScale( 0 ), 1e-9 );
+    BOOST_CHECK_EQUAL( tiling.getImageSize( 2 ).height(), 4 * PyramidTiling::tileSize );
+    BOOST_CHECK( tiling.getTileCount( 2 ) == QSize( 3, 4 ));
+    BOOST_CHECK( tiling.getScale( tiling.getMaxLevel( )) <= maxScale );
+    BOOST_CHECK( tiling.getScale( tiling.getMaxLevel() + 1 ) > maxScale );
+}
+
+BOOST_AUTO_TEST_CASE( testLevelMatchesDisplayedSize )
+{
+    const PyramidTiling tiling( a4Page, maxScale );
+
+    BOOST_CHECK_EQUAL( tiling.getLevel( QSizeF( 300, 400 )), 0 );
+    BOOST_CHECK_EQUAL( tiling.getLevel( QSizeF( 362, 512 )), 0 );
+    BOOST_CHECK_EQUAL( tiling.getLevel( QSizeF( 362, 513 )), 1 );
+    BOOST_CHECK_EQUAL( tiling.getLevel( QSizeF( 1400, 2000 )), 2 );
+    BOOST_CHECK_EQUAL( tiling.getLevel( QSizeF( 1e6, 1e6 )), tiling.getMaxLevel( ));
+}
+
+BOOST_AUTO_TEST_CASE( testBorderTilesAreClippedToThePage )
+{
+    const PyramidTiling tiling( a4Page, maxScale );
+    const QSize imageSize = tiling.getImageSize( 1 );
+
+    const QRect lastTile = tiling.getTileRect( TileIndex( 0, 1, 1, 1 ));
+    BOOST_CHECK_EQUAL( lastTile.right(), imageSize.width() - 1 );
+    BOOST_CHECK_EQUAL( lastTile.bottom(), imageSize.height() - 1 );
+
+    const QRectF normalized = tiling.getNormalizedTileRect( TileIndex( 0, 1, 1, 1 ));
+    BOOST_CHECK_CLOSE( normalized.right(), 1.0, 1e-9 );
+    BOOST_CHECK_CLOSE( normalized.bottom(), 1.0, 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( testTilesInRegion )
+{
+    const PyramidTiling tiling( a4Page, maxScale );
+
+    BOOST_CHECK( tiling.getTilesInRegion( 2, QRectF( 0, 0, 1, 1 )) ==
+                QRect( 0, 0, 3, 4 ));
+    BOOST_CHECK( tiling.getTilesInRegion( 2, QRectF( 0.1, 0.1, 0.1, 0.1 )) ==
+                QRect( 0, 0, 1, 1 ));
+    BOOST_CHECK( tiling.getTilesInRegion( 2, QRectF( 0.5, 0.5, 0.5, 0.5 )) ==
+                QRect( 1, 2, 2, 2 ));
+    BOOST_CHECK( tiling.getTilesInRegion( 2, QRectF( 2, 2, 1, 1 )).isEmpty( ));
+}
+
+BOOST_AUTO_TEST_CASE( testAncestorTiles )
+{
+    const TileIndex tile( 3, 2, 3, 2 );
+
+    BOOST_CHECK( tile.getAncestor( 2 ) == tile );
+    BOOST_CHECK( tile.getAncestor( 1 ) == TileIndex( 3, 1, 1, 1 ));
+    BOOST_CHECK( tile.getAncestor( 0 ) == TileIndex( 3, 0, 0, 0 ));
+}
@@ -0,0 +1,95 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef RESTOREDMOVIESESSION_H
+#define RESTOREDMOVIESESSION_H
+
+#include "ContentAction.h"
+#include "ContentFactory.h"
+#include "ContentWindow.h"
+#include "DisplayGroup.h"
+#include "MovieContent.h"
+#include "StateSerializationHelper.h"
+
+#include <QDataStream>
+#include <QFile>
+
+#include <boost/make_shared.hpp>
+
+/**
+ * A session with a single movie window, to check that the windows restored
+ * from a file in a worker thread still react to their actions.
+ */
+namespace RestoredMovieSession
+{
+const QString MOVIE_URI = "movie.tiledmovie";
+
+inline bool save( const QString& filename, const QSize& wallSize )
+{
+    ContentPtr content = ContentFactory::getContent( MOVIE_URI );
+    if( !content )
+        return false;
+
+    DisplayGroupPtr displayGroup = boost::make_shared<DisplayGroup>( wallSize );
+    displayGroup->addContentWindow( ContentWindowPtr( new ContentWindow( content )));
+    return StateSerializationHelper( displayGroup ).save( filename, false );
+}
+
+inline ContentAction* getPlayPauseAction( ContentWindowPtr window )
+{
+    ContentActionsModel* actions = window->getContent()->getActions();
+    if( actions->rowCount() < 1 )
+        return 0;
+    const QVariant action = actions->data( actions->index( 0 ), Qt::UserRole );
+    return qobject_cast<ContentAction*>( action.value<QObject*>( ));
+}
+
+inline bool isPaused( ContentWindowPtr window )
+{
+    QByteArray state;
+    QDataStream out( &state, QIODevice::WriteOnly );
+    window->getContent()->writeState( out );
+
+    QDataStream in( state );
+    qint32 controlState = 0;
+    in >> controlState;
+    return controlState & STATE_PAUSED;
+}
+}
+
+#endif // RESTOREDMOVIESESSION_H
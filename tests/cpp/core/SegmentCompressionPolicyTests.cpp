@@ -0,0 +1,139 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE SegmentCompressionPolicyTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "localstreamer/SegmentCompressionPolicy.h"
+
+namespace
+{
+const QSize SEGMENT_SIZE( 256, 256 );
+const QPoint POSITION( 512, 0 );
+
+QImage createFlatImage( const uint color = 0xffffffff )
+{
+    QImage image( SEGMENT_SIZE, QImage::Format_RGB32 );
+    image.fill( color );
+    return image;
+}
+
+QImage createNoiseImage()
+{
+    QImage image( SEGMENT_SIZE, QImage::Format_RGB32 );
+    for( int y = 0; y < image.height(); ++y )
+        for( int x = 0; x < image.width(); ++x )
+            image.setPixel( x, y, qRgb( rand() % 256, rand() % 256, rand() % 256 ));
+    return image;
+}
+}
+
+BOOST_AUTO_TEST_CASE( testCompressionModeStrings )
+{
+    BOOST_CHECK_EQUAL( getCompressionMode( "on" ), COMPRESSION_ALWAYS );
+    BOOST_CHECK_EQUAL( getCompressionMode( "off" ), COMPRESSION_NEVER );
+    BOOST_CHECK_EQUAL( getCompressionMode( "auto" ), COMPRESSION_AUTO );
+    BOOST_CHECK_EQUAL( getCompressionMode( "invalid" ), COMPRESSION_AUTO );
+    BOOST_CHECK( getCompressionModeString( COMPRESSION_NEVER ) == "off" );
+}
+
+BOOST_AUTO_TEST_CASE( testEntropy )
+{
+    BOOST_CHECK_EQUAL( SegmentCompressionPolicy::computeEntropy( createFlatImage( )), 0.0 );
+    BOOST_CHECK_GT( SegmentCompressionPolicy::computeEntropy( createNoiseImage( )), 6.0 );
+}
+
+BOOST_AUTO_TEST_CASE( testFixedModes )
+{
+    SegmentCompressionPolicy always( COMPRESSION_ALWAYS, 90 );
+    BOOST_CHECK( always.shouldCompress( createFlatImage(), POSITION, 0 ));
+    BOOST_CHECK_EQUAL( always.getQuality(), 90 );
+
+    SegmentCompressionPolicy never( COMPRESSION_NEVER );
+    BOOST_CHECK( !never.shouldCompress( createNoiseImage(), POSITION, 0 ));
+}
+
+BOOST_AUTO_TEST_CASE( testStaticSegmentsDependOnContent )
+{
+    SegmentCompressionPolicy policy;
+
+    BOOST_CHECK( !policy.shouldCompress( createFlatImage(), QPoint( 0, 0 ), 0 ));
+    BOOST_CHECK( policy.shouldCompress( createNoiseImage(), POSITION, 0 ));
+
+    // Rare updates do not change the decision
+    BOOST_CHECK( !policy.shouldCompress( createFlatImage(), QPoint( 0, 0 ), 5000 ));
+}
+
+BOOST_AUTO_TEST_CASE( testFrequentlyChangingSegmentsAreCompressed )
+{
+    SegmentCompressionPolicy policy;
+
+    BOOST_CHECK( !policy.shouldCompress( createFlatImage( 0xff000000 ), POSITION, 0 ));
+    BOOST_CHECK( policy.shouldCompress( createFlatImage( 0xff101010 ), POSITION, 40 ));
+    BOOST_CHECK( policy.shouldCompress( createFlatImage( 0xff202020 ), POSITION, 80 ));
+
+    // Other segments are not affected
+    BOOST_CHECK( !policy.shouldCompress( createFlatImage(), QPoint( 0, 0 ), 80 ));
+}
+
+BOOST_AUTO_TEST_CASE( testResendingUnchangedSegmentsIsNotAChange )
+{
+    SegmentCompressionPolicy policy;
+    const QImage image = createFlatImage();
+
+    // A streamer sending full frames at a high rate over a static area
+    BOOST_CHECK( !policy.shouldCompress( image, POSITION, 0 ));
+    BOOST_CHECK( !policy.shouldCompress( image, POSITION, 40 ));
+    BOOST_CHECK( !policy.shouldCompress( image, POSITION, 80 ));
+}
+
+BOOST_AUTO_TEST_CASE( testRefreshOfUnchangedSegmentsIsLossless )
+{
+    SegmentCompressionPolicy policy;
+    const QImage image = createNoiseImage();
+
+    BOOST_CHECK( policy.shouldCompress( image, POSITION, 0 ));
+    BOOST_CHECK( !policy.shouldCompress( image, POSITION, 1000 ));
+}
+
+BOOST_AUTO_TEST_CASE( testQualityIsClamped )
+{
+    BOOST_CHECK_EQUAL( SegmentCompressionPolicy( COMPRESSION_AUTO, 0 ).getQuality(), 1 );
+    BOOST_CHECK_EQUAL( SegmentCompressionPolicy( COMPRESSION_AUTO, 200 ).getQuality(), 100 );
+}
@@ -0,0 +1,189 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE SessionPreloaderTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "SessionPreloader.h"
+#include "DisplayGroup.h"
+#include "ContentWindow.h"
+#include "RestoredMovieSession.h"
+
+#include <QTime>
+
+#include <boost/make_shared.hpp>
+
+// QCoreApplication is required by QtXml for loading legacy state files
+#include "MinimalGlobalQtApp.h"
+BOOST_GLOBAL_FIXTURE( MinimalGlobalQtApp )
+
+namespace
+{
+const QSize wallSize( 3840*2+14, 1080*3+2*12 );
+const QString STATE_V0_URI = "state_v0.dcx";
+const QString INVALID_URI = "/invalid/uri.dcx";
+// The identifiers of the sessions are attributed sequentially from 1
+const unsigned int FIRST_SESSION_ID = 1;
+const int SHORT_ACTIVATION_TIMEOUT_MS = 10;
+const int MAX_WAIT_MS = 5000;
+const QString MOVIE_SESSION_URI = "tmp_sessionpreloader_movie.dcxb";
+
+// The state file is read in a worker thread, which reports back through
+// the event loop
+void waitForLoading( const SessionPreloader& preloader )
+{
+    while( preloader.isLoading( ))
+        QCoreApplication::processEvents( QEventLoop::WaitForMoreEvents );
+}
+}
+
+BOOST_AUTO_TEST_CASE( testSessionIsShownWhenWallsAreReady )
+{
+    DisplayGroupPtr displayGroup = boost::make_shared<DisplayGroup>( wallSize );
+    SessionPreloader preloader( displayGroup );
+
+    preloader.prepare( STATE_V0_URI );
+    BOOST_CHECK( preloader.isLoading( ));
+    BOOST_CHECK( !preloader.isReady( ));
+
+    // Activating while loading keeps the current session until it is ready
+    preloader.activate();
+    waitForLoading( preloader );
+    BOOST_CHECK( !preloader.isReady( ));
+    BOOST_CHECK( displayGroup->getContentWindows().empty( ));
+
+    // Reports for other sessions are ignored
+    preloader.preloadFinished( FIRST_SESSION_ID + 1 );
+    BOOST_CHECK( displayGroup->getContentWindows().empty( ));
+
+    preloader.preloadFinished( FIRST_SESSION_ID );
+    BOOST_CHECK_EQUAL( displayGroup->getContentWindows().size(), 1 );
+    BOOST_CHECK( !preloader.isReady( ));
+}
+
+BOOST_AUTO_TEST_CASE( testReadySessionIsShownImmediately )
+{
+    DisplayGroupPtr displayGroup = boost::make_shared<DisplayGroup>( wallSize );
+    SessionPreloader preloader( displayGroup );
+
+    preloader.prepare( STATE_V0_URI );
+    waitForLoading( preloader );
+    preloader.preloadFinished( FIRST_SESSION_ID );
+    BOOST_CHECK( preloader.isReady( ));
+    BOOST_CHECK( displayGroup->getContentWindows().empty( ));
+
+    preloader.activate();
+    BOOST_CHECK_EQUAL( displayGroup->getContentWindows().size(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE( testInvalidSessionIsNotPrepared )
+{
+    DisplayGroupPtr displayGroup = boost::make_shared<DisplayGroup>( wallSize );
+    SessionPreloader preloader( displayGroup );
+
+    preloader.load( INVALID_URI );
+    waitForLoading( preloader );
+    BOOST_CHECK( !preloader.isReady( ));
+
+    preloader.preloadFinished( FIRST_SESSION_ID );
+    BOOST_CHECK( displayGroup->getContentWindows().empty( ));
+}
+
+BOOST_AUTO_TEST_CASE( testNewSessionReplacesLoadingOne )
+{
+    DisplayGroupPtr displayGroup = boost::make_shared<DisplayGroup>( wallSize );
+    SessionPreloader preloader( displayGroup );
+
+    preloader.prepare( INVALID_URI );
+    preloader.load( STATE_V0_URI );
+    waitForLoading( preloader );
+
+    preloader.preloadFinished( FIRST_SESSION_ID );
+    BOOST_CHECK_EQUAL( displayGroup->getContentWindows().size(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE( testSessionIsShownAfterActivationTimeout )
+{
+    DisplayGroupPtr displayGroup = boost::make_shared<DisplayGroup>( wallSize );
+    SessionPreloader preloader( displayGroup );
+    preloader.setActivationTimeout( SHORT_ACTIVATION_TIMEOUT_MS );
+
+    preloader.load( STATE_V0_URI );
+    waitForLoading( preloader );
+    BOOST_CHECK( displayGroup->getContentWindows().empty( ));
+
+    // The walls never report, the session is shown when the timer expires
+    QTime time;
+    time.start();
+    while( displayGroup->getContentWindows().empty() &&
+           time.elapsed() < MAX_WAIT_MS )
+    {
+        QCoreApplication::processEvents( QEventLoop::WaitForMoreEvents );
+    }
+    BOOST_CHECK_EQUAL( displayGroup->getContentWindows().size(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE( testPreloadedMovieWindowCanBePaused )
+{
+    BOOST_REQUIRE( RestoredMovieSession::save( MOVIE_SESSION_URI, wallSize ));
+
+    DisplayGroupPtr displayGroup = boost::make_shared<DisplayGroup>( wallSize );
+    SessionPreloader preloader( displayGroup );
+    preloader.load( MOVIE_SESSION_URI );
+    waitForLoading( preloader );
+    preloader.preloadFinished( FIRST_SESSION_ID );
+    BOOST_REQUIRE_EQUAL( displayGroup->getContentWindows().size(), 1 );
+
+    // The window was loaded in a worker thread, its action must still reach
+    // the content from the application thread
+    ContentWindowPtr window = displayGroup->getContentWindows()[0];
+    ContentAction* playPause = RestoredMovieSession::getPlayPauseAction( window );
+    BOOST_REQUIRE( playPause );
+    BOOST_CHECK( !RestoredMovieSession::isPaused( window ));
+
+    playPause->trigger();
+    QCoreApplication::processEvents();
+    BOOST_CHECK( RestoredMovieSession::isPaused( window ));
+
+    playPause->trigger();
+    QCoreApplication::processEvents();
+    BOOST_CHECK( !RestoredMovieSession::isPaused( window ));
+
+    QFile::remove( MOVIE_SESSION_URI );
+}
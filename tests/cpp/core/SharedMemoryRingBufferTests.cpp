@@ -0,0 +1,160 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE SharedMemoryRingBufferTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "localstreamer/SharedMemoryRingBuffer.h"
+
+#include <QCoreApplication>
+
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+const unsigned int SLOT_SIZE = 64;
+const unsigned int SLOT_COUNT = 3;
+
+QString makeKey( const QString& name )
+{
+    return QString( "SharedMemoryRingBufferTests-%1-%2" )
+            .arg( QCoreApplication::applicationPid( )).arg( name );
+}
+}
+
+BOOST_AUTO_TEST_CASE( testSlotsAreAcquiredInRoundRobin )
+{
+    SharedMemoryRingBuffer buffer( makeKey( "roundrobin" ));
+    BOOST_REQUIRE( buffer.create( SLOT_SIZE, SLOT_COUNT ));
+
+    BOOST_CHECK_EQUAL( buffer.getSlotSize(), SLOT_SIZE );
+    BOOST_CHECK_EQUAL( buffer.getSlotCount(), SLOT_COUNT );
+    BOOST_CHECK( !buffer.hasAcquiredSlots( ));
+
+    BOOST_CHECK_EQUAL( buffer.acquireSlot(), 0 );
+    BOOST_CHECK_EQUAL( buffer.acquireSlot(), 1 );
+    BOOST_CHECK_EQUAL( buffer.acquireSlot(), 2 );
+    BOOST_CHECK_EQUAL( buffer.acquireSlot(), -1 );
+    BOOST_CHECK( buffer.hasAcquiredSlots( ));
+
+    buffer.releaseSlot( 1 );
+    BOOST_CHECK_EQUAL( buffer.acquireSlot(), 1 );
+    BOOST_CHECK_EQUAL( buffer.acquireSlot(), -1 );
+
+    buffer.releaseSlot( 0 );
+    buffer.releaseSlot( 1 );
+    buffer.releaseSlot( 2 );
+    BOOST_CHECK( !buffer.hasAcquiredSlots( ));
+    BOOST_CHECK_EQUAL( buffer.acquireSlot(), 2 );
+}
+
+BOOST_AUTO_TEST_CASE( testReaderSeesWrittenSlots )
+{
+    const QString key = makeKey( "readwrite" );
+    SharedMemoryRingBuffer writer( key );
+    BOOST_REQUIRE( writer.create( SLOT_SIZE, SLOT_COUNT ));
+
+    const int first = writer.acquireSlot();
+    const int second = writer.acquireSlot();
+    std::memset( writer.getSlot( first ), 'a', SLOT_SIZE );
+    std::memset( writer.getSlot( second ), 'b', SLOT_SIZE );
+
+    SharedMemoryRingBuffer reader( key );
+    BOOST_REQUIRE( reader.attach( SLOT_SIZE, SLOT_COUNT ));
+    BOOST_CHECK( reader.getKey() == key );
+
+    const SharedMemoryRingBuffer& constReader = reader;
+    const QByteArray firstData( (const char*)constReader.getSlot( first ), SLOT_SIZE );
+    const QByteArray secondData( (const char*)constReader.getSlot( second ), SLOT_SIZE );
+    BOOST_CHECK( firstData == QByteArray( SLOT_SIZE, 'a' ));
+    BOOST_CHECK( secondData == QByteArray( SLOT_SIZE, 'b' ));
+}
+
+BOOST_AUTO_TEST_CASE( testInvalidSlotsAndSizes )
+{
+    const QString key = makeKey( "invalid" );
+
+    SharedMemoryRingBuffer reader( key );
+    BOOST_CHECK( !reader.attach( SLOT_SIZE, SLOT_COUNT ));
+    BOOST_CHECK( !reader.getSlot( 0 ));
+
+    SharedMemoryRingBuffer writer( key );
+    BOOST_CHECK( !writer.create( 0, SLOT_COUNT ));
+    BOOST_REQUIRE( writer.create( SLOT_SIZE, SLOT_COUNT ));
+    BOOST_CHECK( !writer.getSlot( SLOT_COUNT ));
+
+    // The shared memory is too small for the requested slots
+    BOOST_CHECK( !reader.attach( SLOT_SIZE * 1024, SLOT_COUNT ));
+}
+
+#ifdef Q_OS_UNIX
+BOOST_AUTO_TEST_CASE( testOrphanedSegmentsAreRemoved )
+{
+    const QString key = makeKey( "orphan" );
+
+    // A writer which crashes leaves its segment behind
+    const pid_t pid = fork();
+    BOOST_REQUIRE( pid >= 0 );
+    if( pid == 0 )
+    {
+        SharedMemoryRingBuffer writer( key );
+        _exit( writer.create( SLOT_SIZE, SLOT_COUNT ) ? 0 : 1 );
+    }
+    int status = 0;
+    waitpid( pid, &status, 0 );
+    BOOST_REQUIRE_EQUAL( WEXITSTATUS( status ), 0 );
+
+    // Segments in use are kept
+    SharedMemoryRingBuffer alive( makeKey( "alive" ));
+    BOOST_REQUIRE( alive.create( SLOT_SIZE, SLOT_COUNT ));
+
+    BOOST_CHECK_EQUAL( SharedMemoryRingBuffer::removeOrphans(
+                           "SharedMemoryRingBufferTests" ), 1 );
+
+    SharedMemoryRingBuffer reader( key );
+    BOOST_CHECK( !reader.attach( SLOT_SIZE, SLOT_COUNT ));
+    SharedMemoryRingBuffer aliveReader( makeKey( "alive" ));
+    BOOST_CHECK( aliveReader.attach( SLOT_SIZE, SLOT_COUNT ));
+}
+#endif
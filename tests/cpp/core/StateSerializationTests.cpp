@@ -314,3 +314,71 @@ BOOST_AUTO_TEST_CASE( testStateSerializationToFile )
     cleanupTestDir();
     dir.rmdir( TEST_DIR );
 }
+
+BOOST_AUTO_TEST_CASE( testBinaryStateSerializationToFile )
+{
+    QDir dir;
+    if ( !dir.mkdir( TEST_DIR ))
+        cleanupTestDir();
+
+    DisplayGroupPtr displayGroup = createTestDisplayGroup();
+    StateSerializationHelper helper( displayGroup );
+    BOOST_CHECK( helper.save( TEST_DIR + "/test.dcxb", false ));
+
+    DisplayGroupPtr loadedDisplayGroup = boost::make_shared<DisplayGroup>( QSize( ));
+    StateSerializationHelper loader( loadedDisplayGroup );
+    BOOST_CHECK( loader.load( TEST_DIR + "/test.dcxb" ));
+
+    BOOST_REQUIRE_EQUAL( loadedDisplayGroup->getContentWindows().size(),
+                         displayGroup->getContentWindows().size( ));
+    checkWindow( loadedDisplayGroup->getContentWindows()[0] );
+
+    cleanupTestDir();
+    dir.rmdir( TEST_DIR );
+}
+
+BOOST_AUTO_TEST_CASE( testConvertXmlStateToBinary )
+{
+    QDir dir;
+    if ( !dir.mkdir( TEST_DIR ))
+        cleanupTestDir();
+
+    DisplayGroupPtr displayGroup = boost::make_shared<DisplayGroup>( wallSize );
+    StateSerializationHelper converter( displayGroup );
+    BOOST_CHECK( converter.convert( STATE_V0_URI, TEST_DIR + "/state_v0.dcxb" ));
+
+    DisplayGroupPtr loadedDisplayGroup = boost::make_shared<DisplayGroup>( QSize( ));
+    StateSerializationHelper loader( loadedDisplayGroup );
+    BOOST_CHECK( loader.load( TEST_DIR + "/state_v0.dcxb" ));
+
+    BOOST_REQUIRE_EQUAL( loadedDisplayGroup->getContentWindows().size(), 1 );
+    checkWindow( loadedDisplayGroup->getContentWindows()[0] );
+
+    cleanupTestDir();
+    dir.rmdir( TEST_DIR );
+}
+
+BOOST_AUTO_TEST_CASE( testBinaryStateReplacesWindowsOnlyWhenValid )
+{
+    QDir dir;
+    if ( !dir.mkdir( TEST_DIR ))
+        cleanupTestDir();
+
+    DisplayGroupPtr displayGroup = createTestDisplayGroup();
+    StateSerializationHelper helper( displayGroup );
+    BOOST_CHECK( helper.save( TEST_DIR + "/test.dcxb", false ));
+
+    // An invalid file leaves the current windows untouched
+    BOOST_CHECK( !helper.load( INVALID_URI ));
+    BOOST_CHECK_EQUAL( displayGroup->getContentWindows().size(), 1 );
+
+    // The restored window replaces the existing one
+    const QUuid previousId = displayGroup->getContentWindows()[0]->getID();
+    BOOST_CHECK( helper.load( TEST_DIR + "/test.dcxb" ));
+    BOOST_REQUIRE_EQUAL( displayGroup->getContentWindows().size(), 1 );
+    BOOST_CHECK( displayGroup->getContentWindows()[0]->getID() != previousId );
+    checkWindow( displayGroup->getContentWindows()[0] );
+
+    cleanupTestDir();
+    dir.rmdir( TEST_DIR );
+}
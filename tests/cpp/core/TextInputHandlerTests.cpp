@@ -76,20 +76,39 @@ BOOST_AUTO_TEST_CASE( testWhenRequestHasCharThenTextInputDispatcherReceivesIt )
     TextInputHandler handler(adapter);
 
     MockTextInputDispatcher mockDispatcher;
-    mockDispatcher.connect(&handler, SIGNAL(receivedKeyInput(char)),
-                           SLOT(sendKeyEventToActiveWindow(char)));
+    mockDispatcher.connect(&handler, SIGNAL(receivedTextInput(QString)),
+                           SLOT(sendTextToActiveWindow(QString)));
     // Checking default value
-    BOOST_REQUIRE_EQUAL(mockDispatcher.getKey(), '0');
+    BOOST_REQUIRE(mockDispatcher.getText().isEmpty());
 
     dcWebservice::RequestPtr request(new dcWebservice::Request());
 
     request->data = "a";
     handler.handle(*request);
-    BOOST_CHECK_EQUAL(mockDispatcher.getKey(), 'a');
+    BOOST_CHECK(mockDispatcher.getText() == "a");
 
     request->data = "7";
     handler.handle(*request);
-    BOOST_CHECK_EQUAL(mockDispatcher.getKey(), '7');
+    BOOST_CHECK(mockDispatcher.getText() == "7");
+}
+
+BOOST_AUTO_TEST_CASE( testWhenRequestIsStringThenTextInputDispatcherReceivesItOnce )
+{
+    DisplayGroupAdapterPtr adapter(new MockDisplayGroupAdapter(true));
+    TextInputHandler handler(adapter);
+
+    MockTextInputDispatcher mockDispatcher;
+    mockDispatcher.connect(&handler, SIGNAL(receivedTextInput(QString)),
+                           SLOT(sendTextToActiveWindow(QString)));
+
+    dcWebservice::RequestPtr request(new dcWebservice::Request());
+
+    request->data = "http://www.perdu.com/caf\xc3\xa9\n";
+    handler.handle(*request);
+    BOOST_CHECK_EQUAL(mockDispatcher.getCallsCount(), 1);
+    BOOST_CHECK(mockDispatcher.getText() ==
+                QString::fromUtf8("http://www.perdu.com/caf\xc3\xa9\n"));
+    BOOST_CHECK_EQUAL(mockDispatcher.getText().size(), 26);
 }
 
 BOOST_AUTO_TEST_CASE( testWhenRequestIsStringThenReturnCodeIs200Ok )
@@ -0,0 +1,106 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE ThumbnailCacheTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "thumbnail/ThumbnailCache.h"
+
+#include <QDir>
+
+namespace
+{
+const QString CACHE_DIR = "tmp_thumbnails";
+const QString VALID_IMAGE_URI = "wall.png";
+const QString INVALID_URI = "/invalid/uri.png";
+const QSize THUMBNAIL_SIZE( 64, 32 );
+
+void removeCacheDir()
+{
+    QDir dir( CACHE_DIR );
+    foreach( const QString& file, dir.entryList( QDir::Files ))
+        dir.remove( file );
+    QDir().rmdir( CACHE_DIR );
+}
+}
+
+BOOST_AUTO_TEST_CASE( testKeyDependsOnThumbnailSize )
+{
+    ThumbnailCache cache( CACHE_DIR );
+
+    const QString key = cache.getKey( VALID_IMAGE_URI, THUMBNAIL_SIZE );
+    BOOST_CHECK( !key.isEmpty( ));
+    BOOST_CHECK( key == cache.getKey( VALID_IMAGE_URI, THUMBNAIL_SIZE ));
+    BOOST_CHECK( key != cache.getKey( VALID_IMAGE_URI, THUMBNAIL_SIZE * 2 ));
+
+    removeCacheDir();
+}
+
+BOOST_AUTO_TEST_CASE( testMissingFileHasNoKey )
+{
+    ThumbnailCache cache( CACHE_DIR );
+
+    BOOST_CHECK( cache.getKey( INVALID_URI, THUMBNAIL_SIZE ).isEmpty( ));
+
+    removeCacheDir();
+}
+
+BOOST_AUTO_TEST_CASE( testSavedThumbnailIsLoaded )
+{
+    ThumbnailCache cache( CACHE_DIR );
+    const QString key = cache.getKey( VALID_IMAGE_URI, THUMBNAIL_SIZE );
+
+    BOOST_CHECK( cache.load( key ).isNull( ));
+
+    QImage image( THUMBNAIL_SIZE, QImage::Format_RGB32 );
+    image.fill( 0xff336699 );
+    image.setText( "source", VALID_IMAGE_URI );
+    BOOST_REQUIRE( cache.save( key, image ));
+
+    const QImage cachedImage = cache.load( key );
+    BOOST_REQUIRE( !cachedImage.isNull( ));
+    BOOST_CHECK( cachedImage.size() == THUMBNAIL_SIZE );
+    BOOST_CHECK( cachedImage.pixel( 0, 0 ) == image.pixel( 0, 0 ));
+    BOOST_CHECK( cachedImage.text( "source" ) == VALID_IMAGE_URI );
+
+    // No temporary file is left behind
+    BOOST_CHECK_EQUAL( QDir( CACHE_DIR ).entryList( QDir::Files ).size(), 1 );
+
+    removeCacheDir();
+}
@@ -0,0 +1,178 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE ThumbnailReaderTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "thumbnail/ThumbnailReader.h"
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QFile>
+
+namespace
+{
+const QString PNG_IMAGE_URI = "wall.png";
+const QString JPEG_IMAGE_URI = "tmp_thumbnail_reader.jpg";
+const QSize JPEG_IMAGE_SIZE( 800, 600 );
+const QSize EXIF_THUMBNAIL_SIZE( 200, 150 );
+
+QByteArray toJpeg( const QImage& image )
+{
+    QByteArray data;
+    QBuffer buffer( &data );
+    buffer.open( QIODevice::WriteOnly );
+    image.save( &buffer, "JPEG" );
+    return data;
+}
+
+QImage createImage( const QSize& size, const QColor& color )
+{
+    QImage image( size, QImage::Format_RGB32 );
+    image.fill( color.rgb( ));
+    return image;
+}
+
+// APP1 segment with a little-endian TIFF structure: an empty IFD0 followed
+// by an IFD1 which points to the JPEG thumbnail data
+QByteArray createExifSegment( const QByteArray& thumbnail )
+{
+    QByteArray tiff;
+    QDataStream stream( &tiff, QIODevice::WriteOnly );
+    stream.setByteOrder( QDataStream::LittleEndian );
+    stream.writeRawData( "II", 2 );
+    stream << quint16( 42 ) << quint32( 8 );
+    stream << quint16( 0 ) << quint32( 14 );
+    stream << quint16( 2 );
+    stream << quint16( 0x0201 ) << quint16( 4 ) << quint32( 1 ) << quint32( 44 );
+    stream << quint16( 0x0202 ) << quint16( 4 ) << quint32( 1 )
+           << quint32( thumbnail.size( ));
+    stream << quint32( 0 );
+    stream.writeRawData( thumbnail.constData(), thumbnail.size( ));
+
+    const int length = tiff.size() + 8;
+    QByteArray segment( "\xFF\xE1", 2 );
+    segment.append( char( length >> 8 ));
+    segment.append( char( length & 0xFF ));
+    segment.append( QByteArray( "Exif\0\0", 6 ));
+    segment.append( tiff );
+    return segment;
+}
+
+void writeJpegImage( const bool withExifThumbnail )
+{
+    QByteArray data = toJpeg( createImage( JPEG_IMAGE_SIZE, Qt::red ));
+    BOOST_REQUIRE( !data.isEmpty( ));
+
+    if( withExifThumbnail )
+    {
+        const QImage thumbnail = createImage( EXIF_THUMBNAIL_SIZE, Qt::green );
+        data.insert( 2, createExifSegment( toJpeg( thumbnail )));
+    }
+
+    QFile file( JPEG_IMAGE_URI );
+    BOOST_REQUIRE( file.open( QIODevice::WriteOnly ));
+    file.write( data );
+}
+
+bool isRed( const QImage& image )
+{
+    const QRgb pixel = image.pixel( image.width() / 2, image.height() / 2 );
+    return qRed( pixel ) > 200 && qGreen( pixel ) < 50;
+}
+
+bool isGreen( const QImage& image )
+{
+    const QRgb pixel = image.pixel( image.width() / 2, image.height() / 2 );
+    return qGreen( pixel ) > 200 && qRed( pixel ) < 50;
+}
+}
+
+BOOST_AUTO_TEST_CASE( testReadImageWithoutScaledDecoding )
+{
+    ThumbnailReader reader( PNG_IMAGE_URI, QSize( 64, 64 ), Qt::KeepAspectRatio );
+    BOOST_REQUIRE( reader.canRead( ));
+    BOOST_CHECK( reader.readEmbeddedThumbnail().isNull( ));
+
+    const QImage image = reader.read();
+    BOOST_CHECK( image.size() == QSize( 64, 32 ));
+}
+
+BOOST_AUTO_TEST_CASE( testReadJpegWithScaledDecoding )
+{
+    writeJpegImage( false );
+
+    ThumbnailReader reader( JPEG_IMAGE_URI, QSize( 100, 100 ), Qt::KeepAspectRatio );
+    BOOST_REQUIRE( reader.canRead( ));
+    BOOST_CHECK( reader.readEmbeddedThumbnail().isNull( ));
+
+    const QImage image = reader.read();
+    BOOST_CHECK( image.size() == QSize( 100, 75 ));
+    BOOST_CHECK( isRed( image ));
+
+    QFile::remove( JPEG_IMAGE_URI );
+}
+
+BOOST_AUTO_TEST_CASE( testReadJpegUsesExifThumbnail )
+{
+    writeJpegImage( true );
+
+    ThumbnailReader reader( JPEG_IMAGE_URI, QSize( 100, 100 ), Qt::KeepAspectRatio );
+    BOOST_REQUIRE( reader.canRead( ));
+
+    const QImage image = reader.read();
+    BOOST_CHECK( image.size() == QSize( 100, 75 ));
+    BOOST_CHECK( isGreen( image ));
+
+    QFile::remove( JPEG_IMAGE_URI );
+}
+
+BOOST_AUTO_TEST_CASE( testExifThumbnailIsNotUpscaled )
+{
+    writeJpegImage( true );
+
+    ThumbnailReader reader( JPEG_IMAGE_URI, QSize( 400, 400 ), Qt::KeepAspectRatio );
+    BOOST_CHECK( reader.readEmbeddedThumbnail().isNull( ));
+
+    const QImage image = reader.read();
+    BOOST_CHECK( image.size() == QSize( 400, 300 ));
+    BOOST_CHECK( isRed( image ));
+
+    QFile::remove( JPEG_IMAGE_URI );
+}
@@ -0,0 +1,101 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#define BOOST_TEST_MODULE TiledMovieManifestTests
+#include <boost/test/unit_test.hpp>
+namespace ut = boost::unit_test;
+
+#include "TiledMovieManifest.h"
+
+#include <QDir>
+
+namespace
+{
+const QString MANIFEST_URI( "movie.tiledmovie" );
+const QString INVALID_MANIFEST_URI( "movie_invalid.tiledmovie" );
+}
+
+BOOST_AUTO_TEST_CASE( testLoadManifest )
+{
+    TiledMovieManifest manifest;
+    BOOST_REQUIRE( manifest.load( MANIFEST_URI ));
+
+    BOOST_CHECK_EQUAL( manifest.getSize().width(), 7680 );
+    BOOST_CHECK_EQUAL( manifest.getSize().height(), 4320 );
+
+    const MovieTiles& tiles = manifest.getTiles();
+    BOOST_REQUIRE_EQUAL( tiles.size(), size_t( 4 ));
+
+    BOOST_CHECK( tiles[1].region == QRect( 3840, 0, 3840, 2160 ));
+    BOOST_CHECK( tiles[2].region == QRect( 0, 2160, 3840, 2160 ));
+}
+
+BOOST_AUTO_TEST_CASE( testTileUrisAreResolvedFromManifestFolder )
+{
+    TiledMovieManifest manifest;
+    BOOST_REQUIRE( manifest.load( MANIFEST_URI ));
+
+    const MovieTiles& tiles = manifest.getTiles();
+    BOOST_CHECK_EQUAL( tiles[0].uri.toStdString(),
+                       QDir::current().absoluteFilePath( "tile_0_0.mp4" ).toStdString( ));
+    BOOST_CHECK_EQUAL( tiles[3].uri.toStdString(), "/data/tile_1_1.mp4" );
+}
+
+BOOST_AUTO_TEST_CASE( testNormalizedTileRegion )
+{
+    TiledMovieManifest manifest;
+    BOOST_REQUIRE( manifest.load( MANIFEST_URI ));
+
+    const QRectF region = manifest.getNormalizedRegion( manifest.getTiles()[3] );
+    BOOST_CHECK_EQUAL( region.x(), 0.5 );
+    BOOST_CHECK_EQUAL( region.y(), 0.5 );
+    BOOST_CHECK_EQUAL( region.width(), 0.5 );
+    BOOST_CHECK_EQUAL( region.height(), 0.5 );
+}
+
+BOOST_AUTO_TEST_CASE( testInvalidManifests )
+{
+    TiledMovieManifest manifest;
+
+    // Tile outside of the movie
+    BOOST_CHECK( !manifest.load( INVALID_MANIFEST_URI ));
+    BOOST_CHECK( manifest.getTiles().empty( ));
+
+    BOOST_CHECK( !manifest.load( "nonexisting.tiledmovie" ));
+    BOOST_CHECK( manifest.getTiles().empty( ));
+}
@@ -92,3 +92,58 @@ BOOST_AUTO_TEST_CASE( testIncorrectRegex )
     dcWebservice::HandlerPtr handler1(new dcWebservice::DefaultHandler());
     BOOST_CHECK_EQUAL(false, mapper.addHandler("/video/(.*", handler1));
 }
+
+BOOST_AUTO_TEST_CASE( testRegexRegisteredBeforeLiteralTakesPrecedence )
+{
+    dcWebservice::Mapper mapper;
+    dcWebservice::HandlerPtr handler1(new dcWebservice::DefaultHandler());
+    dcWebservice::HandlerPtr handler2(new dcWebservice::DefaultHandler());
+    mapper.addHandler("/video/(.*)", handler1);
+    mapper.addHandler("/video/play", handler2);
+    BOOST_CHECK_EQUAL( handler1.get(), &mapper.getHandler("/video/play") );
+    BOOST_CHECK_EQUAL( handler1.get(), &mapper.getHandler("/video/") );
+}
+
+BOOST_AUTO_TEST_CASE( testLiteralPatternsMatchOnlyExactUrl )
+{
+    dcWebservice::Mapper mapper;
+    dcWebservice::HandlerPtr handler1(new dcWebservice::DefaultHandler());
+    dcWebservice::HandlerPtr handler2(new dcWebservice::DefaultHandler());
+    mapper.addHandler("/dcapi/textinput", handler1);
+    mapper.addHandler("/dcapi/file\\.txt", handler2);
+    BOOST_CHECK_EQUAL( handler1.get(), &mapper.getHandler("/dcapi/textinput") );
+    BOOST_CHECK_EQUAL( handler2.get(), &mapper.getHandler("/dcapi/file.txt") );
+    BOOST_CHECK( dynamic_cast<const dcWebservice::DefaultHandler*>(&mapper.getHandler("/dcapi/fileAtxt" )));
+    BOOST_CHECK( dynamic_cast<const dcWebservice::DefaultHandler*>(&mapper.getHandler("/dcapi/textinputs" )));
+    BOOST_CHECK( dynamic_cast<const dcWebservice::DefaultHandler*>(&mapper.getHandler("/dcapi/text" )));
+}
+
+BOOST_AUTO_TEST_CASE( testQuantifiedPrefixCharacterIsOptional )
+{
+    dcWebservice::Mapper mapper;
+    dcWebservice::HandlerPtr handler1(new dcWebservice::DefaultHandler());
+    dcWebservice::HandlerPtr handler2(new dcWebservice::DefaultHandler());
+    mapper.addHandler("/videos?/list", handler1);
+    mapper.addHandler("/images*", handler2);
+    BOOST_CHECK_EQUAL( handler1.get(), &mapper.getHandler("/video/list") );
+    BOOST_CHECK_EQUAL( handler1.get(), &mapper.getHandler("/videos/list") );
+    BOOST_CHECK_EQUAL( handler2.get(), &mapper.getHandler("/image") );
+    BOOST_CHECK_EQUAL( handler2.get(), &mapper.getHandler("/imagesss") );
+}
+
+BOOST_AUTO_TEST_CASE( testAlternationsAndCharacterClasses )
+{
+    dcWebservice::Mapper mapper;
+    dcWebservice::HandlerPtr handler1(new dcWebservice::DefaultHandler());
+    dcWebservice::HandlerPtr handler2(new dcWebservice::DefaultHandler());
+    dcWebservice::HandlerPtr handler3(new dcWebservice::DefaultHandler());
+    mapper.addHandler("/video|/movie", handler1);
+    mapper.addHandler("/window/(open|close)", handler2);
+    mapper.addHandler("/[|a-z]+/([0-9]+)", handler3);
+    BOOST_CHECK_EQUAL( handler1.get(), &mapper.getHandler("/video") );
+    BOOST_CHECK_EQUAL( handler1.get(), &mapper.getHandler("/movie") );
+    BOOST_CHECK_EQUAL( handler2.get(), &mapper.getHandler("/window/open") );
+    BOOST_CHECK_EQUAL( handler2.get(), &mapper.getHandler("/window/close") );
+    BOOST_CHECK_EQUAL( handler3.get(), &mapper.getHandler("/content/12") );
+    BOOST_CHECK( dynamic_cast<const dcWebservice::DefaultHandler*>(&mapper.getHandler("/window/move" )));
+}
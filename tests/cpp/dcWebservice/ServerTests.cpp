@@ -43,6 +43,11 @@
 #include "dcWebservice/Response.h"
 #include "dcWebservice/Request.h"
 
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+
 namespace ut = boost::unit_test;
 
 class MockHandler : public dcWebservice::Handler
@@ -186,3 +191,94 @@ BOOST_AUTO_TEST_CASE( testWhenHandlerFailsThenServerError )
                       fcgi->message);
 }
 
+class ConcurrencyProbeHandler : public dcWebservice::Handler
+{
+public:
+    ConcurrencyProbeHandler() : active(0), maxActive(0) {}
+
+    dcWebservice::ConstResponsePtr handle(const dcWebservice::Request&) const override
+    {
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            maxActive = std::max(maxActive, ++active);
+        }
+        // Leave time for the other workers to pick up requests
+        for(int i = 0; i < 100 && getMaxActive() < 2; ++i)
+            boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            --active;
+        }
+        return dcWebservice::Response::OK();
+    }
+
+    unsigned int getMaxActive() const
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        return maxActive;
+    }
+
+private:
+    mutable boost::mutex mutex;
+    mutable unsigned int active;
+    mutable unsigned int maxActive;
+};
+
+class CountingFCGI : public dcWebservice::FastCGIWrapper
+{
+public:
+    explicit CountingFCGI(const unsigned int nbOfRequests)
+        : remainingRequests(nbOfRequests), responses(0) {}
+
+    bool init(const unsigned int, const unsigned int) override
+    {
+        return true;
+    }
+
+    bool accept() override
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        if(remainingRequests == 0)
+            return false;
+        --remainingRequests;
+        return true;
+    }
+
+    FCGX_Request* getRequest() override
+    {
+        return &request;
+    }
+
+    bool write(const std::string& msg) override
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        if(msg == dcWebservice::Response::OK()->serialize())
+            ++responses;
+        return true;
+    }
+
+    unsigned int remainingRequests;
+    unsigned int responses;
+
+private:
+    boost::mutex mutex;
+    FCGX_Request request;
+};
+
+BOOST_AUTO_TEST_CASE( testWhenRunWithThreadsThenRequestsProcessedConcurrently )
+{
+    dcWebservice::Server server;
+    CountingFCGI* fcgi = new CountingFCGI(16);
+    ConcurrencyProbeHandler* h = new ConcurrencyProbeHandler();
+    dcWebservice::HandlerPtr handler(h);
+
+    server.addHandler("/home/index.html", handler);
+    server.setRequestBuilder(new FakeBuilder());
+    server.setFastCGIWrapper(fcgi);
+
+    BOOST_REQUIRE(server.run(0, 4));
+
+    BOOST_CHECK_EQUAL(fcgi->remainingRequests, 0);
+    BOOST_CHECK_EQUAL(fcgi->responses, 16);
+    BOOST_CHECK_GT(h->getMaxActive(), 1);
+}
@@ -41,16 +41,22 @@
 
 MockTextInputDispatcher::MockTextInputDispatcher(QObject *parentObject)
     : TextInputDispatcher(DisplayGroupPtr(), parentObject)
-    , key_('0')
+    , callsCount_(0)
 {
 }
 
-char MockTextInputDispatcher::getKey() const
+const QString& MockTextInputDispatcher::getText() const
 {
-    return key_;
+    return text_;
 }
 
-void MockTextInputDispatcher::sendKeyEventToActiveWindow(const char key) const
+unsigned int MockTextInputDispatcher::getCallsCount() const
 {
-    key_ = key;
+    return callsCount_;
+}
+
+void MockTextInputDispatcher::sendTextToActiveWindow(const QString text) const
+{
+    text_ = text;
+    ++callsCount_;
 }
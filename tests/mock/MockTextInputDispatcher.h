@@ -50,13 +50,15 @@ class MockTextInputDispatcher : public TextInputDispatcher
 public:
     explicit MockTextInputDispatcher(QObject *parent = 0);
 
-    char getKey() const;
+    const QString& getText() const;
+    unsigned int getCallsCount() const;
 
 public slots:
-    void sendKeyEventToActiveWindow(const char key) const;
+    void sendTextToActiveWindow(const QString text) const;
 
 private:
-    mutable char key_;
+    mutable QString text_;
+    mutable unsigned int callsCount_;
 };
 
 #endif // MOCKTEXTINPUTDISPATCHER_H
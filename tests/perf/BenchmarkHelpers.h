@@ -0,0 +1,115 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#ifndef BENCHMARKHELPERS_H
+#define BENCHMARKHELPERS_H
+
+#include <iostream>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/program_options.hpp>
+
+/** Measure the wall-clock time elapsed since start() was called. */
+class Timer
+{
+public:
+    void start()
+    {
+        lastTime_ = boost::posix_time::microsec_clock::universal_time();
+    }
+
+    /** @return The time elapsed since start() [ms]. */
+    float elapsed()
+    {
+        const boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+        return (float)(now - lastTime_).total_milliseconds();
+    }
+private:
+    boost::posix_time::ptime lastTime_;
+};
+
+/**
+ * Command line options of a benchmark, with a --help option.
+ *
+ * Derived classes add their own options to desc_ in their constructor, then
+ * call parse() and read their values from the variables_map.
+ */
+struct BenchmarkOptions
+{
+    BenchmarkOptions()
+        : desc_("Allowed options")
+        , getHelp_(false)
+    {
+        desc_.add_options()
+            ("help", "produce help message")
+        ;
+    }
+
+    void showSyntax() const
+    {
+        std::cout << desc_;
+    }
+
+    /**
+     * Parse the command line.
+     * @return false if the arguments are invalid or help was requested.
+     */
+    bool parse(int &argc, char **argv, boost::program_options::variables_map& vm)
+    {
+        try
+        {
+            boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc_), vm);
+            boost::program_options::notify(vm);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            getHelp_ = true;
+            return false;
+        }
+
+        getHelp_ = vm.count("help");
+        return !getHelp_;
+    }
+
+    boost::program_options::options_description desc_;
+
+    bool getHelp_;
+};
+
+#endif // BENCHMARKHELPERS_H
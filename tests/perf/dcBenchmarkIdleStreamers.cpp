@@ -0,0 +1,173 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QProcess>
+#include <QStringList>
+
+#include <unistd.h>
+
+#include "BenchmarkHelpers.h"
+
+// Example ways to run this program, with a DisplayCluster instance running:
+// ./dcBenchmarkIdleStreamers --bin ../../bin/localstreamer --count 12 --duration 10
+//
+// Each localstreamer opens a browser window on about:blank, which stays idle
+// while the CPU usage of the processes is measured (Linux only).
+
+namespace
+{
+struct IdleStreamersBenchmarkOptions : public BenchmarkOptions
+{
+    IdleStreamersBenchmarkOptions(int &argc, char **argv)
+        : count_(0)
+        , warmup_(0)
+        , duration_(0)
+    {
+        desc_.add_options()
+            ("bin", boost::program_options::value<std::string>()->default_value("localstreamer"),
+                     "Path to the localstreamer executable")
+            ("count", boost::program_options::value<unsigned int>()->default_value(10),
+                     "Number of idle streamers to launch")
+            ("warmup", boost::program_options::value<unsigned int>()->default_value(5),
+                     "Time for the streamers to load their page [s]")
+            ("duration", boost::program_options::value<unsigned int>()->default_value(10),
+                     "Duration of the measurement [s]")
+        ;
+
+        boost::program_options::variables_map vm;
+        if (!parse(argc, argv, vm))
+            return;
+
+        bin_ = QString::fromStdString(vm["bin"].as<std::string>());
+        count_ = vm["count"].as<unsigned int>();
+        warmup_ = vm["warmup"].as<unsigned int>();
+        duration_ = vm["duration"].as<unsigned int>();
+    }
+
+    QString bin_;
+    unsigned int count_;
+    unsigned int warmup_;
+    unsigned int duration_;
+};
+
+typedef boost::shared_ptr<QProcess> QProcessPtr;
+
+/** @return The user + system CPU time used by a process [s], or -1. */
+double getCpuTime(const Q_PID pid)
+{
+    QFile file(QString("/proc/%1/stat").arg(pid));
+    if (!file.open(QIODevice::ReadOnly))
+        return -1.0;
+
+    // The command name may contain spaces, skip it before splitting
+    const QString stat = QString(file.readAll());
+    const QStringList fields = stat.mid(stat.lastIndexOf(')') + 2).split(' ');
+    if (fields.size() < 13)
+        return -1.0;
+
+    // utime and stime are the 14th and 15th fields of the file
+    const double ticks = fields[11].toDouble() + fields[12].toDouble();
+    return ticks / sysconf(_SC_CLK_TCK);
+}
+
+double getTotalCpuTime(const std::vector<QProcessPtr>& processes)
+{
+    double total = 0.0;
+    for (size_t i = 0; i < processes.size(); ++i)
+        total += std::max(getCpuTime(processes[i]->pid()), 0.0);
+    return total;
+}
+}
+
+/**
+ * Measure the CPU usage of idle localstreamer processes.
+ */
+int main(int argc, char **argv)
+{
+    IdleStreamersBenchmarkOptions options(argc, argv);
+    if (options.getHelp_ || options.count_ == 0 || options.duration_ == 0)
+    {
+        options.showSyntax();
+        return 0;
+    }
+
+    QCoreApplication app(argc, argv);
+
+    std::vector<QProcessPtr> processes;
+    for (unsigned int i = 0; i < options.count_; ++i)
+    {
+        QStringList arguments;
+        arguments << "--type" << "webkit" << "--url" << "about:blank"
+                  << "--name" << QString("IdleStreamerBenchmark_%1").arg(i);
+
+        QProcessPtr process(new QProcess);
+        process->start(options.bin_, arguments);
+        if (!process->waitForStarted())
+        {
+            std::cerr << "Could not start: " << options.bin_.toStdString() << std::endl;
+            return 1;
+        }
+        processes.push_back(process);
+    }
+
+    sleep(options.warmup_);
+    const double startTime = getTotalCpuTime(processes);
+    sleep(options.duration_);
+    const double cpuTime = getTotalCpuTime(processes) - startTime;
+
+    std::cout << "Streamers: " << processes.size() << std::endl;
+    std::cout << "Total CPU usage [%]: " << 100.0 * cpuTime / options.duration_ << std::endl;
+    std::cout << "CPU usage per streamer [%]: "
+              << 100.0 * cpuTime / options.duration_ / processes.size() << std::endl;
+
+    for (size_t i = 0; i < processes.size(); ++i)
+    {
+        processes[i]->terminate();
+        if (!processes[i]->waitForFinished())
+            processes[i]->kill();
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+#include "dcWebservice/DefaultHandler.h"
+#include "dcWebservice/Mapper.h"
+
+#include "BenchmarkHelpers.h"
+
+// Example ways to run this program:
+// ./dcBenchmarkMapper --routes 100 --iterations 100000
+
+namespace
+{
+struct MapperBenchmarkOptions : public BenchmarkOptions
+{
+    MapperBenchmarkOptions(int &argc, char **argv)
+        : routes_(0)
+        , iterations_(0)
+    {
+        desc_.add_options()
+            ("routes", boost::program_options::value<unsigned int>()->default_value(50),
+                     "Number of literal and of parameterized routes")
+            ("iterations", boost::program_options::value<unsigned int>()->default_value(100000),
+                     "Number of lookups per url")
+        ;
+
+        boost::program_options::variables_map vm;
+        if (!parse(argc, argv, vm))
+            return;
+
+        routes_ = vm["routes"].as<unsigned int>();
+        iterations_ = vm["iterations"].as<unsigned int>();
+    }
+
+    unsigned int routes_;
+    unsigned int iterations_;
+};
+
+/** The previous implementation of the Mapper, used as a reference. */
+class LinearRegexMapper
+{
+public:
+    void addHandler(const std::string& pattern, dcWebservice::HandlerPtr handler)
+    {
+        mappings_.push_back(std::make_pair(boost::regex(pattern), handler));
+    }
+
+    const dcWebservice::Handler* getHandler(const std::string& url) const
+    {
+        for(Mappings::const_iterator it = mappings_.begin(); it != mappings_.end(); ++it)
+        {
+            if(boost::regex_match(url, it->first))
+                return it->second.get();
+        }
+        return 0;
+    }
+
+private:
+    typedef std::list<std::pair<boost::regex, dcWebservice::HandlerPtr> > Mappings;
+    Mappings mappings_;
+};
+
+std::string getRoute(const unsigned int index)
+{
+    std::ostringstream route;
+    route << "/dcapi/route" << index;
+    return route.str();
+}
+
+template <typename MapperT>
+float benchmarkLookup(const MapperT& mapper, const std::string& url,
+                      const unsigned int iterations)
+{
+    Timer timer;
+    timer.start();
+    for(unsigned int i = 0; i < iterations; ++i)
+        mapper.getHandler(url);
+    return timer.elapsed();
+}
+}
+
+/**
+ * Compare the cost of looking up a request handler by matching the url
+ * against every registered regex with the prefix trie of the Mapper.
+ */
+int main(int argc, char **argv)
+{
+    MapperBenchmarkOptions options(argc, argv);
+    if (options.getHelp_ || options.routes_ == 0)
+    {
+        options.showSyntax();
+        return 0;
+    }
+
+    dcWebservice::Mapper mapper;
+    LinearRegexMapper linearMapper;
+    dcWebservice::HandlerPtr handler(new dcWebservice::DefaultHandler());
+
+    for(unsigned int i = 0; i < options.routes_; ++i)
+    {
+        const std::string& route = getRoute(i);
+        mapper.addHandler(route, handler);
+        mapper.addHandler(route + "/([0-9]+)", handler);
+        linearMapper.addHandler(route, handler);
+        linearMapper.addHandler(route + "/([0-9]+)", handler);
+    }
+
+    // First route, last routes (worst case for the linear search) and a miss
+    const std::string& lastRoute = getRoute(options.routes_ - 1);
+    std::vector<std::string> urls;
+    urls.push_back(getRoute(0));
+    urls.push_back(lastRoute);
+    urls.push_back(lastRoute + "/1234");
+    urls.push_back("/dcapi/unknown");
+
+    std::cout << "Routes: " << 2 * options.routes_ << std::endl;
+    for(size_t i = 0; i < urls.size(); ++i)
+    {
+        const float linearTime = benchmarkLookup(linearMapper, urls[i],
+                                                 options.iterations_);
+        const float trieTime = benchmarkLookup(mapper, urls[i],
+                                               options.iterations_);
+
+        std::cout << urls[i] << std::endl;
+        std::cout << "  Linear regex [us/lookup]: "
+                  << 1000.f * linearTime / options.iterations_ << std::endl;
+        std::cout << "  Prefix trie [us/lookup]: "
+                  << 1000.f * trieTime / options.iterations_ << std::endl;
+    }
+
+    return 0;
+}
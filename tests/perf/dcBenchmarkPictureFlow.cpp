@@ -0,0 +1,141 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include <iostream>
+
+#include <QApplication>
+#include <QImage>
+#include <QPainter>
+
+#include "localstreamer/Pictureflow.h"
+
+#include "BenchmarkHelpers.h"
+
+// Example ways to run this program:
+// ./dcBenchmarkPictureFlow --width 3840 --height 1080 --slides 100
+
+namespace
+{
+struct PictureFlowBenchmarkOptions : public BenchmarkOptions
+{
+    PictureFlowBenchmarkOptions(int &argc, char **argv)
+        : width_(0)
+        , height_(0)
+        , slides_(0)
+    {
+        desc_.add_options()
+            ("width", boost::program_options::value<unsigned int>()->default_value(1920),
+                     "Width of the dock [pixels]")
+            ("height", boost::program_options::value<unsigned int>()->default_value(540),
+                     "Height of the dock [pixels]")
+            ("slides", boost::program_options::value<unsigned int>()->default_value(50),
+                     "Number of slides")
+        ;
+
+        boost::program_options::variables_map vm;
+        if (!parse(argc, argv, vm))
+            return;
+
+        width_ = vm["width"].as<unsigned int>();
+        height_ = vm["height"].as<unsigned int>();
+        slides_ = vm["slides"].as<unsigned int>();
+    }
+
+    unsigned int width_;
+    unsigned int height_;
+    unsigned int slides_;
+};
+
+QImage createSlide(const QSize& size, const int index)
+{
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(QColor::fromHsv((index * 37) % 360, 200, 200).rgb());
+    QPainter painter(&image);
+    painter.setPen(Qt::white);
+    painter.drawText(image.rect(), Qt::AlignCenter, QString::number(index));
+    return image;
+}
+
+float renderAllSlides(PictureFlow& flow)
+{
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < flow.slideCount(); ++i)
+    {
+        flow.setCenterIndex(i);
+        flow.render();
+    }
+    return timer.elapsed() / flow.slideCount();
+}
+}
+
+/**
+ * Measure the time to render the dock's PictureFlow at a given size, first
+ * when all the surfaces of the slides need to be prepared, then when they are
+ * in the cache.
+ */
+int main(int argc, char **argv)
+{
+    PictureFlowBenchmarkOptions options(argc, argv);
+    if (options.getHelp_ || options.slides_ == 0)
+    {
+        options.showSyntax();
+        return 0;
+    }
+
+    QApplication app(argc, argv);
+
+    PictureFlow flow;
+    flow.resize(options.width_, options.height_);
+    const int slideSize = options.height_ * 2 / 3;
+    flow.setSlideSize(QSize(slideSize, slideSize));
+
+    for (unsigned int i = 0; i < options.slides_; ++i)
+        flow.addSlide(createSlide(flow.slideSize(), i), QString::number(i));
+
+    const float coldTime = renderAllSlides(flow);
+    const float warmTime = renderAllSlides(flow);
+
+    std::cout << "Dock size: " << options.width_ << "x" << options.height_ << std::endl;
+    std::cout << "Render with new slides [ms/frame]: " << coldTime << std::endl;
+    std::cout << "Render with cached slides [ms/frame]: " << warmTime << std::endl;
+    if (warmTime > 0.f)
+        std::cout << "Max frame rate [fps]: " << 1000.f / warmTime << std::endl;
+
+    return 0;
+}
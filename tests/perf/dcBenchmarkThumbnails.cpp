@@ -0,0 +1,136 @@
+/*********************************************************************/
+/* Copyright (c) 2015, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of The University of Texas at Austin.                 */
+
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QImageReader>
+
+#include "thumbnail/ThumbnailReader.h"
+
+#include "BenchmarkHelpers.h"
+
+// Example ways to run this program:
+// ./dcBenchmarkThumbnails --dir /path/to/large/images --size 128
+
+namespace
+{
+struct ThumbnailBenchmarkOptions : public BenchmarkOptions
+{
+    ThumbnailBenchmarkOptions(int &argc, char **argv)
+        : thumbnailSize_(0)
+    {
+        desc_.add_options()
+            ("dir", boost::program_options::value<std::string>()->default_value(""),
+                     "Folder containing the images")
+            ("size", boost::program_options::value<unsigned int>()->default_value(128),
+                     "Size of the thumbnails [pixels]")
+        ;
+
+        boost::program_options::variables_map vm;
+        if (!parse(argc, argv, vm))
+            return;
+
+        dir_ = QString::fromStdString(vm["dir"].as<std::string>());
+        thumbnailSize_ = vm["size"].as<unsigned int>();
+    }
+
+    QString dir_;
+    unsigned int thumbnailSize_;
+};
+
+QStringList getImageFiles(const QString& dirName)
+{
+    QStringList filters;
+    foreach (const QByteArray& format, QImageReader::supportedImageFormats())
+        filters.append("*." + QString(format));
+
+    QDir dir(dirName);
+    dir.setNameFilters(filters);
+    dir.setFilter(QDir::Files);
+
+    QStringList files;
+    foreach (const QString& file, dir.entryList())
+        files.append(dir.absoluteFilePath(file));
+    return files;
+}
+}
+
+/**
+ * Compare the cost of generating thumbnails by decoding images at full
+ * resolution with the ThumbnailReader fast paths (EXIF thumbnail, scaled
+ * decoding).
+ */
+int main(int argc, char **argv)
+{
+    ThumbnailBenchmarkOptions options(argc, argv);
+    if (options.getHelp_ || options.dir_.isEmpty())
+    {
+        options.showSyntax();
+        return 0;
+    }
+
+    QCoreApplication app(argc, argv);
+
+    const QStringList files = getImageFiles(options.dir_);
+    if (files.isEmpty())
+    {
+        std::cerr << "No images found in: " << options.dir_.toStdString() << std::endl;
+        return 1;
+    }
+
+    const QSize size(options.thumbnailSize_, options.thumbnailSize_);
+    Timer timer;
+
+    timer.start();
+    foreach (const QString& file, files)
+        QImageReader(file).read().scaled(size, Qt::KeepAspectRatio);
+    const float fullDecodeTime = timer.elapsed();
+
+    timer.start();
+    foreach (const QString& file, files)
+        ThumbnailReader(file, size, Qt::KeepAspectRatio).read();
+    const float thumbnailReaderTime = timer.elapsed();
+
+    std::cout << "Images: " << files.size() << std::endl;
+    std::cout << "Full decode [ms/image]: " << fullDecodeTime / files.size() << std::endl;
+    std::cout << "Thumbnail reader [ms/image]: " << thumbnailReaderTime / files.size() << std::endl;
+
+    return 0;
+}